@@ -0,0 +1,601 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+// Native benchmarks for the engine core, run directly against `Table`,
+// `t_pool` and `View` so that results are not dominated by the WASM/Python
+// bindings or the protobuf layer.
+//
+//     psp_bench [--rows N] [--update-rows N] [--iterations N] [--seed N]
+//               [--filter SUBSTRING] [--json PATH]
+
+#include <perspective/base.h>
+#include <perspective/computed_expression.h>
+#include <perspective/context_one.h>
+#include <perspective/context_two.h>
+#include <perspective/context_zero.h>
+#include <perspective/pool.h>
+#include <perspective/schema.h>
+#include <perspective/server.h>
+#include <perspective/table.h>
+#include <perspective/view.h>
+#include <perspective/view_config.h>
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace perspective;
+
+namespace {
+
+struct t_bench_options {
+    std::uint32_t m_rows = 100000;
+    std::uint32_t m_update_rows = 1000;
+    std::uint32_t m_iterations = 20;
+    std::uint64_t m_seed = 0x5eed;
+    std::string m_filter;
+    std::string m_json_path;
+};
+
+struct t_bench_result {
+    std::string m_name;
+    std::uint64_t m_rows_per_iteration;
+    std::vector<double> m_samples_ms;
+
+    double
+    percentile(double p) const {
+        std::vector<double> sorted = m_samples_ms;
+        std::sort(sorted.begin(), sorted.end());
+        auto rank = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    double
+    mean() const {
+        double total = 0;
+        for (auto s : m_samples_ms) {
+            total += s;
+        }
+
+        return total / m_samples_ms.size();
+    }
+
+    double
+    rows_per_second() const {
+        return m_rows_per_iteration / (mean() / 1000.0);
+    }
+};
+
+/**
+ * @brief Deterministic synthetic blotter - the same seed always yields the
+ * same rows, so runs on different commits are directly comparable.
+ */
+class t_dataset {
+public:
+    t_dataset(std::uint64_t seed, std::uint32_t num_symbols) :
+        m_rng(seed),
+        m_num_symbols(num_symbols) {}
+
+    static t_schema
+    schema() {
+        return t_schema(
+            {"id", "sym", "desk", "side", "bid", "qty", "fee", "ts"},
+            {DTYPE_INT64,
+             DTYPE_STR,
+             DTYPE_STR,
+             DTYPE_STR,
+             DTYPE_FLOAT64,
+             DTYPE_INT64,
+             DTYPE_FLOAT64,
+             DTYPE_INT64}
+        );
+    }
+
+    // Rows `[0, num_rows)` as a JSON column-oriented string.
+    std::string
+    rows(std::uint32_t num_rows) {
+        std::vector<std::int64_t> ids(num_rows);
+        for (std::uint32_t i = 0; i < num_rows; ++i) {
+            ids[i] = i;
+        }
+
+        return columns(ids);
+    }
+
+    // `num_rows` updates to random existing primary keys in `[0, extent)`.
+    std::string
+    updates(std::uint32_t num_rows, std::uint32_t extent) {
+        std::uniform_int_distribution<std::int64_t> pkey(0, extent - 1);
+        std::vector<std::int64_t> ids(num_rows);
+        for (auto& id : ids) {
+            id = pkey(m_rng);
+        }
+
+        return columns(ids);
+    }
+
+private:
+    std::string
+    columns(const std::vector<std::int64_t>& ids) {
+        static const char* desks[] = {
+            "rates", "credit", "fx", "equities", "commodities", "em"
+        };
+        static const char* sides[] = {"buy", "sell"};
+
+        std::uniform_int_distribution<std::uint32_t> sym(0, m_num_symbols - 1);
+        std::uniform_int_distribution<std::uint32_t> desk(0, 5);
+        std::uniform_int_distribution<std::uint32_t> side(0, 1);
+        std::uniform_real_distribution<double> bid(1.0, 500.0);
+        std::uniform_int_distribution<std::int64_t> qty(1, 10000);
+        std::uniform_real_distribution<double> fee(0.0, 5.0);
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+
+        writer.Key("id");
+        writer.StartArray();
+        for (auto id : ids) {
+            writer.Int64(id);
+        }
+        writer.EndArray();
+
+        writer.Key("sym");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.String(("SYM" + std::to_string(sym(m_rng))).c_str());
+        }
+        writer.EndArray();
+
+        writer.Key("desk");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.String(desks[desk(m_rng)]);
+        }
+        writer.EndArray();
+
+        writer.Key("side");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.String(sides[side(m_rng)]);
+        }
+        writer.EndArray();
+
+        writer.Key("bid");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.Double(bid(m_rng));
+        }
+        writer.EndArray();
+
+        writer.Key("qty");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.Int64(qty(m_rng));
+        }
+        writer.EndArray();
+
+        writer.Key("fee");
+        writer.StartArray();
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            writer.Double(fee(m_rng));
+        }
+        writer.EndArray();
+
+        writer.Key("ts");
+        writer.StartArray();
+        for (auto id : ids) {
+            writer.Int64(1700000000000 + id * 1000);
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+        return buffer.GetString();
+    }
+
+    std::mt19937_64 m_rng;
+    std::uint32_t m_num_symbols;
+};
+
+/**
+ * @brief The parts of a view config a benchmark varies. Expressions are
+ * given pre-parsed, i.e. with column names already replaced by column IDs.
+ */
+struct t_view_spec {
+    std::vector<std::string> m_group_by;
+    std::vector<std::string> m_split_by;
+    std::vector<std::vector<std::string>> m_sort;
+    std::vector<std::tuple<std::string, std::string, std::vector<t_tscalar>>>
+        m_filter;
+    std::vector<std::tuple<
+        std::string,
+        std::string,
+        std::vector<std::pair<std::string, std::string>>>>
+        m_expressions;
+};
+
+std::shared_ptr<t_view_config>
+make_view_config(
+    const std::shared_ptr<Table>& table,
+    const std::shared_ptr<t_schema>& schema,
+    const t_view_spec& spec
+) {
+    std::vector<std::shared_ptr<t_computed_expression>> expressions;
+    std::vector<std::string> columns = {"sym", "desk", "bid", "qty", "fee"};
+
+    auto gnode = table->get_gnode();
+    for (const auto& [alias, parsed, column_ids] : spec.m_expressions) {
+        auto computed = t_computed_expression_parser::precompute(
+            alias,
+            parsed,
+            parsed,
+            column_ids,
+            gnode->get_table_sptr(),
+            gnode->get_pkey_map(),
+            schema,
+            *gnode->get_expression_vocab(),
+            *gnode->get_expression_regex_mapping()
+        );
+
+        schema->add_column(alias, computed->get_dtype());
+        expressions.push_back(std::make_shared<t_computed_expression>(
+            alias, parsed, parsed, column_ids, computed->get_dtype()
+        ));
+        columns.push_back(alias);
+    }
+
+    tsl::ordered_map<std::string, std::vector<std::string>> aggregates;
+    if (!spec.m_group_by.empty() || !spec.m_split_by.empty()) {
+        aggregates["bid"] = {"avg"};
+        aggregates["qty"] = {"sum"};
+        aggregates["fee"] = {"sum"};
+    }
+
+    auto config = std::make_shared<t_view_config>(
+        spec.m_group_by,
+        spec.m_split_by,
+        aggregates,
+        columns,
+        spec.m_filter,
+        spec.m_sort,
+        expressions,
+        "and",
+        false
+    );
+
+    config->init(schema);
+    return config;
+}
+
+/**
+ * @brief Type-erased handle over `View<CTX_T>` for the operations the
+ * benchmarks need.
+ */
+struct t_bench_view {
+    std::function<std::int32_t()> m_num_rows;
+    std::function<std::shared_ptr<std::string>()> m_to_arrow;
+    std::shared_ptr<void> m_view;
+};
+
+template <typename CTX_T>
+t_bench_view
+make_bench_view(
+    const std::shared_ptr<Table>& table,
+    const t_view_spec& spec,
+    const std::string& name
+) {
+    auto schema =
+        std::make_shared<t_schema>(table->get_gnode()->get_output_schema());
+    auto config = make_view_config(table, schema, spec);
+    auto ctx = make_context<CTX_T>(table, schema, config, name);
+    auto view = std::make_shared<View<CTX_T>>(table, ctx, name, "|", config);
+
+    t_bench_view rval;
+    rval.m_num_rows = [view]() { return view->num_rows(); };
+    rval.m_to_arrow = [view]() {
+        return view->to_arrow(
+            0, view->num_rows(), 0, view->num_columns(), true, false
+        );
+    };
+    rval.m_view = view;
+    return rval;
+}
+
+std::shared_ptr<Table>
+load_table(const std::string& data) {
+    auto table = Table::from_schema("id", t_dataset::schema());
+    table->update_cols(data, 0);
+    table->get_pool()->_process();
+    return table;
+}
+
+class t_bench_runner {
+public:
+    explicit t_bench_runner(const t_bench_options& options) :
+        m_options(options) {}
+
+    /**
+     * @brief Run `body` once to warm up, then `m_iterations` times, timing
+     * each call. `setup` runs before every call and is not timed.
+     */
+    void
+    run(const std::string& name,
+        std::uint64_t rows_per_iteration,
+        const std::function<void()>& setup,
+        const std::function<void()>& body) {
+        if (!m_options.m_filter.empty()
+            && name.find(m_options.m_filter) == std::string::npos) {
+            return;
+        }
+
+        t_bench_result result;
+        result.m_name = name;
+        result.m_rows_per_iteration = rows_per_iteration;
+
+        setup();
+        body();
+
+        for (std::uint32_t i = 0; i < m_options.m_iterations; ++i) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto end = std::chrono::steady_clock::now();
+            result.m_samples_ms.push_back(
+                std::chrono::duration<double, std::milli>(end - start).count()
+            );
+        }
+
+        std::cout << std::left << std::setw(36) << name << std::right
+                  << std::fixed << std::setprecision(3)
+                  << " p50=" << std::setw(10) << result.percentile(0.5)
+                  << "ms p90=" << std::setw(10) << result.percentile(0.9)
+                  << "ms p99=" << std::setw(10) << result.percentile(0.99)
+                  << "ms " << std::setprecision(0) << std::setw(12)
+                  << result.rows_per_second() << " rows/s" << std::endl;
+
+        m_results.push_back(std::move(result));
+    }
+
+    void
+    write_json(const std::string& path) const {
+        rapidjson::StringBuffer buffer;
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        writer.StartObject();
+        writer.Key("rows");
+        writer.Uint(m_options.m_rows);
+        writer.Key("update_rows");
+        writer.Uint(m_options.m_update_rows);
+        writer.Key("iterations");
+        writer.Uint(m_options.m_iterations);
+        writer.Key("seed");
+        writer.Uint64(m_options.m_seed);
+        writer.Key("results");
+        writer.StartArray();
+        for (const auto& result : m_results) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(result.m_name.c_str());
+            writer.Key("mean_ms");
+            writer.Double(result.mean());
+            writer.Key("p50_ms");
+            writer.Double(result.percentile(0.5));
+            writer.Key("p90_ms");
+            writer.Double(result.percentile(0.9));
+            writer.Key("p99_ms");
+            writer.Double(result.percentile(0.99));
+            writer.Key("max_ms");
+            writer.Double(result.percentile(1.0));
+            writer.Key("rows_per_second");
+            writer.Double(result.rows_per_second());
+            writer.Key("samples_ms");
+            writer.StartArray();
+            for (auto s : result.m_samples_ms) {
+                writer.Double(s);
+            }
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+
+        std::ofstream out(path);
+        out << buffer.GetString() << std::endl;
+    }
+
+private:
+    const t_bench_options& m_options;
+    std::vector<t_bench_result> m_results;
+};
+
+/**
+ * @brief Benchmark one view configuration: initial build, incremental
+ * update + notify, and full Arrow serialization.
+ */
+template <typename CTX_T>
+void
+bench_view(
+    t_bench_runner& runner,
+    const t_bench_options& options,
+    const std::string& prefix,
+    const t_view_spec& spec
+) {
+    t_dataset dataset(options.m_seed, 500);
+    auto table = load_table(dataset.rows(options.m_rows));
+    std::uint32_t view_idx = 0;
+
+    {
+        t_bench_view view;
+        runner.run(
+            prefix + "/create",
+            options.m_rows,
+            [&]() { view = t_bench_view(); },
+            [&]() {
+                view = make_bench_view<CTX_T>(
+                    table, spec, "view_" + std::to_string(view_idx++)
+                );
+            }
+        );
+    }
+
+    auto view = make_bench_view<CTX_T>(table, spec, "view_bench");
+
+    std::vector<std::string> batches;
+    for (std::uint32_t i = 0; i <= options.m_iterations; ++i) {
+        batches.push_back(
+            dataset.updates(options.m_update_rows, options.m_rows)
+        );
+    }
+
+    std::size_t batch_idx = 0;
+    runner.run(
+        prefix + "/update",
+        options.m_update_rows,
+        []() {},
+        [&]() {
+            table->update_cols(batches[batch_idx++ % batches.size()], 0);
+            table->get_pool()->_process();
+        }
+    );
+
+    runner.run(
+        prefix + "/serialize_arrow",
+        static_cast<std::uint64_t>(view.m_num_rows()),
+        []() {},
+        [&]() { view.m_to_arrow(); }
+    );
+}
+
+void
+parse_options(int argc, char** argv, t_bench_options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                std::exit(1);
+            }
+
+            return argv[++i];
+        };
+
+        if (arg == "--rows") {
+            options.m_rows = std::stoul(next());
+        } else if (arg == "--update-rows") {
+            options.m_update_rows = std::stoul(next());
+        } else if (arg == "--iterations") {
+            options.m_iterations = std::stoul(next());
+        } else if (arg == "--seed") {
+            options.m_seed = std::stoull(next());
+        } else if (arg == "--filter") {
+            options.m_filter = next();
+        } else if (arg == "--json") {
+            options.m_json_path = next();
+        } else {
+            std::cerr << "Unknown argument " << arg << std::endl;
+            std::exit(1);
+        }
+    }
+}
+
+} // namespace
+
+int
+main(int argc, char** argv) {
+    t_bench_options options;
+    parse_options(argc, argv, options);
+
+    t_computed_expression_parser::init();
+    t_bench_runner runner(options);
+
+    {
+        t_dataset dataset(options.m_seed, 500);
+        auto data = dataset.rows(options.m_rows);
+        runner.run("table/load", options.m_rows, []() {}, [&]() {
+            load_table(data);
+        });
+    }
+
+    t_tscalar threshold;
+    threshold.set(250.0);
+
+    std::vector<std::pair<std::string, std::string>> expression_columns = {
+        {"COLUMN0", "bid"}, {"COLUMN1", "qty"}, {"COLUMN2", "fee"}
+    };
+
+    t_view_spec flat;
+    bench_view<t_ctx0>(runner, options, "ctx0/flat", flat);
+
+    t_view_spec sorted;
+    sorted.m_sort = {{"bid", "desc"}};
+    bench_view<t_ctx0>(runner, options, "ctx0/sort", sorted);
+
+    t_view_spec filtered;
+    filtered.m_filter = {{"bid", ">", {threshold}}};
+    bench_view<t_ctx0>(runner, options, "ctx0/filter", filtered);
+
+    t_view_spec expression;
+    expression.m_expressions = {
+        {"notional", "COLUMN0 * COLUMN1 - COLUMN2", expression_columns}
+    };
+    bench_view<t_ctx0>(runner, options, "ctx0/expression", expression);
+
+    t_view_spec pivot;
+    pivot.m_group_by = {"desk", "sym"};
+    bench_view<t_ctx1>(runner, options, "ctx1/pivot", pivot);
+
+    t_view_spec pivot_sorted = pivot;
+    pivot_sorted.m_sort = {{"qty", "desc"}};
+    bench_view<t_ctx1>(runner, options, "ctx1/sort", pivot_sorted);
+
+    t_view_spec pivot_filtered = pivot;
+    pivot_filtered.m_filter = {{"bid", ">", {threshold}}};
+    bench_view<t_ctx1>(runner, options, "ctx1/filter", pivot_filtered);
+
+    t_view_spec pivot_expression = pivot;
+    pivot_expression.m_expressions = expression.m_expressions;
+    bench_view<t_ctx1>(runner, options, "ctx1/expression", pivot_expression);
+
+    t_view_spec split;
+    split.m_group_by = {"desk"};
+    split.m_split_by = {"side"};
+    bench_view<t_ctx2>(runner, options, "ctx2/pivot", split);
+
+    t_view_spec split_sorted = split;
+    split_sorted.m_sort = {{"qty", "desc"}};
+    bench_view<t_ctx2>(runner, options, "ctx2/sort", split_sorted);
+
+    t_view_spec split_filtered = split;
+    split_filtered.m_filter = {{"bid", ">", {threshold}}};
+    bench_view<t_ctx2>(runner, options, "ctx2/filter", split_filtered);
+
+    t_view_spec split_expression = split;
+    split_expression.m_expressions = expression.m_expressions;
+    bench_view<t_ctx2>(runner, options, "ctx2/expression", split_expression);
+
+    if (!options.m_json_path.empty()) {
+        runner.write_json(options.m_json_path);
+    }
+
+    return 0;
+}
@@ -13,6 +13,7 @@
 #include <perspective/first.h>
 #include <perspective/aggspec.h>
 #include <perspective/base.h>
+#include <perspective/rolling_window.h>
 #include <sstream>
 #include <utility>
 
@@ -89,6 +90,18 @@ t_aggspec::t_aggspec(
     m_agg_one_weight(agg_one_weight),
     m_agg_two_weight(agg_two_weight) {}
 
+t_aggspec::t_aggspec(
+    const std::string& aggname,
+    t_aggtype agg,
+    const std::vector<t_dep>& dependencies,
+    std::int64_t window
+) :
+    m_name(aggname),
+    m_disp_name(aggname),
+    m_agg(agg),
+    m_dependencies(dependencies),
+    m_window(window) {}
+
 t_aggspec::~t_aggspec() = default;
 
 std::string
@@ -235,6 +248,48 @@ t_aggspec::agg_str() const {
         case AGGTYPE_STANDARD_DEVIATION: {
             return "stddev";
         }
+        case AGGTYPE_P25: {
+            return "p25";
+        }
+        case AGGTYPE_P75: {
+            return "p75";
+        }
+        case AGGTYPE_P90: {
+            return "p90";
+        }
+        case AGGTYPE_P99: {
+            return "p99";
+        }
+        case AGGTYPE_APPROX_DISTINCT_COUNT: {
+            return "approx distinct count";
+        }
+        case AGGTYPE_APPROX_MEDIAN: {
+            return "approx median";
+        }
+        case AGGTYPE_APPROX_P90: {
+            return "approx p90";
+        }
+        case AGGTYPE_APPROX_P99: {
+            return "approx p99";
+        }
+        case AGGTYPE_ROLLING_SUM: {
+            return "rolling sum";
+        }
+        case AGGTYPE_ROLLING_COUNT: {
+            return "rolling count";
+        }
+        case AGGTYPE_ROLLING_MEAN: {
+            return "rolling mean";
+        }
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN: {
+            return "rolling weighted mean";
+        }
+        case AGGTYPE_ROLLING_MIN: {
+            return "rolling min";
+        }
+        case AGGTYPE_ROLLING_MAX: {
+            return "rolling max";
+        }
         default: {
             PSP_COMPLAIN_AND_ABORT("Unknown agg type");
             return "unknown";
@@ -300,6 +355,11 @@ t_aggspec::get_agg_two_weight() const {
     return m_agg_two_weight;
 }
 
+std::int64_t
+t_aggspec::get_window() const {
+    return m_window;
+}
+
 t_invmode
 t_aggspec::get_inv_mode() const {
     return m_invmode;
@@ -344,6 +404,10 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         case AGGTYPE_UNIQUE:
         case AGGTYPE_DOMINANT:
         case AGGTYPE_MEDIAN:
+        case AGGTYPE_P25:
+        case AGGTYPE_P75:
+        case AGGTYPE_P90:
+        case AGGTYPE_P99:
         case AGGTYPE_FIRST:
         case AGGTYPE_LAST_BY_INDEX:
         case AGGTYPE_LAST_MINUS_FIRST:
@@ -377,7 +441,10 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         case AGGTYPE_SCALED_ADD:
         case AGGTYPE_SCALED_MUL:
         case AGGTYPE_VARIANCE:
-        case AGGTYPE_STANDARD_DEVIATION: {
+        case AGGTYPE_STANDARD_DEVIATION:
+        case AGGTYPE_APPROX_MEDIAN:
+        case AGGTYPE_APPROX_P90:
+        case AGGTYPE_APPROX_P99: {
             return mk_col_name_type_vec(name(), DTYPE_FLOAT64);
         }
         case AGGTYPE_UDF_COMBINER:
@@ -393,9 +460,46 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         case AGGTYPE_AND: {
             return mk_col_name_type_vec(name(), DTYPE_BOOL);
         }
-        case AGGTYPE_DISTINCT_COUNT: {
+        case AGGTYPE_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_DISTINCT_COUNT: {
             return mk_col_name_type_vec(name(), DTYPE_UINT32);
         }
+        case AGGTYPE_ROLLING_SUM:
+        case AGGTYPE_ROLLING_COUNT:
+        case AGGTYPE_ROLLING_MEAN:
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN:
+        case AGGTYPE_ROLLING_MIN:
+        case AGGTYPE_ROLLING_MAX: {
+            t_uindex ndeps = agg() == AGGTYPE_ROLLING_WEIGHTED_MEAN ? 3 : 2;
+            if (m_dependencies.size() != ndeps) {
+                PSP_COMPLAIN_AND_ABORT(
+                    "Rolling aggregate has the wrong number of columns"
+                );
+            }
+
+            t_dtype order_dtype = schema.get_dtype(m_dependencies[1].name());
+            if (!is_rolling_order_dtype(order_dtype) || m_window < 0) {
+                PSP_COMPLAIN_AND_ABORT(
+                    "Rolling aggregates need a datetime or integer order "
+                    "column and a non-negative window"
+                );
+            }
+
+            switch (agg()) {
+                case AGGTYPE_ROLLING_COUNT: {
+                    return mk_col_name_type_vec(name(), DTYPE_INT64);
+                }
+                case AGGTYPE_ROLLING_MIN:
+                case AGGTYPE_ROLLING_MAX: {
+                    return mk_col_name_type_vec(
+                        name(), schema.get_dtype(m_dependencies[0].name())
+                    );
+                }
+                default: {
+                    return mk_col_name_type_vec(name(), DTYPE_FLOAT64);
+                }
+            }
+        }
         default: {
             PSP_COMPLAIN_AND_ABORT("Unknown agg type");
         }
@@ -576,6 +576,48 @@ str_to_aggtype(const std::string& str) {
     if (str == "stddev" || str == "standard deviation") {
         return t_aggtype::AGGTYPE_STANDARD_DEVIATION;
     }
+    if (str == "p25") {
+        return t_aggtype::AGGTYPE_P25;
+    }
+    if (str == "p75") {
+        return t_aggtype::AGGTYPE_P75;
+    }
+    if (str == "p90") {
+        return t_aggtype::AGGTYPE_P90;
+    }
+    if (str == "p99") {
+        return t_aggtype::AGGTYPE_P99;
+    }
+    if (str == "approx distinct count") {
+        return t_aggtype::AGGTYPE_APPROX_DISTINCT_COUNT;
+    }
+    if (str == "approx median") {
+        return t_aggtype::AGGTYPE_APPROX_MEDIAN;
+    }
+    if (str == "approx p90") {
+        return t_aggtype::AGGTYPE_APPROX_P90;
+    }
+    if (str == "approx p99") {
+        return t_aggtype::AGGTYPE_APPROX_P99;
+    }
+    if (str == "rolling sum") {
+        return t_aggtype::AGGTYPE_ROLLING_SUM;
+    }
+    if (str == "rolling count") {
+        return t_aggtype::AGGTYPE_ROLLING_COUNT;
+    }
+    if (str == "rolling mean") {
+        return t_aggtype::AGGTYPE_ROLLING_MEAN;
+    }
+    if (str == "rolling weighted mean") {
+        return t_aggtype::AGGTYPE_ROLLING_WEIGHTED_MEAN;
+    }
+    if (str == "rolling min") {
+        return t_aggtype::AGGTYPE_ROLLING_MIN;
+    }
+    if (str == "rolling max") {
+        return t_aggtype::AGGTYPE_ROLLING_MAX;
+    }
 
     std::stringstream ss;
     ss << "Encountered unknown aggregate operation: '" << str << "'"
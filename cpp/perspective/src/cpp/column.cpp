@@ -19,7 +19,10 @@ SUPPRESS_WARNINGS_VC(4505)
 #include <perspective/sym_table.h>
 #include <tsl/hopscotch_set.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <mutex>
 
 #include <utility>
 
@@ -68,21 +71,45 @@ t_column::t_column(const t_column_recipe& recipe) :
     }
 }
 
+// Copies of a disk backed column are short-lived, and a recipe for one
+// would map the source's file, so copy into memory instead.
+static t_lstore_recipe
+copy_recipe(const t_lstore& store) {
+    t_lstore_recipe recipe = store.get_recipe();
+
+    if (recipe.m_backing_store == BACKING_STORE_DISK) {
+        return t_lstore_recipe(recipe.m_capacity);
+    }
+
+    return recipe;
+}
+
 void
 t_column::column_copy_helper(const t_column& other) {
+    other.thaw();
     m_dtype = other.m_dtype;
     m_init = false;
     m_isvlen = other.m_isvlen;
-    m_data = std::make_shared<t_lstore>(other.m_data->get_recipe());
+    m_data = std::make_shared<t_lstore>(copy_recipe(*other.m_data));
     m_vocab = std::make_shared<t_vocab>(
-        other.m_vocab->get_vlendata()->get_recipe(),
-        other.m_vocab->get_extents()->get_recipe()
+        copy_recipe(*other.m_vocab->get_vlendata()),
+        copy_recipe(*other.m_vocab->get_extents())
     );
-    m_status = std::make_shared<t_lstore>(other.m_status->get_recipe());
+    m_status = std::make_shared<t_lstore>(copy_recipe(*other.m_status));
 
     m_size = other.m_size;
     m_status_enabled = other.m_status_enabled;
     m_from_recipe = false;
+    m_compressed_data.reset();
+    m_compressed_status.reset();
+    m_compressed = false;
+    m_read = false;
+    m_indexed = other.m_indexed;
+    m_zones.clear();
+    m_postings.clear();
+    m_chunk_dirty.clear();
+    m_chunk_nrows = 0;
+    m_chunks_stale = true;
 }
 
 t_column::t_column(const t_column& c) {
@@ -185,6 +212,7 @@ t_column::get_dtype() const {
 // extend based on dtype size
 void
 t_column::extend_dtype(t_uindex idx) {
+    thaw();
     t_uindex new_extents = idx * get_dtype_size(m_dtype);
     m_data->reserve(new_extents);
     m_data->set_size(new_extents);
@@ -211,6 +239,7 @@ t_column::get_interned(const char* s) {
 template <>
 void
 t_column::push_back<const char*>(const char* elem) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     if (elem == nullptr) {
         m_data->push_back(static_cast<t_uindex>(0));
@@ -225,6 +254,7 @@ t_column::push_back<const char*>(const char* elem) {
 template <>
 void
 t_column::push_back<char*>(char* elem) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     t_uindex idx = m_vocab->get_interned(elem);
     m_data->push_back(idx);
@@ -242,6 +272,7 @@ t_column::push_back<std::string>(std::string elem) {
 template <>
 void
 t_column::push_back<const char*>(const char* elem, t_status status) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     push_back(elem);
     m_status->push_back(status);
@@ -251,6 +282,7 @@ t_column::push_back<const char*>(const char* elem, t_status status) {
 template <>
 void
 t_column::push_back<char*>(char* elem, t_status status) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     push_back(elem);
     m_status->push_back(status);
@@ -260,6 +292,7 @@ t_column::push_back<char*>(char* elem, t_status status) {
 template <>
 void
 t_column::push_back<std::string>(std::string elem, t_status status) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     push_back(std::move(elem));
     m_status->push_back(status);
@@ -329,6 +362,7 @@ t_column::push_back<t_tscalar>(t_tscalar elem) {
 
 const t_lstore&
 t_column::data_lstore() const {
+    thaw();
     return *m_data;
 }
 
@@ -337,14 +371,477 @@ t_column::size() const {
     return m_size;
 }
 
+t_uindex
+t_column::nbytes() const {
+    t_uindex rv = 0;
+
+    if (m_data) {
+        rv += m_data->nbytes();
+    }
+
+    if (m_status_enabled && m_status) {
+        rv += m_status->nbytes();
+    }
+
+    if (m_compressed_data) {
+        rv += m_compressed_data->nbytes();
+    }
+
+    if (m_compressed_status) {
+        rv += m_compressed_status->nbytes();
+    }
+
+    return rv;
+}
+
+t_uindex
+t_column::vocab_nbytes() const {
+    return m_isvlen && m_vocab ? m_vocab->nbytes() : 0;
+}
+
+bool
+t_column::compress() {
+    if (!m_init || is_compressed() || m_size == 0
+        || !t_compressed_store::is_compressible(m_dtype)
+        || m_data->get_backing_store() != BACKING_STORE_MEMORY) {
+        return false;
+    }
+
+    t_uindex elem_size = get_dtype_size(m_dtype);
+    bool is_signed = m_dtype == DTYPE_INT64 || m_dtype == DTYPE_INT32
+        || m_dtype == DTYPE_INT16 || m_dtype == DTYPE_INT8
+        || m_dtype == DTYPE_TIME;
+
+    auto data = std::make_shared<t_compressed_store>();
+    data->encode(m_data->get_ptr(0), m_size, elem_size, is_signed);
+    t_uindex raw_nbytes = m_data->nbytes();
+    t_uindex encoded_nbytes = data->nbytes();
+
+    std::shared_ptr<t_compressed_store> status;
+    if (m_status_enabled) {
+        status = std::make_shared<t_compressed_store>();
+        status->encode(m_status->get_ptr(0), m_size, sizeof(t_status), false);
+        raw_nbytes += m_status->nbytes();
+        encoded_nbytes += status->nbytes();
+    }
+
+    // Decoding on the next access costs more than a small saving is worth.
+    if (encoded_nbytes * 4 > raw_nbytes * 3) {
+        return false;
+    }
+
+    m_data->set_size(0);
+    m_data->shrink(0);
+    m_compressed_data = data;
+
+    if (m_status_enabled) {
+        m_status->set_size(0);
+        m_status->shrink(0);
+        m_compressed_status = status;
+    }
+
+    m_compressed.store(true, std::memory_order_release);
+    return true;
+}
+
+bool
+t_column::is_compressed() const {
+    return m_compressed.load(std::memory_order_acquire);
+}
+
+bool
+t_column::take_read() {
+    return m_read.exchange(false, std::memory_order_relaxed);
+}
+
+void
+t_column::decompress() const {
+    // Columns are read from several threads at once, e.g. by `parallel_for`
+    // over a context's columns, so only the first reader decodes.
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!m_compressed.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    t_uindex elem_size = get_dtype_size(m_dtype);
+    m_data->reserve(m_size * elem_size);
+    m_compressed_data->decode(m_data->get_ptr(0));
+    m_data->set_size(m_size * elem_size);
+    m_compressed_data.reset();
+
+    if (m_status_enabled) {
+        m_status->reserve(m_size * sizeof(t_status));
+        m_compressed_status->decode(m_status->get_ptr(0));
+        m_status->set_size(m_size * sizeof(t_status));
+        m_compressed_status.reset();
+    }
+
+    m_compressed.store(false, std::memory_order_release);
+}
+
+bool
+t_column::has_zone_map() const {
+    switch (m_dtype) {
+        case DTYPE_INT64:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT64:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8:
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_DATE:
+        case DTYPE_TIME:
+        case DTYPE_BOOL: {
+            return true;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+}
+
+std::vector<t_zone>
+t_column::get_zone_map() const {
+    if (!m_init || !has_zone_map()) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(m_chunk_mtx);
+    refresh_chunks();
+    return m_zones;
+}
+
+void
+t_column::set_indexed(bool indexed) {
+    std::lock_guard<std::mutex> lock(m_chunk_mtx);
+    m_indexed = indexed;
+    if (!indexed) {
+        m_postings.clear();
+    }
+
+    invalidate_chunks();
+}
+
+bool
+t_column::is_indexed() const {
+    return m_indexed && m_dtype == DTYPE_STR;
+}
+
+void
+t_column::select_indexed(
+    const std::vector<t_uindex>& keys, bool nulls, t_mask& mask
+) const {
+    PSP_VERBOSE_ASSERT(is_indexed(), "Column is not indexed");
+    std::vector<t_uindex> sorted_keys = keys;
+    if (nulls) {
+        sorted_keys.push_back(t_postings::NULL_KEY);
+    }
+
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+    sorted_keys.erase(
+        std::unique(sorted_keys.begin(), sorted_keys.end()), sorted_keys.end()
+    );
+
+    std::lock_guard<std::mutex> lock(m_chunk_mtx);
+    refresh_chunks();
+
+    for (t_uindex cidx = 0; cidx < m_postings.size(); ++cidx) {
+        const t_postings& postings = m_postings[cidx];
+        t_uindex base = cidx * DEFAULT_ZONE_MAP_CHUNK_SIZE;
+        auto kiter = postings.m_keys.begin();
+
+        for (t_uindex key : sorted_keys) {
+            kiter = std::lower_bound(
+                kiter,
+                postings.m_keys.end(),
+                key,
+                [](const std::pair<t_uindex, t_uindex>& entry, t_uindex k) {
+                    return entry.first < k;
+                }
+            );
+
+            if (kiter == postings.m_keys.end()) {
+                break;
+            }
+
+            if (kiter->first != key) {
+                continue;
+            }
+
+            t_uindex end = kiter + 1 == postings.m_keys.end()
+                ? postings.m_rows.size()
+                : (kiter + 1)->second;
+
+            for (t_uindex ridx = kiter->second; ridx < end; ++ridx) {
+                mask.set(base + postings.m_rows[ridx]);
+            }
+        }
+    }
+}
+
+bool
+t_column::string_exists(const char* s, t_uindex& interned) const {
+    COLUMN_CHECK_STRCOL();
+    return m_vocab->string_exists(s, interned);
+}
+
+std::pair<t_tscalar, t_tscalar>
+t_column::get_min_max() const {
+    std::pair<t_tscalar, t_tscalar> rval(mknone(), mknone());
+
+    for (const auto& zone : get_zone_map()) {
+        if (!zone.m_min.is_valid()) {
+            continue;
+        }
+
+        if (!rval.first.is_valid() || zone.m_min < rval.first) {
+            rval.first = zone.m_min;
+        }
+
+        if (!rval.second.is_valid() || zone.m_max > rval.second) {
+            rval.second = zone.m_max;
+        }
+    }
+
+    return rval;
+}
+
+// The rows holding the smallest and largest valid values of a chunk, which
+// are the chunk's end row if it has none, and the number of rows that are
+// not valid.
+struct t_zone_scan {
+    t_uindex m_argmin;
+    t_uindex m_argmax;
+    t_uindex m_nnull;
+};
+
+template <typename T>
+static t_zone_scan
+scan_zone(
+    const void* base, const t_status* status, t_uindex bidx, t_uindex eidx
+) {
+    const T* data = static_cast<const T*>(base);
+    t_zone_scan rval{eidx, eidx, 0};
+
+    for (t_uindex idx = bidx; idx < eidx; ++idx) {
+        if (status != nullptr && status[idx] != STATUS_VALID) {
+            ++rval.m_nnull;
+            continue;
+        }
+
+        const T& v = data[idx];
+
+        // NaN fails every comparison, so it can neither bound the chunk nor
+        // pass a range filter.
+        if (v != v) {
+            continue;
+        }
+
+        if (rval.m_argmin == eidx || v < data[rval.m_argmin]) {
+            rval.m_argmin = idx;
+        }
+
+        if (rval.m_argmax == eidx || data[rval.m_argmax] < v) {
+            rval.m_argmax = idx;
+        }
+    }
+
+    return rval;
+}
+
+void
+t_column::refresh_postings(t_uindex nchunks) const {
+    t_uindex chunk_size = DEFAULT_ZONE_MAP_CHUNK_SIZE;
+    const t_uindex* data = get_nth<t_uindex>(0);
+    const t_status* status =
+        is_status_enabled() ? get_nth_status(0) : nullptr;
+    std::vector<std::pair<t_uindex, std::uint16_t>> entries;
+    m_postings.resize(nchunks);
+
+    for (t_uindex cidx = 0; cidx < nchunks; ++cidx) {
+        if (m_chunk_dirty[cidx] == 0) {
+            continue;
+        }
+
+        t_uindex bidx = cidx * chunk_size;
+        t_uindex eidx = std::min(bidx + chunk_size, m_size);
+        entries.clear();
+
+        for (t_uindex idx = bidx; idx < eidx; ++idx) {
+            bool valid = status == nullptr || status[idx] == STATUS_VALID;
+            entries.emplace_back(
+                valid ? data[idx] : t_postings::NULL_KEY,
+                static_cast<std::uint16_t>(idx - bidx)
+            );
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        t_postings& postings = m_postings[cidx];
+        postings.m_rows.resize(entries.size());
+        postings.m_keys.clear();
+
+        for (t_uindex pos = 0; pos < entries.size(); ++pos) {
+            const auto& [key, row] = entries[pos];
+            if (postings.m_keys.empty()
+                || postings.m_keys.back().first != key) {
+                postings.m_keys.emplace_back(key, pos);
+            }
+
+            postings.m_rows[pos] = row;
+        }
+
+        m_chunk_dirty[cidx] = 0;
+    }
+}
+
+void
+t_column::refresh_chunks() const {
+    t_uindex chunk_size = DEFAULT_ZONE_MAP_CHUNK_SIZE;
+    t_uindex nchunks = (m_size + chunk_size - 1) / chunk_size;
+
+    if (m_chunks_stale.exchange(false)) {
+        m_chunk_dirty.assign(nchunks, 1);
+    } else if (m_size != m_chunk_nrows) {
+        // Rows were appended or removed from the end, which dirties the
+        // last chunk as it was and every chunk after it.
+        t_uindex first = std::min(m_size, m_chunk_nrows) / chunk_size;
+        m_chunk_dirty.resize(nchunks, 1);
+        for (t_uindex cidx = first; cidx < nchunks; ++cidx) {
+            m_chunk_dirty[cidx] = 1;
+        }
+    }
+
+    m_chunk_nrows = m_size;
+    if (nchunks == 0) {
+        m_zones.clear();
+        m_postings.clear();
+        return;
+    }
+
+    if (is_indexed()) {
+        refresh_postings(nchunks);
+        return;
+    }
+
+    m_zones.resize(nchunks);
+    const void* data = get_nth<std::uint8_t>(0);
+    const t_status* status =
+        is_status_enabled() ? get_nth_status(0) : nullptr;
+
+    for (t_uindex cidx = 0; cidx < nchunks; ++cidx) {
+        if (m_chunk_dirty[cidx] == 0) {
+            continue;
+        }
+
+        t_uindex bidx = cidx * chunk_size;
+        t_uindex eidx = std::min(bidx + chunk_size, m_size);
+        t_zone_scan scan;
+
+        switch (m_dtype) {
+            case DTYPE_INT64: {
+                scan = scan_zone<std::int64_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_INT32: {
+                scan = scan_zone<std::int32_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_INT16: {
+                scan = scan_zone<std::int16_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_INT8: {
+                scan = scan_zone<std::int8_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_UINT64: {
+                scan = scan_zone<std::uint64_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_UINT32: {
+                scan = scan_zone<std::uint32_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_UINT16: {
+                scan = scan_zone<std::uint16_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_UINT8: {
+                scan = scan_zone<std::uint8_t>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_FLOAT64: {
+                scan = scan_zone<double>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_FLOAT32: {
+                scan = scan_zone<float>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_DATE: {
+                scan = scan_zone<t_date::t_rawtype>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_TIME: {
+                scan = scan_zone<t_time::t_rawtype>(data, status, bidx, eidx);
+            } break;
+            case DTYPE_BOOL: {
+                scan = scan_zone<bool>(data, status, bidx, eidx);
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Column has no zone map");
+            } break;
+        }
+
+        t_zone& zone = m_zones[cidx];
+        zone.m_nrows = eidx - bidx;
+        zone.m_nnull = scan.m_nnull;
+        zone.m_min =
+            scan.m_argmin == eidx ? mknone() : get_scalar(scan.m_argmin);
+        zone.m_max =
+            scan.m_argmax == eidx ? mknone() : get_scalar(scan.m_argmax);
+        m_chunk_dirty[cidx] = 0;
+    }
+}
+
+t_uindex
+t_column::resident_nbytes() const {
+    t_uindex rv = m_data->resident_nbytes();
+
+    if (m_status_enabled) {
+        rv += m_status->resident_nbytes();
+    }
+
+    if (m_isvlen) {
+        rv += m_vocab->get_vlendata()->resident_nbytes();
+        rv += m_vocab->get_extents()->resident_nbytes();
+    }
+
+    return rv;
+}
+
+void
+t_column::advise(t_access_advice advice) const {
+    m_data->advise(advice);
+
+    if (m_status_enabled) {
+        m_status->advise(advice);
+    }
+
+    if (m_isvlen) {
+        m_vocab->get_vlendata()->advise(advice);
+        m_vocab->get_extents()->advise(advice);
+    }
+}
+
 void
 t_column::set_size(t_uindex size) {
+    thaw();
 #ifdef PSP_COLUMN_VERIFY
     PSP_VERBOSE_ASSERT(
         size * get_dtype_size(m_dtype) <= m_data->capacity(),
         "Not enough space reserved for column"
     );
 #endif
+    if (size < m_size) {
+        invalidate_chunks();
+    }
+
     m_size = size;
     m_data->set_size(m_elemsize * size);
 
@@ -355,12 +852,22 @@ t_column::set_size(t_uindex size) {
 
 void
 t_column::reserve(t_uindex size) {
+    thaw();
     m_data->reserve(get_dtype_size(m_dtype) * size);
     if (is_status_enabled()) {
         m_status->reserve(get_dtype_size(DTYPE_UINT8) * size);
     }
 }
 
+void
+t_column::shrink(t_uindex size) {
+    thaw();
+    m_data->shrink(get_dtype_size(m_dtype) * size);
+    if (is_status_enabled()) {
+        m_status->shrink(get_dtype_size(DTYPE_UINT8) * size);
+    }
+}
+
 // object storage, specialize only for std::uint64_t
 template <>
 void
@@ -368,6 +875,7 @@ t_column::object_copied<std::uint64_t>(t_uindex ptr) const {}
 
 void
 t_column::notify_object_copied(t_uindex idx) const {
+    thaw();
     // if (*get_nth_status(idx) == STATUS_VALID)
     //     object_copied<PSP_OBJECT_TYPE>(*(get_nth<std::uint64_t>(idx)));
 }
@@ -378,12 +886,15 @@ t_column::object_cleared<std::uint64_t>(t_uindex ptr) const {}
 
 void
 t_column::notify_object_cleared(t_uindex idx) const {
+    thaw();
     // if (*get_nth_status(idx) == STATUS_VALID)
     //     object_cleared<PSP_OBJECT_TYPE>(*(get_nth<std::uint64_t>(idx)));
 }
 
 t_lstore*
 t_column::_get_data_lstore() {
+    thaw();
+    invalidate_chunks();
     return m_data.get();
 }
 
@@ -399,6 +910,7 @@ t_column::get_vlenidx() const {
 
 t_tscalar
 t_column::get_scalar(t_uindex idx) const {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     t_tscalar rv;
     rv.clear();
@@ -491,6 +1003,7 @@ t_column::clear(t_uindex idx) {
 
 void
 t_column::clear(t_uindex idx, t_status status) {
+    thaw();
     switch (m_dtype) {
         case DTYPE_STR: {
             t_uindex v = 0;
@@ -535,6 +1048,7 @@ t_column::clear(t_uindex idx, t_status status) {
 template <>
 char*
 t_column::get_nth<char>(t_uindex idx) {
+    thaw();
     PSP_COMPLAIN_AND_ABORT("Unsafe operation detected");
     ++idx;
     return nullptr;
@@ -543,6 +1057,7 @@ t_column::get_nth<char>(t_uindex idx) {
 template <>
 const char*
 t_column::get_nth<const char>(t_uindex idx) const {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     COLUMN_CHECK_STRCOL();
     const auto* sidx = get_nth<t_uindex>(idx);
@@ -552,6 +1067,7 @@ t_column::get_nth<const char>(t_uindex idx) const {
 // idx is in items
 const t_status*
 t_column::get_nth_status(t_uindex idx) const {
+    thaw();
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
     auto* status = m_status->get_nth<t_status>(idx);
@@ -560,6 +1076,7 @@ t_column::get_nth_status(t_uindex idx) const {
 
 bool
 t_column::is_valid(t_uindex idx) const {
+    thaw();
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
     t_status status = *m_status->get_nth<t_status>(idx);
@@ -568,15 +1085,34 @@ t_column::is_valid(t_uindex idx) const {
 
 bool
 t_column::is_cleared(t_uindex idx) const {
+    thaw();
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     COLUMN_CHECK_ACCESS(idx);
     t_status status = *m_status->get_nth<t_status>(idx);
     return status == STATUS_CLEAR;
 }
 
+bool
+t_column::all_invalid() const {
+    thaw();
+    if (!is_status_enabled()) {
+        return false;
+    }
+
+    if (size() == 0) {
+        return true;
+    }
+
+    const auto* status = m_status->get_nth<t_status>(0);
+    return std::all_of(status, status + size(), [](t_status s) {
+        return s == STATUS_INVALID;
+    });
+}
+
 template <>
 void
 t_column::set_nth<const char*>(t_uindex idx, const char* elem) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     set_nth_body(idx, elem, STATUS_VALID);
 }
@@ -584,6 +1120,7 @@ t_column::set_nth<const char*>(t_uindex idx, const char* elem) {
 template <>
 void
 t_column::set_nth<std::string>(t_uindex idx, std::string elem) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     set_nth(idx, elem.c_str(), STATUS_VALID);
 }
@@ -593,6 +1130,7 @@ void
 t_column::set_nth<const char*>(
     t_uindex idx, const char* elem, t_status status
 ) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     set_nth_body(idx, elem, status);
 }
@@ -602,6 +1140,7 @@ void
 t_column::set_nth<std::string>(
     t_uindex idx, std::string elem, t_status status
 ) {
+    thaw();
     COLUMN_CHECK_STRCOL();
     set_nth(idx, elem.c_str(), status);
 }
@@ -613,12 +1152,15 @@ t_column::set_valid(t_uindex idx, bool valid) {
 
 void
 t_column::set_status(t_uindex idx, t_status status) {
+    thaw();
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
     m_status->set_nth<t_status>(idx, status);
+    mark_chunk_dirty(idx);
 }
 
 void
 t_column::set_scalar(t_uindex idx, t_tscalar value) {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     value.m_type = m_dtype;
 
@@ -709,6 +1251,8 @@ t_column::is_vlen() const {
 
 void
 t_column::append(const t_column& other) {
+    thaw();
+    other.thaw();
     PSP_VERBOSE_ASSERT(m_dtype == other.m_dtype, "Mismatched dtypes detected");
     if (is_vlen()) {
         if (size() == 0) {
@@ -750,6 +1294,8 @@ t_column::append(const t_column& other) {
 
 void
 t_column::clear() {
+    thaw();
+    invalidate_chunks();
     // clear out the data store
     m_data->set_size(0);
     if (m_dtype == DTYPE_STR) {
@@ -761,6 +1307,16 @@ t_column::clear() {
     m_size = 0;
 }
 
+void
+t_column::reset_vocabulary() {
+    if (!is_vlen_dtype(m_dtype)) {
+        return;
+    }
+
+    m_vocab = std::make_shared<t_vocab>();
+    m_vocab->init(false);
+}
+
 void
 t_column::clear_objects() const {
     for (t_uindex idx = 0, loop_end = size(); idx < loop_end; ++idx) {
@@ -777,6 +1333,7 @@ t_column::pprint() const {
 
 t_column_recipe
 t_column::get_recipe() const {
+    thaw();
     t_column_recipe rval;
     rval.m_dtype = m_dtype;
     rval.m_data = m_data->get_recipe();
@@ -797,6 +1354,110 @@ t_column::get_recipe() const {
     return rval;
 }
 
+static void
+save_store(const t_lstore& store, const std::string& fname) {
+    if (store.size() > 0) {
+        store.save(fname);
+    }
+}
+
+static void
+load_store(t_lstore& store, const std::string& fname, t_uindex size) {
+    if (size > 0) {
+        store.load(fname);
+    }
+
+    store.set_size(size);
+}
+
+void
+t_column::save(const std::string& fname) const {
+    thaw();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    save_store(*m_data, fname + ".data");
+
+    if (m_status_enabled) {
+        save_store(*m_status, fname + ".status");
+    }
+
+    if (m_isvlen) {
+        save_store(*m_vocab->get_vlendata(), fname + ".vlendata");
+        save_store(*m_vocab->get_extents(), fname + ".extents");
+    }
+}
+
+/**
+ * @brief Whether every one of the `vlenidx` extents of a vocabulary loaded
+ * from a snapshot names a null terminated string inside its string store.
+ */
+static bool
+vocab_is_consistent(t_vocab& vocab, t_uindex vlenidx) {
+    const t_lstore& extents = *vocab.get_extents();
+    const t_lstore& vlendata = *vocab.get_vlendata();
+    if (extents.size() < vlenidx * sizeof(t_extent_pair)) {
+        return false;
+    }
+
+    const auto* chars = static_cast<const char*>(vlendata.get_ptr(0));
+    for (t_uindex idx = 0; idx < vlenidx; ++idx) {
+        const auto& extent = *extents.get_nth<t_extent_pair>(idx);
+        if (extent.m_begin >= extent.m_end || extent.m_end > vlendata.size()
+            || chars[extent.m_end - 1] != '\0') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+t_column::load(const std::string& fname, const t_column_recipe& recipe) {
+    thaw();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    invalidate_chunks();
+
+    if (recipe.m_dtype != m_dtype
+        || recipe.m_status_enabled != m_status_enabled) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot column does not match the schema.");
+    }
+
+    load_store(*m_data, fname + ".data", recipe.m_data.m_size);
+
+    if (m_status_enabled) {
+        load_store(*m_status, fname + ".status", recipe.m_status.m_size);
+    }
+
+    if (m_isvlen) {
+        load_store(
+            *m_vocab->get_vlendata(),
+            fname + ".vlendata",
+            recipe.m_vlendata.m_size
+        );
+
+        load_store(
+            *m_vocab->get_extents(), fname + ".extents", recipe.m_extents.m_size
+        );
+
+        m_vocab->set_vlenidx(recipe.m_vlenidx);
+        if (!vocab_is_consistent(*m_vocab, recipe.m_vlenidx)) {
+            PSP_COMPLAIN_AND_ABORT("Snapshot column vocabulary is corrupt.");
+        }
+
+        for (t_uindex ridx = 0; ridx < recipe.m_size; ++ridx) {
+            if (*m_data->get_nth<t_uindex>(ridx) >= recipe.m_vlenidx
+                && (!m_status_enabled
+                    || *m_status->get_nth<t_status>(ridx) == STATUS_VALID)) {
+                PSP_COMPLAIN_AND_ABORT("Snapshot column data is corrupt.");
+            }
+        }
+
+        m_vocab->rebuild_map();
+    }
+
+    m_size = recipe.m_size;
+    COLUMN_CHECK_VALUES();
+}
+
 void
 t_column::copy_vocabulary(const t_column* other) {
 #ifdef PSP_COLUMN_VERIFY
@@ -817,6 +1478,7 @@ t_column::pprint_vocabulary() const {
 
 std::shared_ptr<t_column>
 t_column::clone() const {
+    thaw();
     auto rval = std::make_shared<t_column>(*this);
     rval->init();
     rval->set_size(size());
@@ -836,8 +1498,28 @@ t_column::clone() const {
     return rval;
 }
 
+void
+t_column::copy_from(const t_column& other) {
+    thaw();
+    other.thaw();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    invalidate_chunks();
+    m_data->fill(*other.m_data);
+
+    if (m_status_enabled) {
+        m_status->fill(*other.m_status);
+    }
+
+    if (m_isvlen) {
+        m_vocab->clone(*other.m_vocab);
+    }
+
+    m_size = other.m_size;
+}
+
 std::shared_ptr<t_column>
 t_column::clone(const t_mask& mask) const {
+    thaw();
     if (mask.count() == size()) {
         return clone();
     }
@@ -861,13 +1543,43 @@ t_column::clone(const t_mask& mask) const {
     return rval;
 }
 
+void
+t_column::move_rows(const std::vector<std::pair<t_uindex, t_uindex>>& moves) {
+    thaw();
+    if (moves.empty()) {
+        return;
+    }
+
+    t_uindex elem_size = get_dtype_size(m_dtype);
+    auto* base = m_data->get<unsigned char>(0);
+
+    for (const auto& [from, to] : moves) {
+        COLUMN_CHECK_ACCESS(from);
+        COLUMN_CHECK_ACCESS(to);
+        std::memcpy(base + to * elem_size, base + from * elem_size, elem_size);
+        mark_chunk_dirty(to);
+
+        if (is_status_enabled()) {
+            set_status(to, *get_nth_status(from));
+        }
+
+        // The row now lives at `to`, so `from` must not keep a second
+        // reference to it (or to an object).
+        clear(from);
+    }
+}
+
 void
 t_column::valid_raw_fill() {
+    thaw();
+    invalidate_chunks();
     m_status->raw_fill(STATUS_VALID);
 }
 
 void
 t_column::invalid_raw_fill() {
+    thaw();
+    invalidate_chunks();
     m_status->raw_fill(STATUS_INVALID);
 }
 
@@ -939,6 +1651,7 @@ void
 t_column::copy_helper<const char>(
     const t_column* other, const std::vector<t_uindex>& indices, t_uindex offset
 ) {
+    thaw();
     t_uindex eidx =
         std::min(other->size(), static_cast<t_uindex>(indices.size()));
     reserve(eidx + offset);
@@ -954,6 +1667,7 @@ void
 t_column::fill(
     std::vector<const char*>& vec, const t_uindex* bidx, const t_uindex* eidx
 ) const {
+    thaw();
 
     PSP_VERBOSE_ASSERT(eidx - bidx > 0, "Invalid pointers passed in");
 
@@ -976,6 +1690,7 @@ t_column::verify() const {
 
 void
 t_column::verify_size(t_uindex idx) const {
+    thaw();
     if (m_dtype == DTYPE_USER_FIXED) {
         return;
     }
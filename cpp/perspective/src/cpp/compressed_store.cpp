@@ -0,0 +1,543 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/first.h>
+#include <perspective/compressed_store.h>
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace perspective {
+
+enum t_block_encoding : std::uint8_t {
+    BLOCK_ENCODING_RAW,
+    BLOCK_ENCODING_RLE,
+    BLOCK_ENCODING_DICT,
+    BLOCK_ENCODING_FOR,
+    BLOCK_ENCODING_DELTA
+};
+
+// Dictionaries larger than this are not worth their index width.
+static const t_uindex MAX_DICT_SIZE = 256;
+
+static const std::uint64_t SIGN_BIT = std::uint64_t(1) << 63;
+
+// Signed values are sign extended and have their sign bit flipped, so that
+// keys sort in the same order as the values they encode.
+template <typename T>
+static std::uint64_t
+load_key(const std::uint8_t* ptr, bool is_signed) {
+    T v;
+    std::memcpy(&v, ptr, sizeof(T));
+
+    if (is_signed) {
+        auto s = static_cast<std::int64_t>(
+            static_cast<std::make_signed_t<T>>(v)
+        );
+
+        return static_cast<std::uint64_t>(s) ^ SIGN_BIT;
+    }
+
+    return static_cast<std::uint64_t>(v);
+}
+
+template <typename T>
+static void
+store_key(std::uint64_t key, std::uint8_t* ptr, bool is_signed) {
+    T v = static_cast<T>(is_signed ? key ^ SIGN_BIT : key);
+    std::memcpy(ptr, &v, sizeof(T));
+}
+
+template <typename T>
+static void
+load_keys_impl(
+    const std::uint8_t* base,
+    t_uindex n,
+    bool is_signed,
+    std::vector<std::uint64_t>& keys
+) {
+    for (t_uindex idx = 0; idx < n; ++idx) {
+        keys[idx] = load_key<T>(base + idx * sizeof(T), is_signed);
+    }
+}
+
+template <typename T>
+static void
+store_keys_impl(
+    const std::vector<std::uint64_t>& keys,
+    t_uindex n,
+    bool is_signed,
+    std::uint8_t* base
+) {
+    for (t_uindex idx = 0; idx < n; ++idx) {
+        store_key<T>(keys[idx], base + idx * sizeof(T), is_signed);
+    }
+}
+
+static void
+load_keys(
+    const std::uint8_t* base,
+    t_uindex n,
+    t_uindex elem_size,
+    bool is_signed,
+    std::vector<std::uint64_t>& keys
+) {
+    switch (elem_size) {
+        case 1: {
+            load_keys_impl<std::uint8_t>(base, n, is_signed, keys);
+        } break;
+        case 2: {
+            load_keys_impl<std::uint16_t>(base, n, is_signed, keys);
+        } break;
+        case 4: {
+            load_keys_impl<std::uint32_t>(base, n, is_signed, keys);
+        } break;
+        case 8: {
+            load_keys_impl<std::uint64_t>(base, n, is_signed, keys);
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Unsupported element size");
+        }
+    }
+}
+
+static void
+store_keys(
+    const std::vector<std::uint64_t>& keys,
+    t_uindex n,
+    t_uindex elem_size,
+    bool is_signed,
+    std::uint8_t* base
+) {
+    switch (elem_size) {
+        case 1: {
+            store_keys_impl<std::uint8_t>(keys, n, is_signed, base);
+        } break;
+        case 2: {
+            store_keys_impl<std::uint16_t>(keys, n, is_signed, base);
+        } break;
+        case 4: {
+            store_keys_impl<std::uint32_t>(keys, n, is_signed, base);
+        } break;
+        case 8: {
+            store_keys_impl<std::uint64_t>(keys, n, is_signed, base);
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Unsupported element size");
+        }
+    }
+}
+
+static void
+put_u64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    std::uint8_t bytes[8];
+    std::memcpy(bytes, &v, 8);
+    out.insert(out.end(), bytes, bytes + 8);
+}
+
+static std::uint64_t
+get_u64(const std::uint8_t*& ptr) {
+    std::uint64_t v;
+    std::memcpy(&v, ptr, 8);
+    ptr += 8;
+    return v;
+}
+
+static void
+put_varint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+static std::uint64_t
+get_varint(const std::uint8_t*& ptr) {
+    std::uint64_t v = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        std::uint8_t byte = *ptr++;
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return v;
+        }
+    }
+}
+
+static t_uindex
+varint_size(std::uint64_t v) {
+    t_uindex rv = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        ++rv;
+    }
+
+    return rv;
+}
+
+static std::uint8_t
+bit_width(std::uint64_t v) {
+    std::uint8_t rv = 0;
+    while (v != 0) {
+        ++rv;
+        v >>= 1;
+    }
+
+    return rv;
+}
+
+static t_uindex
+packed_size(t_uindex n, std::uint8_t width) {
+    return (n * width + 7) / 8;
+}
+
+static std::uint64_t
+zigzag(std::uint64_t delta) {
+    auto d = static_cast<std::int64_t>(delta);
+    return (static_cast<std::uint64_t>(d) << 1)
+        ^ static_cast<std::uint64_t>(d >> 63);
+}
+
+static std::uint64_t
+unzigzag(std::uint64_t z) {
+    return (z >> 1) ^ (~(z & 1) + 1);
+}
+
+// Append `n` values of `width` bits each, least significant bit first.
+static void
+pack(
+    const std::uint64_t* values,
+    t_uindex n,
+    std::uint8_t width,
+    std::vector<std::uint8_t>& out
+) {
+    if (width == 0) {
+        return;
+    }
+
+    t_uindex end = out.size() + packed_size(n, width);
+    std::uint64_t acc = 0;
+    unsigned nbits = 0;
+
+    for (t_uindex idx = 0; idx < n; ++idx) {
+        std::uint64_t v = values[idx];
+        acc |= v << nbits;
+
+        if (nbits + width >= 64) {
+            put_u64(out, acc);
+            unsigned consumed = 64 - nbits;
+            acc = consumed < 64 ? v >> consumed : 0;
+            nbits = nbits + width - 64;
+        } else {
+            nbits += width;
+        }
+    }
+
+    if (nbits > 0) {
+        put_u64(out, acc);
+    }
+
+    out.resize(end);
+}
+
+// Reads up to 8 bytes past the packed values, which `encode` pads for.
+static void
+unpack(
+    const std::uint8_t* ptr,
+    t_uindex n,
+    std::uint8_t width,
+    std::uint64_t* values
+) {
+    if (width == 0) {
+        std::fill(values, values + n, 0);
+        return;
+    }
+
+    std::uint64_t mask = width == 64 ? ~std::uint64_t(0)
+                                     : (std::uint64_t(1) << width) - 1;
+    std::uint64_t acc = 0;
+    unsigned avail = 0;
+
+    for (t_uindex idx = 0; idx < n; ++idx) {
+        if (avail >= width) {
+            values[idx] = acc & mask;
+            acc = width < 64 ? acc >> width : 0;
+            avail -= width;
+        } else {
+            std::uint64_t next = get_u64(ptr);
+            values[idx] = (acc | (next << avail)) & mask;
+            unsigned consumed = width - avail;
+            acc = consumed < 64 ? next >> consumed : 0;
+            avail = 64 - consumed;
+        }
+    }
+}
+
+t_compressed_store::t_compressed_store() :
+    m_nelems(0),
+    m_elem_size(0),
+    m_signed(false) {}
+
+bool
+t_compressed_store::is_compressible(t_dtype dtype) {
+    switch (dtype) {
+        case DTYPE_INT64:
+        case DTYPE_UINT64:
+        case DTYPE_INT32:
+        case DTYPE_UINT32:
+        case DTYPE_INT16:
+        case DTYPE_UINT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT8:
+        case DTYPE_BOOL:
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_STR:
+        case DTYPE_TIME:
+        case DTYPE_DATE: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void
+t_compressed_store::encode(
+    const void* base, t_uindex nelems, t_uindex elem_size, bool is_signed
+) {
+    m_nelems = nelems;
+    m_elem_size = elem_size;
+    m_signed = is_signed;
+    m_bytes.clear();
+    m_block_offsets.clear();
+
+    const auto* src = static_cast<const std::uint8_t*>(base);
+    std::vector<std::uint64_t> keys(DEFAULT_COMPRESSION_BLOCK_SIZE);
+    std::vector<std::uint64_t> scratch(DEFAULT_COMPRESSION_BLOCK_SIZE);
+    std::vector<std::uint64_t> dict;
+
+    for (t_uindex begin = 0; begin < nelems;
+         begin += DEFAULT_COMPRESSION_BLOCK_SIZE) {
+        t_uindex n = std::min(
+            static_cast<t_uindex>(DEFAULT_COMPRESSION_BLOCK_SIZE),
+            nelems - begin
+        );
+
+        const std::uint8_t* block = src + begin * elem_size;
+        load_keys(block, n, elem_size, is_signed, keys);
+        m_block_offsets.push_back(m_bytes.size());
+
+        // Size each encoding before writing the smallest one.
+        t_uindex raw_size = n * elem_size;
+
+        t_uindex nruns = 0;
+        t_uindex rle_size = 0;
+        for (t_uindex idx = 0; idx < n;) {
+            t_uindex end = idx + 1;
+            while (end < n && keys[end] == keys[idx]) {
+                ++end;
+            }
+
+            rle_size += 8 + varint_size(end - idx);
+            ++nruns;
+            idx = end;
+        }
+
+        rle_size += varint_size(nruns);
+
+        auto [min_it, max_it] =
+            std::minmax_element(keys.begin(), keys.begin() + n);
+        std::uint64_t min_key = *min_it;
+        std::uint8_t for_width = bit_width(*max_it - min_key);
+        t_uindex for_size = 9 + packed_size(n, for_width);
+
+        std::uint64_t min_delta = ~std::uint64_t(0);
+        std::uint64_t max_delta = 0;
+        for (t_uindex idx = 1; idx < n; ++idx) {
+            scratch[idx] = zigzag(keys[idx] - keys[idx - 1]);
+            min_delta = std::min(min_delta, scratch[idx]);
+            max_delta = std::max(max_delta, scratch[idx]);
+        }
+
+        std::uint8_t delta_width =
+            n > 1 ? bit_width(max_delta - min_delta) : 0;
+        t_uindex delta_size = 17 + packed_size(n - 1, delta_width);
+
+        dict.assign(keys.begin(), keys.begin() + n);
+        std::sort(dict.begin(), dict.end());
+        dict.erase(std::unique(dict.begin(), dict.end()), dict.end());
+        std::uint8_t dict_width = bit_width(dict.size() - 1);
+        t_uindex dict_size = dict.size() <= MAX_DICT_SIZE
+            ? varint_size(dict.size()) + dict.size() * 8
+                + packed_size(n, dict_width)
+            : raw_size + 1;
+
+        t_uindex best = std::min(
+            {raw_size, rle_size, for_size, delta_size, dict_size}
+        );
+
+        if (best == raw_size) {
+            m_bytes.push_back(BLOCK_ENCODING_RAW);
+            m_bytes.insert(m_bytes.end(), block, block + raw_size);
+        } else if (best == rle_size) {
+            m_bytes.push_back(BLOCK_ENCODING_RLE);
+            put_varint(m_bytes, nruns);
+            for (t_uindex idx = 0; idx < n;) {
+                t_uindex end = idx + 1;
+                while (end < n && keys[end] == keys[idx]) {
+                    ++end;
+                }
+
+                put_u64(m_bytes, keys[idx]);
+                put_varint(m_bytes, end - idx);
+                idx = end;
+            }
+        } else if (best == for_size) {
+            m_bytes.push_back(BLOCK_ENCODING_FOR);
+            put_u64(m_bytes, min_key);
+            m_bytes.push_back(for_width);
+            for (t_uindex idx = 0; idx < n; ++idx) {
+                scratch[idx] = keys[idx] - min_key;
+            }
+
+            pack(scratch.data(), n, for_width, m_bytes);
+        } else if (best == delta_size) {
+            m_bytes.push_back(BLOCK_ENCODING_DELTA);
+            put_u64(m_bytes, keys[0]);
+            put_u64(m_bytes, min_delta);
+            m_bytes.push_back(delta_width);
+            for (t_uindex idx = 1; idx < n; ++idx) {
+                scratch[idx] -= min_delta;
+            }
+
+            pack(scratch.data() + 1, n - 1, delta_width, m_bytes);
+        } else {
+            m_bytes.push_back(BLOCK_ENCODING_DICT);
+            put_varint(m_bytes, dict.size());
+            for (auto key : dict) {
+                put_u64(m_bytes, key);
+            }
+
+            for (t_uindex idx = 0; idx < n; ++idx) {
+                scratch[idx] =
+                    std::lower_bound(dict.begin(), dict.end(), keys[idx])
+                    - dict.begin();
+            }
+
+            pack(scratch.data(), n, dict_width, m_bytes);
+        }
+    }
+
+    // Padding for `unpack`, which reads whole words.
+    m_bytes.resize(m_bytes.size() + 8, 0);
+    m_bytes.shrink_to_fit();
+    m_block_offsets.shrink_to_fit();
+}
+
+void
+t_compressed_store::decode_block(t_uindex bidx, void* out) const {
+    t_uindex begin = bidx * DEFAULT_COMPRESSION_BLOCK_SIZE;
+    t_uindex n = std::min(
+        static_cast<t_uindex>(DEFAULT_COMPRESSION_BLOCK_SIZE),
+        m_nelems - begin
+    );
+
+    const std::uint8_t* ptr = m_bytes.data() + m_block_offsets[bidx];
+    auto* dst = static_cast<std::uint8_t*>(out);
+    auto encoding = static_cast<t_block_encoding>(*ptr++);
+
+    if (encoding == BLOCK_ENCODING_RAW) {
+        std::memcpy(dst, ptr, n * m_elem_size);
+        return;
+    }
+
+    std::vector<std::uint64_t> keys(n);
+
+    switch (encoding) {
+        case BLOCK_ENCODING_RLE: {
+            t_uindex nruns = get_varint(ptr);
+            t_uindex idx = 0;
+            for (t_uindex run = 0; run < nruns; ++run) {
+                std::uint64_t key = get_u64(ptr);
+                t_uindex len = get_varint(ptr);
+                std::fill(keys.begin() + idx, keys.begin() + idx + len, key);
+                idx += len;
+            }
+        } break;
+        case BLOCK_ENCODING_DICT: {
+            t_uindex ndict = get_varint(ptr);
+            std::vector<std::uint64_t> dict(ndict);
+            for (auto& key : dict) {
+                key = get_u64(ptr);
+            }
+
+            unpack(ptr, n, bit_width(ndict - 1), keys.data());
+            for (auto& key : keys) {
+                key = dict[key];
+            }
+        } break;
+        case BLOCK_ENCODING_FOR: {
+            std::uint64_t min_key = get_u64(ptr);
+            std::uint8_t width = *ptr++;
+            unpack(ptr, n, width, keys.data());
+            for (auto& key : keys) {
+                key += min_key;
+            }
+        } break;
+        case BLOCK_ENCODING_DELTA: {
+            keys[0] = get_u64(ptr);
+            std::uint64_t min_delta = get_u64(ptr);
+            std::uint8_t width = *ptr++;
+            unpack(ptr, n - 1, width, keys.data() + 1);
+            for (t_uindex idx = 1; idx < n; ++idx) {
+                keys[idx] = keys[idx - 1] + unzigzag(keys[idx] + min_delta);
+            }
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Unknown block encoding");
+        }
+    }
+
+    store_keys(keys, n, m_elem_size, m_signed, dst);
+}
+
+void
+t_compressed_store::decode(void* out) const {
+    auto* dst = static_cast<std::uint8_t*>(out);
+    for (t_uindex bidx = 0, nblocks = num_blocks(); bidx < nblocks; ++bidx) {
+        decode_block(
+            bidx, dst + bidx * DEFAULT_COMPRESSION_BLOCK_SIZE * m_elem_size
+        );
+    }
+}
+
+t_uindex
+t_compressed_store::size() const {
+    return m_nelems;
+}
+
+t_uindex
+t_compressed_store::num_blocks() const {
+    return m_block_offsets.size();
+}
+
+t_uindex
+t_compressed_store::nbytes() const {
+    return m_bytes.capacity()
+        + m_block_offsets.capacity() * sizeof(t_uindex);
+}
+
+} // end namespace perspective
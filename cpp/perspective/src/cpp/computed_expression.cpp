@@ -11,7 +11,12 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/computed_expression.h>
+#include <perspective/env_vars.h>
 
+#include <tsl/hopscotch_map.h>
+
+#include <algorithm>
+#include <cctype>
 #include <utility>
 
 namespace perspective {
@@ -101,6 +106,60 @@ t_tscalar t_computed_expression_parser::FALSE_SCALAR = mktscalar(false);
  * t_computed_expression
  */
 
+namespace {
+
+/**
+ * @brief Returns true if `parsed_expression_string` calls a function whose
+ * result is not a pure function of its arguments - these read the clock, the
+ * row index or other rows, so the expression must be evaluated on every row.
+ * String literals are skipped, so `match("Name", 'random')` is not flagged.
+ */
+bool
+is_row_dependent_expression(const std::string& parsed_expression_string) {
+    static const tsl::hopscotch_set<std::string> ROW_DEPENDENT_FUNCTIONS = {
+        "random", "now", "today", "index", "col", "vlookup"
+    };
+
+    const std::string& expr = parsed_expression_string;
+    std::size_t i = 0;
+
+    while (i < expr.size()) {
+        char c = expr[i];
+
+        if (c == '\'' || c == '"') {
+            std::size_t end = i + 1;
+            while (end < expr.size() && expr[end] != c) {
+                end += expr[end] == '\\' ? 2 : 1;
+            }
+
+            i = end + 1;
+            continue;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            std::size_t end = i;
+            while (end < expr.size()
+                   && (std::isalnum(static_cast<unsigned char>(expr[end]))
+                       || expr[end] == '_')) {
+                ++end;
+            }
+
+            if (ROW_DEPENDENT_FUNCTIONS.count(expr.substr(i, end - i)) != 0) {
+                return true;
+            }
+
+            i = end;
+            continue;
+        }
+
+        ++i;
+    }
+
+    return false;
+}
+
+} // namespace
+
 t_computed_expression::t_computed_expression(
     std::string expression_alias,
     std::string expression_string,
@@ -112,7 +171,13 @@ t_computed_expression::t_computed_expression(
     m_expression_string(std::move(expression_string)),
     m_parsed_expression_string(std::move(parsed_expression_string)),
     m_column_ids(column_ids),
-    m_dtype(dtype) {}
+    m_dtype(dtype),
+    m_kernel(t_expression_kernel::compile(
+        m_parsed_expression_string, m_column_ids
+    )),
+    m_is_row_independent(
+        !is_row_dependent_expression(m_parsed_expression_string)
+    ) {}
 
 void
 t_computed_expression::compute(
@@ -122,6 +187,33 @@ t_computed_expression::compute(
     t_expression_vocab& vocab,
     t_regex_mapping& regex_mapping
 ) const {
+    // create or get output column using m_expression_alias
+    auto output_column =
+        destination_table->add_column_sptr(m_expression_alias, m_dtype, true);
+    auto num_rows = source_table->size();
+    output_column->reserve(num_rows);
+
+    // Try the vectorized kernel first - rows it cannot evaluate exactly are
+    // returned in `fallback_rows` and computed by ExprTk below.
+    std::vector<t_uindex> fallback_rows;
+    bool kernel_computed = false;
+
+    if (m_kernel != nullptr) {
+        std::vector<std::shared_ptr<t_column>> kernel_inputs;
+        kernel_inputs.reserve(m_column_ids.size());
+        for (const auto& [column_id, column_name] : m_column_ids) {
+            kernel_inputs.push_back(source_table->get_column(column_name));
+        }
+
+        kernel_computed = m_kernel->compute(
+            kernel_inputs, num_rows, m_dtype, *output_column, fallback_rows
+        );
+
+        if (kernel_computed && fallback_rows.empty()) {
+            return;
+        }
+    }
+
     // TODO: share symtables across pre/re/compute
     exprtk::symbol_table<t_tscalar> sym_table;
 
@@ -171,27 +263,82 @@ t_computed_expression::compute(
         PSP_COMPLAIN_AND_ABORT(ss.str());
     }
 
-    // create or get output column using m_expression_alias
-    auto output_column =
-        destination_table->add_column_sptr(m_expression_alias, m_dtype, true);
-    auto num_rows = source_table->size();
-    output_column->reserve(num_rows);
-
-    for (t_uindex ridx = 0; ridx < num_rows; ++ridx) {
+    auto evaluate_row = [&](t_uindex ridx) {
         for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
             const std::string& column_id = m_column_ids[cidx].first;
             values[cidx].second.set(columns[column_id]->get_scalar(ridx));
         }
         row_idx = ridx;
+        return expr_definition.value();
+    };
 
-        t_tscalar value = expr_definition.value();
-
+    auto write_row = [&](t_uindex ridx, const t_tscalar& value) {
         if (!value.is_valid() || value.is_none()) {
             output_column->clear(ridx);
-            continue;
+            return;
         }
 
         output_column->set_scalar(ridx, value);
+    };
+
+    // An expression over a single string column - `upper("Name")`,
+    // `match("Name", ...)`, `substring("Name", 0, 3)` - is a pure function of
+    // the interned string, so it only needs to run once per distinct vocab
+    // entry; every other row sharing that entry reuses the memoized result.
+    std::shared_ptr<t_column> dictionary_column;
+
+    if (num_input_columns == 1 && m_is_row_independent
+        && !t_env::disable_expression_dictionary_eval()) {
+        const auto& input_column = columns[m_column_ids[0].first];
+        if (input_column->get_dtype() == DTYPE_STR) {
+            dictionary_column = input_column;
+        }
+    }
+
+    // Keyed by vocab index and sized to the rows being computed rather than
+    // the whole vocab, so a small update against a large dictionary does not
+    // allocate a slot for every string the column has ever seen.
+    tsl::hopscotch_map<t_uindex, t_tscalar> memo;
+
+    if (dictionary_column != nullptr) {
+        t_uindex vocab_size = dictionary_column->_get_vocab()->get_vlenidx();
+        t_uindex rows_to_compute =
+            kernel_computed ? fallback_rows.size() : num_rows;
+        memo.reserve(std::min(vocab_size, rows_to_compute));
+    }
+
+    auto compute_row = [&](t_uindex ridx) {
+        if (dictionary_column == nullptr) {
+            write_row(ridx, evaluate_row(ridx));
+            return;
+        }
+
+        // Null and cleared rows are cheap to evaluate and must keep their
+        // distinct statuses, so they are not memoized.
+        if (dictionary_column->is_status_enabled()
+            && !dictionary_column->is_valid(ridx)) {
+            write_row(ridx, evaluate_row(ridx));
+            return;
+        }
+
+        t_uindex interned = *(dictionary_column->get_nth<t_uindex>(ridx));
+        auto it = memo.find(interned);
+
+        if (it == memo.end()) {
+            it = memo.emplace(interned, evaluate_row(ridx)).first;
+        }
+
+        write_row(ridx, it->second);
+    };
+
+    if (kernel_computed) {
+        for (auto ridx : fallback_rows) {
+            compute_row(ridx);
+        }
+    } else {
+        for (t_uindex ridx = 0; ridx < num_rows; ++ridx) {
+            compute_row(ridx);
+        }
     }
 
     function_store.clear_computed_function_state();
@@ -222,6 +369,11 @@ t_computed_expression::get_dtype() const {
     return m_dtype;
 }
 
+bool
+t_computed_expression::is_row_independent() const {
+    return m_is_row_independent;
+}
+
 /******************************************************************************
  *
  * t_computed_expression_parser
@@ -214,6 +214,10 @@ t_config::setup(
             case AGGTYPE_WEIGHTED_MEAN:
             case AGGTYPE_UNIQUE:
             case AGGTYPE_MEDIAN:
+            case AGGTYPE_P25:
+            case AGGTYPE_P75:
+            case AGGTYPE_P90:
+            case AGGTYPE_P99:
             case AGGTYPE_JOIN:
             case AGGTYPE_DOMINANT:
             case AGGTYPE_PY_AGG:
@@ -227,6 +231,16 @@ t_config::setup(
             case AGGTYPE_DISTINCT_LEAF:
             case AGGTYPE_VARIANCE:
             case AGGTYPE_STANDARD_DEVIATION:
+            case AGGTYPE_APPROX_DISTINCT_COUNT:
+            case AGGTYPE_APPROX_MEDIAN:
+            case AGGTYPE_APPROX_P90:
+            case AGGTYPE_APPROX_P99:
+            case AGGTYPE_ROLLING_SUM:
+            case AGGTYPE_ROLLING_COUNT:
+            case AGGTYPE_ROLLING_MEAN:
+            case AGGTYPE_ROLLING_WEIGHTED_MEAN:
+            case AGGTYPE_ROLLING_MIN:
+            case AGGTYPE_ROLLING_MAX:
                 m_has_pkey_agg = true;
                 break;
             default:
@@ -281,6 +295,88 @@ t_config::repr() const {
     return ss.str();
 }
 
+// Writes `str` length-prefixed, so user text such as expressions and filter
+// strings can't run into the delimiters of the rest of the tree key.
+static void
+append_key_str(std::stringstream& ss, const std::string& str) {
+    ss << str.size() << "#" << str;
+}
+
+// Writes `scalar` exactly: strings by value, everything else by its type,
+// status and raw bits, as `to_string` rounds floats to 6 digits.
+static void
+append_key_scalar(std::stringstream& ss, const t_tscalar& scalar) {
+    ss << static_cast<int>(scalar.m_type) << "/"
+       << static_cast<int>(scalar.m_status) << "/";
+    if (scalar.is_str()) {
+        const char* str = scalar.get_char_ptr();
+        append_key_str(ss, str == nullptr ? "" : str);
+    } else {
+        ss << scalar.m_data.m_uint64;
+    }
+}
+
+std::string
+t_config::get_tree_key() const {
+    std::stringstream ss;
+
+    for (const auto& expr : m_expressions) {
+        if (!expr->is_row_independent()) {
+            return "";
+        }
+
+        ss << "expr:";
+        append_key_str(ss, expr->get_expression_alias());
+        append_key_str(ss, expr->get_parsed_expression_string());
+        for (const auto& [column_id, column_name] : expr->get_column_ids()) {
+            append_key_str(ss, column_id);
+            append_key_str(ss, column_name);
+        }
+        ss << ";";
+    }
+
+    for (const auto& pivot : m_row_pivots) {
+        ss << "row:" << pivot.colname() << ":" << pivot.mode() << ";";
+    }
+
+    for (const auto& pivot : m_col_pivots) {
+        ss << "col:" << pivot.colname() << ":" << pivot.mode() << ";";
+    }
+
+    for (const auto& agg : m_aggregates) {
+        ss << "agg:" << agg.name() << ":" << agg.agg_str() << ":"
+           << agg.get_sort_type() << ":" << agg.get_agg_one_idx() << ":"
+           << agg.get_agg_two_idx() << ":" << agg.get_agg_one_weight() << ":"
+           << agg.get_agg_two_weight() << ":" << agg.get_window();
+        for (const auto& dep : agg.get_dependencies()) {
+            ss << ":" << dep.name() << "/" << dep.type();
+        }
+        ss << ";";
+    }
+
+    for (const auto& [pivot, sortby] : m_sortby) {
+        ss << "sortby:" << pivot << "=" << sortby << ";";
+    }
+
+    ss << "combiner:" << m_combiner << ";";
+    for (const auto& fterm : m_fterms) {
+        ss << "filter:" << fterm.m_negated << ":" << fterm.m_op << ":";
+        append_key_str(ss, fterm.m_colname);
+        append_key_scalar(ss, fterm.m_threshold);
+        ss << ":" << fterm.m_bag.size();
+        for (const auto& value : fterm.m_bag) {
+            ss << ":";
+            append_key_scalar(ss, value);
+        }
+        ss << ";";
+    }
+
+    ss << "totals:" << m_totals << ";column_only:" << m_column_only
+       << ";fmode:" << m_fmode << ";grand_agg:" << m_grand_agg_str;
+
+    return ss.str();
+}
+
 t_uindex
 t_config::get_num_aggregates() const {
     return m_aggregates.size();
@@ -64,6 +64,31 @@ t_ctx_grouped_pkey::get_expression_tables() const {
     return m_expression_tables;
 }
 
+t_ctx_memory_usage
+t_ctx_grouped_pkey::get_memory_usage() const {
+    t_ctx_memory_usage rv;
+
+    if (m_tree) {
+        rv.m_tree_bytes = m_tree->nbytes();
+    }
+
+    if (m_traversal) {
+        rv.m_traversal_bytes = m_traversal->nbytes();
+    }
+
+    if (m_expression_tables) {
+        rv.m_expression_bytes = m_expression_tables->nbytes();
+    }
+
+    return rv;
+}
+
+t_transitional_needs
+t_ctx_grouped_pkey::get_transitional_needs() const {
+    // `notify` rebuilds the tree from the gnode state.
+    return {};
+}
+
 t_index
 t_ctx_grouped_pkey::get_row_count() const {
     PSP_TRACE_SENTINEL();
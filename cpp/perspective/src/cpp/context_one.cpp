@@ -31,7 +31,8 @@ namespace perspective {
 t_ctx1::t_ctx1(const t_schema& schema, const t_config& pivot_config) :
     t_ctxbase<t_ctx1>(schema, pivot_config),
     m_depth(0),
-    m_depth_set(false) {}
+    m_depth_set(false),
+    m_tree_shared(false) {}
 
 t_ctx1::~t_ctx1() = default;
 
@@ -346,7 +347,15 @@ void
 t_ctx1::step_end() {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
-    sort_by(m_sortby);
+    if (!m_sortby.empty()) {
+        m_traversal->sort_updated(
+            m_config,
+            m_sortby,
+            *(m_tree),
+            m_tree->get_shape_delta().m_updated_ids
+        );
+    }
+
     if (m_depth_set) {
         set_depth(m_depth);
     }
@@ -424,6 +433,24 @@ t_ctx1::set_depth(t_depth depth) {
     m_depth_set = true;
 }
 
+std::vector<t_path>
+t_ctx1::get_expansion_state() const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (m_depth_set) {
+        return {};
+    }
+
+    return ctx_get_expansion_state(m_tree, m_traversal);
+}
+
+void
+t_ctx1::set_expansion_state(const std::vector<t_path>& paths) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    ctx_set_expansion_state(*this, HEADER_ROW, m_tree, m_traversal, paths);
+}
+
 std::vector<t_tscalar>
 t_ctx1::get_pkeys(const std::vector<std::pair<t_uindex, t_uindex>>& cells
 ) const {
@@ -485,7 +512,7 @@ t_ctx1::get_step_delta(t_index bidx, t_index eidx) {
     t_stepdelta rval(
         m_rows_changed, m_columns_changed, get_cell_delta(bidx, eidx)
     );
-    m_tree->clear_deltas();
+    clear_deltas();
     return rval;
 }
 
@@ -503,28 +530,47 @@ t_ctx1::get_row_delta() {
     std::vector<t_uindex> rows = get_rows_changed();
     std::vector<t_tscalar> data = get_data(rows);
     t_rowdelta rval(m_rows_changed, rows.size(), data);
-    m_tree->clear_deltas();
+    clear_deltas();
+    return rval;
+}
+
+t_rowdelta
+t_ctx1::get_row_delta(t_index bidx, t_index eidx) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    std::vector<t_uindex> rows = get_rows_changed(bidx, eidx);
+    std::vector<t_tscalar> data = get_data(rows);
+    t_rowdelta rval(m_rows_changed, rows.size(), data);
     return rval;
 }
 
 std::vector<t_uindex>
 t_ctx1::get_rows_changed() {
+    return get_rows_changed(0, t_index(m_traversal->size()));
+}
+
+std::vector<t_uindex>
+t_ctx1::get_rows_changed(t_index bidx, t_index eidx) const {
     std::vector<t_uindex> rows;
     const auto& deltas = m_tree->get_deltas();
-    auto eidx = t_uindex(m_traversal->size());
 
-    for (t_uindex idx = 0; idx < eidx; ++idx) {
+    if (deltas->empty()) {
+        return rows;
+    }
+
+    bidx = std::max(bidx, t_index(0));
+    eidx = std::min(eidx, t_index(m_traversal->size()));
+
+    // Rows are visited in order, so `rows` is sorted and unique.
+    for (t_index idx = bidx; idx < eidx; ++idx) {
         t_index ptidx = m_traversal->get_tree_index(idx);
         // Retrieve delta from storage and check if the row has been changed
         auto iterators = deltas->get<by_tc_nidx_aggidx>().equal_range(ptidx);
-        bool unique_ridx =
-            std::find(rows.begin(), rows.end(), idx) == rows.end();
-        if ((iterators.first != iterators.second) && unique_ridx) {
+        if (iterators.first != iterators.second) {
             rows.push_back(idx);
         }
     }
 
-    std::sort(rows.begin(), rows.end());
     return rows;
 }
 
@@ -556,6 +602,7 @@ t_ctx1::reset(bool reset_expressions) {
     m_tree->init();
     m_tree->set_deltas_enabled(get_feature_state(CTX_FEAT_DELTA));
     m_traversal = std::make_shared<t_traversal>(m_tree);
+    m_tree_shared = false;
 
     if (reset_expressions) {
         m_expression_tables->reset();
@@ -790,6 +837,30 @@ t_ctx1::get_expression_tables() const {
     return m_expression_tables;
 }
 
+t_ctx_memory_usage
+t_ctx1::get_memory_usage() const {
+    t_ctx_memory_usage rv;
+
+    if (m_tree) {
+        rv.m_tree_bytes = m_tree->nbytes();
+    }
+
+    if (m_traversal) {
+        rv.m_traversal_bytes = m_traversal->nbytes();
+    }
+
+    if (m_expression_tables) {
+        rv.m_expression_bytes = m_expression_tables->nbytes();
+    }
+
+    return rv;
+}
+
+t_transitional_needs
+t_ctx1::get_transitional_needs() const {
+    return tree_transitional_needs(m_config);
+}
+
 std::vector<t_tscalar>
 t_ctx1::unity_get_row_data(t_uindex idx) const {
     auto rval = get_data(idx, idx + 1, 0, get_column_count());
@@ -880,9 +951,37 @@ t_ctx1::unity_get_column_expanded(t_uindex idx) const {
 
 void
 t_ctx1::clear_deltas() {
+    if (m_tree_shared) {
+        return;
+    }
+
     m_tree->clear_deltas();
 }
 
+void
+t_ctx1::share_trees(const t_ctx1& other) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    m_tree = other.m_tree;
+    if (get_feature_state(CTX_FEAT_DELTA)) {
+        m_tree->set_deltas_enabled(true);
+    }
+
+    m_traversal = std::make_shared<t_traversal>(m_tree);
+}
+
+void
+t_ctx1::notify_from_shared_tree() {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    notify_traversal(m_tree, m_traversal, m_sortby);
+}
+
+void
+t_ctx1::set_tree_shared(bool shared) {
+    m_tree_shared = shared;
+}
+
 void
 t_ctx1::unity_init_load_step_end() {}
 
@@ -27,14 +27,16 @@ t_ctx2::t_ctx2() :
     m_row_depth(0),
     m_row_depth_set(false),
     m_column_depth(0),
-    m_column_depth_set(false) {}
+    m_column_depth_set(false),
+    m_tree_shared(false) {}
 
 t_ctx2::t_ctx2(const t_schema& schema, const t_config& pivot_config) :
     t_ctxbase<t_ctx2>(schema, pivot_config),
     m_row_depth(0),
     m_row_depth_set(false),
     m_column_depth(0),
-    m_column_depth_set(false) {}
+    m_column_depth_set(false),
+    m_tree_shared(false) {}
 
 t_ctx2::~t_ctx2() = default;
 
@@ -103,6 +105,36 @@ t_ctx2::get_expression_tables() const {
     return m_expression_tables;
 }
 
+t_ctx_memory_usage
+t_ctx2::get_memory_usage() const {
+    t_ctx_memory_usage rv;
+
+    for (const auto& tree : m_trees) {
+        if (tree) {
+            rv.m_tree_bytes += tree->nbytes();
+        }
+    }
+
+    if (m_rtraversal) {
+        rv.m_traversal_bytes += m_rtraversal->nbytes();
+    }
+
+    if (m_ctraversal) {
+        rv.m_traversal_bytes += m_ctraversal->nbytes();
+    }
+
+    if (m_expression_tables) {
+        rv.m_expression_bytes = m_expression_tables->nbytes();
+    }
+
+    return rv;
+}
+
+t_transitional_needs
+t_ctx2::get_transitional_needs() const {
+    return tree_transitional_needs(m_config);
+}
+
 void
 t_ctx2::step_begin() {
     reset_step_state();
@@ -152,6 +184,9 @@ t_ctx2::open(t_header header, t_index idx) {
         m_column_depth_set = false;
         m_column_depth = 0;
         m_columns_changed = (retval > 0);
+        if (m_columns_changed) {
+            m_rtraversal->invalidate_sort();
+        }
     }
 
     return retval;
@@ -179,6 +214,9 @@ t_ctx2::close(t_header header, t_index idx) {
             m_column_depth = 0;
             retval = m_ctraversal->collapse_node(idx);
             m_columns_changed = (retval > 0);
+            if (m_columns_changed) {
+                m_rtraversal->invalidate_sort();
+            }
         } break;
         default: {
             PSP_COMPLAIN_AND_ABORT("Invalid header type detected.");
@@ -509,6 +547,7 @@ t_ctx2::column_sort_by(const std::vector<t_sortspec>& sortby) {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
     m_ctraversal->sort_by(m_config, sortby, *(ctree()));
+    m_rtraversal->invalidate_sort();
 }
 
 void
@@ -522,6 +561,25 @@ t_ctx2::sort_by(const std::vector<t_sortspec>& sortby) {
     m_rtraversal->sort_by(m_config, sortby, *(rtree()), this);
 }
 
+void
+t_ctx2::sort_updated_rows() {
+    // Row sort keys are read from the cells of the column at each sort's
+    // index, so every row's key may change when the columns do.
+    const t_stree_shape_delta& column_delta = ctree()->get_shape_delta();
+    if (!column_delta.m_leaves.empty()
+        || !column_delta.m_zero_strands.empty()) {
+        m_rtraversal->invalidate_sort();
+    }
+
+    m_rtraversal->sort_updated(
+        m_config,
+        m_sortby,
+        *(rtree()),
+        rtree()->get_shape_delta().m_updated_ids,
+        this
+    );
+}
+
 void
 t_ctx2::reset_sortby() {
     PSP_TRACE_SENTINEL();
@@ -575,7 +633,7 @@ t_ctx2::notify(const t_data_table& flattened) {
         }
     }
     if (!m_sortby.empty()) {
-        sort_by(m_sortby);
+        sort_updated_rows();
     }
 }
 
@@ -649,7 +707,7 @@ t_ctx2::notify(
     }
 
     if (!m_sortby.empty()) {
-        sort_by(m_sortby);
+        sort_updated_rows();
     }
 }
 
@@ -916,7 +974,10 @@ t_ctx2::set_depth(t_header header, t_depth depth) {
             }
             new_depth =
                 std::min<t_depth>(m_config.get_num_cpivots() - 1, depth);
-            m_ctraversal->set_depth(m_column_sortby, new_depth);
+            if (m_ctraversal->set_depth(m_column_sortby, new_depth) > 0) {
+                m_rtraversal->invalidate_sort();
+            }
+
             m_column_depth = new_depth;
             m_column_depth_set = true;
         } break;
@@ -926,6 +987,52 @@ t_ctx2::set_depth(t_header header, t_depth depth) {
     }
 }
 
+std::vector<t_path>
+t_ctx2::get_expansion_state(t_header header) const {
+    switch (header) {
+        case HEADER_ROW: {
+            if (m_row_depth_set) {
+                return {};
+            }
+
+            return ctx_get_expansion_state(rtree(), m_rtraversal);
+        } break;
+        case HEADER_COLUMN: {
+            if (m_column_depth_set) {
+                return {};
+            }
+
+            return ctx_get_expansion_state(ctree(), m_ctraversal);
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Invalid header");
+        } break;
+    }
+
+    return {};
+}
+
+void
+t_ctx2::set_expansion_state(
+    t_header header, const std::vector<t_path>& paths
+) {
+    switch (header) {
+        case HEADER_ROW: {
+            ctx_set_expansion_state(
+                *this, header, rtree(), m_rtraversal, paths
+            );
+        } break;
+        case HEADER_COLUMN: {
+            ctx_set_expansion_state(
+                *this, header, ctree(), m_ctraversal, paths
+            );
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Invalid header");
+        } break;
+    }
+}
+
 std::vector<t_tscalar>
 t_ctx2::get_pkeys(const std::vector<std::pair<t_uindex, t_uindex>>& cells
 ) const {
@@ -1017,16 +1124,50 @@ t_ctx2::get_row_delta() {
     return rval;
 }
 
+t_rowdelta
+t_ctx2::get_row_delta(
+    t_index start_row, t_index end_row, t_index start_col, t_index end_col
+) {
+    std::vector<t_uindex> rows =
+        get_rows_changed(start_row, end_row, start_col, end_col);
+    std::vector<t_tscalar> data = get_data(rows);
+    t_rowdelta rval(true, rows.size(), data);
+    return rval;
+}
+
 std::vector<t_uindex>
 t_ctx2::get_rows_changed() {
-    t_uindex nrows = get_row_count();
-    t_uindex ncols = get_num_view_columns();
+    return get_rows_changed(
+        0, t_index(get_row_count()), 1, t_index(get_num_view_columns())
+    );
+}
+
+std::vector<t_uindex>
+t_ctx2::get_rows_changed(
+    t_index start_row, t_index end_row, t_index start_col, t_index end_col
+) const {
     std::vector<t_uindex> rows;
+
+    bool has_deltas = false;
+    for (const auto& tree : m_trees) {
+        has_deltas = has_deltas || !tree->get_deltas()->empty();
+    }
+
+    if (!has_deltas) {
+        return rows;
+    }
+
+    // Column 0 is the row path, which never has a delta.
+    start_row = std::max(start_row, t_index(0));
+    end_row = std::min(end_row, t_index(get_row_count()));
+    start_col = std::max(start_col, t_index(1));
+    end_col = std::min(end_col, t_index(get_num_view_columns()));
+
     std::vector<std::pair<t_uindex, t_uindex>> cells;
 
     // get cells and imbue with additional information
-    for (t_uindex ridx = 0; ridx < nrows; ++ridx) {
-        for (t_uindex cidx = 1; cidx < ncols; ++cidx) {
+    for (t_index ridx = start_row; ridx < end_row; ++ridx) {
+        for (t_index cidx = start_col; cidx < end_col; ++cidx) {
             cells.emplace_back(ridx, cidx);
         }
     }
@@ -1039,15 +1180,13 @@ t_ctx2::get_rows_changed() {
         }
         const auto& deltas = m_trees[c.m_treenum]->get_deltas();
         auto iterators = deltas->get<by_tc_nidx_aggidx>().equal_range(c.m_idx);
-        auto ridx = c.m_ridx;
-        bool unique_ridx =
-            std::find(rows.begin(), rows.end(), ridx) == rows.end();
-        if ((iterators.first != iterators.second) && unique_ridx) {
-            rows.push_back(ridx);
+        if (iterators.first != iterators.second) {
+            rows.push_back(c.m_ridx);
         }
     }
 
     std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
     return rows;
 }
 
@@ -1080,6 +1219,7 @@ t_ctx2::reset(bool reset_expressions) {
 
     m_rtraversal = std::make_shared<t_traversal>(rtree());
     m_ctraversal = std::make_shared<t_traversal>(ctree());
+    m_tree_shared = false;
 
     if (reset_expressions) {
         m_expression_tables->reset();
@@ -1099,11 +1239,55 @@ t_ctx2::reset_step_state() {
 
 void
 t_ctx2::clear_deltas() {
+    if (m_tree_shared) {
+        return;
+    }
+
     for (auto& tr : m_trees) {
         tr->clear_deltas();
     }
 }
 
+void
+t_ctx2::share_trees(const t_ctx2& other) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    m_trees = other.m_trees;
+    if (get_feature_state(CTX_FEAT_DELTA)) {
+        for (auto& tr : m_trees) {
+            tr->set_deltas_enabled(true);
+        }
+    }
+
+    m_rtraversal = std::make_shared<t_traversal>(rtree());
+    m_ctraversal = std::make_shared<t_traversal>(ctree());
+}
+
+void
+t_ctx2::notify_from_shared_tree() {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    // Mirrors `notify()`: only the row and column trees have traversals.
+    for (t_uindex tree_idx = 0, loop_end = m_trees.size(); tree_idx < loop_end;
+         ++tree_idx) {
+        if (is_rtree_idx(tree_idx) != 0U) {
+            notify_traversal(rtree(), m_rtraversal, m_sortby);
+        } else if (is_ctree_idx(tree_idx) != 0U) {
+            notify_traversal(ctree(), m_ctraversal, m_column_sortby);
+        }
+    }
+
+    if (!m_sortby.empty()) {
+        sort_updated_rows();
+    }
+}
+
+void
+t_ctx2::set_tree_shared(bool shared) {
+    m_tree_shared = shared;
+}
+
 void
 t_ctx2::set_feature_state(t_ctx_feature feature, bool state) {
     m_features[feature] = state;
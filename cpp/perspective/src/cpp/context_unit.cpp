@@ -16,6 +16,7 @@
 #include <perspective/context_unit.h>
 #include <perspective/flat_traversal.h>
 #include <perspective/sym_table.h>
+#include <perspective/env_vars.h>
 
 #include <perspective/filter_utils.h>
 
@@ -135,6 +136,10 @@ t_ctxunit::notify(const t_data_table& flattened) {
 std::pair<t_tscalar, t_tscalar>
 t_ctxunit::get_min_max(const std::string& colname) const {
     auto col = m_gstate->get_table()->get_const_column(colname);
+    if (col->has_zone_map() && !t_env::disable_zone_maps()) {
+        return col->get_min_max();
+    }
+
     auto rval = std::make_pair(mknone(), mknone());
     for (std::size_t i = 0; i < col->size(); i++) {
         t_tscalar val = col->get_scalar(i);
@@ -377,6 +382,19 @@ t_ctxunit::get_deltas_enabled() const {
 void
 t_ctxunit::set_deltas_enabled(bool enabled_state) {}
 
+t_ctx_memory_usage
+t_ctxunit::get_memory_usage() const {
+    t_ctx_memory_usage rv;
+    rv.m_delta_bytes = hash_container_nbytes(m_delta_pkeys);
+    return rv;
+}
+
+t_transitional_needs
+t_ctxunit::get_transitional_needs() const {
+    // `notify` only reads the pkeys and ops from `flattened`.
+    return {};
+}
+
 t_index
 t_ctxunit::sidedness() const {
     return 0;
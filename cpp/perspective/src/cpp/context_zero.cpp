@@ -16,6 +16,7 @@
 #include <perspective/context_zero.h>
 #include <perspective/flat_traversal.h>
 #include <perspective/sym_table.h>
+#include <perspective/env_vars.h>
 
 #include <perspective/filter_utils.h>
 
@@ -110,6 +111,11 @@ t_ctx0::notify(
 
     bool delete_encountered = false;
 
+    // Rows whose sort columns were not part of the update keep their place
+    // in the traversal.
+    bool resort_updated_rows =
+        m_traversal->sort_columns_changed(*m_gstate, m_config);
+
     if (m_config.has_filters()) {
         t_mask msk_prev = filter_table_for_config(prev, m_config);
         t_mask msk_curr = filter_table_for_config(curr, m_config);
@@ -128,14 +134,14 @@ t_ctx0::notify(
                     bool filter_prev = msk_prev.get(idx) && existed;
 
                     if (filter_prev) {
-                        if (filter_curr) {
+                        if (filter_curr && resort_updated_rows) {
                             m_traversal->update_row(
                                 *m_gstate,
                                 *(m_expression_tables->m_master),
                                 m_config,
                                 pkey
                             );
-                        } else {
+                        } else if (!filter_curr) {
                             m_traversal->delete_row(pkey);
                         }
                     } else {
@@ -178,12 +184,14 @@ t_ctx0::notify(
         switch (op) {
             case OP_INSERT: {
                 if (existed) {
-                    m_traversal->update_row(
-                        *m_gstate,
-                        *(m_expression_tables->m_master),
-                        m_config,
-                        pkey
-                    );
+                    if (resort_updated_rows) {
+                        m_traversal->update_row(
+                            *m_gstate,
+                            *(m_expression_tables->m_master),
+                            m_config,
+                            pkey
+                        );
+                    }
                 } else {
                     m_traversal->add_row(
                         *m_gstate,
@@ -289,6 +297,16 @@ t_ctx0::notify(const t_data_table& flattened) {
  */
 std::pair<t_tscalar, t_tscalar>
 t_ctx0::get_min_max(const std::string& colname) const {
+    // Without filters the context holds every row of the master table, whose
+    // zone map already bounds the column.
+    if (!m_config.has_filters() && !is_expression_column(colname)
+        && !t_env::disable_zone_maps()) {
+        auto col = m_gstate->get_table()->get_const_column(colname);
+        if (col->has_zone_map()) {
+            return col->get_min_max();
+        }
+    }
+
     std::pair<t_tscalar, t_tscalar> rval(mknone(), mknone());
     t_uindex ctx_nrows = get_row_count();
     std::vector<t_tscalar> values(ctx_nrows);
@@ -795,6 +813,42 @@ t_ctx0::get_expression_tables() const {
     return m_expression_tables;
 }
 
+t_ctx_memory_usage
+t_ctx0::get_memory_usage() const {
+    t_ctx_memory_usage rv;
+
+    if (m_traversal) {
+        rv.m_traversal_bytes = m_traversal->nbytes();
+    }
+
+    if (m_expression_tables) {
+        rv.m_expression_bytes = m_expression_tables->nbytes();
+    }
+
+    if (m_deltas) {
+        rv.m_delta_bytes = ordered_container_nbytes(*m_deltas);
+    }
+
+    rv.m_delta_bytes += hash_container_nbytes(m_delta_pkeys);
+    return rv;
+}
+
+t_transitional_needs
+t_ctx0::get_transitional_needs() const {
+    t_transitional_needs needs;
+
+    // `notify` only reads `existed`, except to filter rows on `prev` and
+    // `current`.
+    for (const auto& fterm : m_config.get_fterms()) {
+        needs.require(
+            fterm.m_colname,
+            TRANSITIONAL_TABLE_PREV | TRANSITIONAL_TABLE_CURRENT
+        );
+    }
+
+    return needs;
+}
+
 void
 t_ctx0::read_column_from_gstate(
     const std::string& colname,
@@ -13,6 +13,8 @@
 #include <perspective/first.h>
 #include <perspective/data_slice.h>
 
+#include <algorithm>
+
 namespace perspective {
 
 template <typename CTX_T>
@@ -35,7 +37,9 @@ t_data_slice<CTX_T>::t_data_slice(
     m_row_offset(row_offset),
     m_col_offset(col_offset),
     m_slice(slice),
-    m_column_names(column_names) {
+    m_column_names(column_names),
+    m_is_snapshot(false),
+    m_snapshot_start_row(0) {
     m_stride = m_end_col - m_start_col;
 }
 
@@ -61,7 +65,9 @@ t_data_slice<CTX_T>::t_data_slice(
     m_col_offset(col_offset),
     m_slice(slice),
     m_column_names(column_names),
-    m_column_indices(column_indices) {
+    m_column_indices(column_indices),
+    m_is_snapshot(false),
+    m_snapshot_start_row(0) {
     m_stride = m_end_col - m_start_col;
 }
 
@@ -86,6 +92,15 @@ t_data_slice<CTX_T>::get(t_uindex ridx, t_uindex cidx) const {
 template <typename CTX_T>
 std::vector<t_tscalar>
 t_data_slice<CTX_T>::get_pkeys(t_uindex ridx, t_uindex cidx) const {
+    if (m_is_snapshot) {
+        t_uindex idx = ridx - m_snapshot_start_row;
+        if (ridx < m_snapshot_start_row || idx >= m_pkeys.size()) {
+            return {};
+        }
+
+        return m_pkeys[idx];
+    }
+
     std::pair<t_uindex, t_uindex> pair{ridx, cidx};
     std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
     return m_ctx->get_pkeys(vec);
@@ -109,9 +124,78 @@ t_data_slice<CTX_T>::get_column_slice(t_uindex cidx) const {
 template <typename CTX_T>
 std::vector<t_tscalar>
 t_data_slice<CTX_T>::get_row_path(t_uindex ridx) const {
+    if (m_is_snapshot) {
+        t_uindex idx = ridx - m_snapshot_start_row;
+        if (ridx < m_snapshot_start_row || idx >= m_row_paths.size()) {
+            return {};
+        }
+
+        return m_row_paths[idx];
+    }
+
     return m_ctx->unity_get_row_path(ridx);
 }
 
+template <typename CTX_T>
+t_uindex
+t_data_slice<CTX_T>::get_row_depth(t_uindex ridx) const {
+    if (m_is_snapshot) {
+        t_uindex idx = ridx - m_snapshot_start_row;
+        if (ridx < m_snapshot_start_row || idx >= m_row_depths.size()) {
+            return 0;
+        }
+
+        return m_row_depths[idx];
+    }
+
+    return m_ctx->unity_get_row_depth(ridx);
+}
+
+template <typename CTX_T>
+void
+t_data_slice<CTX_T>::snapshot(
+    t_uindex start_row, t_uindex end_row, bool with_row_paths, bool with_pkeys
+) {
+    m_snapshot_extents = get_data_extents();
+    m_snapshot_start_row = start_row;
+    end_row = std::min(end_row, static_cast<t_uindex>(m_ctx->get_row_count()));
+    t_uindex nrows = end_row > start_row ? end_row - start_row : 0;
+
+    if (with_row_paths) {
+        m_row_paths.resize(nrows);
+        m_row_depths.resize(nrows);
+        for (t_uindex idx = 0; idx < nrows; ++idx) {
+            m_row_depths[idx] = m_ctx->unity_get_row_depth(start_row + idx);
+            m_row_paths[idx] = m_ctx->unity_get_row_path(start_row + idx);
+            for (auto& scalar : m_row_paths[idx]) {
+                own_string(scalar);
+            }
+        }
+    }
+
+    if (with_pkeys) {
+        m_pkeys.resize(nrows);
+        for (t_uindex idx = 0; idx < nrows; ++idx) {
+            m_pkeys[idx] = get_pkeys(start_row + idx, 0);
+            for (auto& scalar : m_pkeys[idx]) {
+                own_string(scalar);
+            }
+        }
+    }
+
+    for (auto& scalar : m_slice) {
+        own_string(scalar);
+    }
+
+    for (auto& path : m_column_names) {
+        for (auto& scalar : path) {
+            own_string(scalar);
+        }
+    }
+
+    m_is_snapshot = true;
+}
+
 template <typename CTX_T>
 t_uindex
 t_data_slice<CTX_T>::num_rows() const {
@@ -177,6 +261,10 @@ t_data_slice<CTX_T>::get_col_offset() const {
 template <typename CTX_T>
 t_get_data_extents
 t_data_slice<CTX_T>::get_data_extents() const {
+    if (m_is_snapshot) {
+        return m_snapshot_extents;
+    }
+
     auto nrows = m_ctx->get_row_count();
     auto ncols = m_ctx->get_column_count();
     t_get_data_extents ext = sanitize_get_data_extents(
@@ -193,6 +281,19 @@ t_data_slice<CTX_T>::get_slice_idx(t_uindex ridx, t_uindex cidx) const {
     return idx;
 }
 
+template <typename CTX_T>
+void
+t_data_slice<CTX_T>::own_string(t_tscalar& scalar) {
+    if (scalar.get_dtype() != DTYPE_STR || scalar.m_inplace
+        || !scalar.is_valid() || scalar.m_data.m_charptr == nullptr) {
+        return;
+    }
+
+    // `std::deque` never moves its elements, so the pointer stays valid.
+    m_strings.emplace_back(scalar.m_data.m_charptr);
+    scalar.m_data.m_charptr = m_strings.back().c_str();
+}
+
 // Explicitly instantiate data slice for each context
 template class t_data_slice<t_ctxunit>;
 template class t_data_slice<t_ctx0>;
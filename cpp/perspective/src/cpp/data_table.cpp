@@ -19,7 +19,10 @@
 #include <perspective/scalar.h>
 #include <perspective/tracing.h>
 #include <perspective/utils.h>
+#include <perspective/parallel_for.h>
+#include <perspective/env_vars.h>
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 namespace perspective {
@@ -134,9 +137,22 @@ std::shared_ptr<t_column>
 t_data_table::make_column(
     const std::string& colname, t_dtype dtype, bool status_enabled
 ) {
+    std::string store_name = m_name + std::string("_") + colname;
+
+    // Disk backed stores are named after their column, so keep the column
+    // name from reaching outside of `m_dirname`.
+    if (m_backing_store == BACKING_STORE_DISK) {
+        std::replace_if(
+            store_name.begin(),
+            store_name.end(),
+            [](char c) { return c == '/' || c == '\\'; },
+            '_'
+        );
+    }
+
     t_lstore_recipe a(
         m_dirname,
-        m_name + std::string("_") + colname,
+        store_name,
         m_capacity * get_dtype_size(dtype),
         m_backing_store
     );
@@ -164,6 +180,26 @@ t_data_table::size() const {
     return num_rows();
 }
 
+t_uindex
+t_data_table::column_nbytes() const {
+    t_uindex rv = 0;
+    for (const auto& column : m_columns) {
+        rv += column->nbytes();
+    }
+
+    return rv;
+}
+
+t_uindex
+t_data_table::nbytes() const {
+    t_uindex rv = 0;
+    for (const auto& column : m_columns) {
+        rv += column->nbytes() + column->vocab_nbytes();
+    }
+
+    return rv;
+}
+
 t_dtype
 t_data_table::get_dtype(const std::string& colname) const {
     PSP_TRACE_SENTINEL();
@@ -303,6 +339,17 @@ t_data_table::reserve(t_uindex capacity) {
     set_capacity(std::max(capacity, m_capacity));
 }
 
+void
+t_data_table::shrink(t_uindex capacity) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    capacity = std::max(capacity, m_size);
+    for (t_uindex idx = 0, loop_end = m_schema.size(); idx < loop_end; ++idx) {
+        m_columns[idx]->shrink(capacity);
+    }
+    set_capacity(capacity);
+}
+
 t_column*
 t_data_table::_get_column(std::string_view colname) {
     PSP_TRACE_SENTINEL();
@@ -331,6 +378,29 @@ t_data_table::flatten() const {
     return flattened;
 }
 
+void
+t_data_table::flatten(const std::shared_ptr<t_data_table>& flattened) const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(is_pkey_table(), "Not a pkeyed table");
+    PSP_VERBOSE_ASSERT(flattened->size() == 0, "Flatten target is not empty");
+
+    // `flatten_body` leaves the values of removed rows, and of columns with
+    // no value for a key, as they are in newly reserved storage - zeroed and
+    // invalid - so reset the rows it may write to before reusing them.
+    flattened->reserve(size());
+    flattened->set_size(size());
+    for (const auto& column : flattened->m_columns) {
+        column->raw_fill<std::uint8_t>(0);
+        if (column->is_status_enabled()) {
+            column->invalid_raw_fill();
+        }
+    }
+
+    flattened->set_size(0);
+    flatten_body<std::shared_ptr<t_data_table>>(flattened);
+}
+
 bool
 t_data_table::is_pkey_table() const {
     PSP_TRACE_SENTINEL();
@@ -475,6 +545,71 @@ t_data_table::clear() {
     m_size = 0;
 }
 
+void
+t_data_table::clear_with_vocabularies() {
+    clear();
+    for (const auto& column : m_columns) {
+        column->reset_vocabulary();
+    }
+}
+
+// Set the rows of `mask` that pass `fterm` from the inverted index of its
+// string column, returning false if the term cannot be answered this way.
+// Expects the threshold of an interned term to have been interned already.
+static bool
+filter_indexed(const t_fterm& fterm, const t_column* column, t_mask& mask) {
+    if (!column->is_indexed()) {
+        return false;
+    }
+
+    std::vector<t_uindex> keys;
+    bool nulls = false;
+    bool complement = fterm.m_negated;
+
+    switch (fterm.m_op) {
+        case FILTER_OP_EQ:
+        case FILTER_OP_NE: {
+            if (!fterm.m_use_interned) {
+                return false;
+            }
+
+            keys.push_back(fterm.m_threshold.get<t_uindex>());
+            complement ^= fterm.m_op == FILTER_OP_NE;
+        } break;
+        case FILTER_OP_IN:
+        case FILTER_OP_NOT_IN: {
+            // Rows only equal valid strings, so nulls pass `NOT_IN`.
+            for (const auto& v : fterm.m_bag) {
+                if (v.get_dtype() != DTYPE_STR || !v.is_valid()) {
+                    return false;
+                }
+
+                t_uindex interned;
+                if (column->string_exists(v.get_char_ptr(), interned)) {
+                    keys.push_back(interned);
+                }
+            }
+
+            complement ^= fterm.m_op == FILTER_OP_NOT_IN;
+        } break;
+        case FILTER_OP_IS_NULL:
+        case FILTER_OP_IS_NOT_NULL: {
+            nulls = true;
+            complement ^= fterm.m_op == FILTER_OP_IS_NOT_NULL;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+
+    column->select_indexed(keys, nulls, mask);
+    if (complement) {
+        mask.flip();
+    }
+
+    return true;
+}
+
 t_mask
 t_data_table::filter_cpp(
     t_filter_op combiner, const std::vector<t_fterm>& fterms_
@@ -499,57 +634,156 @@ t_data_table::filter_cpp(
         }
     }
 
-    switch (combiner) {
-        case FILTER_OP_AND: {
-            t_tscalar cell_val;
+    // Terms answered by the inverted index of their column are combined
+    // into `indexed`, and skipped by the row by row evaluation below.
+    std::vector<bool> use_index(fterm_size, false);
+    t_uindex nindexed = 0;
+    t_mask indexed;
+
+    for (t_uindex idx = 0; idx < fterm_size; ++idx) {
+        if (!columns[idx]->is_indexed()) {
+            continue;
+        }
+
+        t_mask term_mask(size());
+        if (!filter_indexed(fterms[idx], columns[idx], term_mask)) {
+            continue;
+        }
 
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end;
-                 ++ridx) {
-                bool pass = true;
+        use_index[idx] = true;
+        if (nindexed++ == 0) {
+            indexed = term_mask;
+        } else if (combiner == FILTER_OP_AND) {
+            indexed &= term_mask;
+        } else {
+            indexed |= term_mask;
+        }
+    }
 
+    if (nindexed > 0 && nindexed == fterm_size
+        && (combiner == FILTER_OP_AND || combiner == FILTER_OP_OR)) {
+        return indexed;
+    }
+
+    // Zone maps of the filtered columns, empty for columns without one or
+    // when the table fits in a single chunk and there is nothing to skip.
+    t_uindex chunk_size = DEFAULT_ZONE_MAP_CHUNK_SIZE;
+    std::vector<std::vector<t_zone>> zones(fterm_size);
+    if (size() > chunk_size && !t_env::disable_zone_maps()) {
+        for (t_uindex idx = 0; idx < fterm_size; ++idx) {
+            if (!use_index[idx]) {
+                zones[idx] = columns[idx]->get_zone_map();
+            }
+        }
+    }
+
+    // Whether term `cidx` may pass a row in the chunk starting at `bidx`.
+    auto may_match = [&](t_uindex cidx, t_uindex bidx) {
+        return zones[cidx].empty()
+            || fterms[cidx].may_match(zones[cidx][bidx / chunk_size]);
+    };
+
+    std::vector<t_uindex> candidates;
+    candidates.reserve(fterm_size);
+
+    for (t_uindex bidx = 0, loop_end = size(); bidx < loop_end;
+         bidx += chunk_size) {
+        t_uindex eidx = std::min(bidx + chunk_size, loop_end);
+
+        // Rows of skipped chunks are left unset in the mask.
+        switch (combiner) {
+            case FILTER_OP_AND: {
+                bool skip = false;
                 for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    if (!pass) {
+                    if (!may_match(cidx, bidx)) {
+                        skip = true;
                         break;
                     }
+                }
 
-                    const auto& ft = fterms[cidx];
-                    bool tval;
+                if (skip) {
+                    continue;
+                }
+
+                t_tscalar cell_val;
 
-                    if (ft.m_use_interned) {
-                        cell_val.set(*(columns[cidx]->get_nth<t_uindex>(ridx)));
-                        cell_val.set_status(*(columns[cidx]->get_nth_status(ridx
-                        )));
-                    } else {
-                        cell_val = columns[cidx]->get_scalar(ridx);
+                for (t_uindex ridx = bidx; ridx < eidx; ++ridx) {
+                    if (nindexed > 0 && !indexed.get(ridx)) {
+                        continue;
                     }
 
-                    tval = ft(cell_val);
-                    if (!tval) {
-                        pass = false;
-                        break;
+                    bool pass = true;
+
+                    for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
+                        if (!pass) {
+                            break;
+                        }
+
+                        if (use_index[cidx]) {
+                            continue;
+                        }
+
+                        const auto& ft = fterms[cidx];
+                        bool tval;
+
+                        if (ft.m_use_interned) {
+                            cell_val.set(
+                                *(columns[cidx]->get_nth<t_uindex>(ridx))
+                            );
+                            cell_val.set_status(
+                                *(columns[cidx]->get_nth_status(ridx))
+                            );
+                        } else {
+                            cell_val = columns[cidx]->get_scalar(ridx);
+                        }
+
+                        tval = ft(cell_val);
+                        if (!tval) {
+                            pass = false;
+                            break;
+                        }
                     }
-                }
 
-                mask.set(ridx, pass);
-            }
-        } break;
-        case FILTER_OP_OR: {
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end;
-                 ++ridx) {
-                bool pass = false;
+                    mask.set(ridx, pass);
+                }
+            } break;
+            case FILTER_OP_OR: {
+                // Only terms that may pass a row of the chunk are evaluated.
+                candidates.clear();
                 for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    t_tscalar cell_val = columns[cidx]->get_scalar(ridx);
-                    if (fterms[cidx](cell_val)) {
-                        pass = true;
-                        break;
+                    if (!use_index[cidx] && may_match(cidx, bidx)) {
+                        candidates.push_back(cidx);
                     }
                 }
-                mask.set(ridx, pass);
-            }
-        } break;
-        default: {
-            PSP_COMPLAIN_AND_ABORT("Unknown filter op");
-        } break;
+
+                if (candidates.empty()) {
+                    continue;
+                }
+
+                for (t_uindex ridx = bidx; ridx < eidx; ++ridx) {
+                    if (nindexed > 0 && indexed.get(ridx)) {
+                        continue;
+                    }
+
+                    bool pass = false;
+                    for (t_uindex cidx : candidates) {
+                        t_tscalar cell_val = columns[cidx]->get_scalar(ridx);
+                        if (fterms[cidx](cell_val)) {
+                            pass = true;
+                            break;
+                        }
+                    }
+                    mask.set(ridx, pass);
+                }
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unknown filter op");
+            } break;
+        }
+    }
+
+    if (nindexed > 0 && combiner == FILTER_OP_OR) {
+        mask |= indexed;
     }
 
     return mask;
@@ -601,6 +835,22 @@ t_data_table::clone() const {
     return rval;
 }
 
+void
+t_data_table::move_rows(
+    const std::vector<std::pair<t_uindex, t_uindex>>& moves
+) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    if (moves.empty()) {
+        return;
+    }
+
+    parallel_for(int(m_columns.size()), [this, &moves](int cidx) {
+        m_columns[cidx]->move_rows(moves);
+    });
+}
+
 std::shared_ptr<t_data_table>
 t_data_table::borrow(const std::vector<std::string>& columns) const {
     PSP_TRACE_SENTINEL();
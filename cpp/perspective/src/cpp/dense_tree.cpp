@@ -349,7 +349,7 @@ t_dtree::pivot(const t_filter& filter, t_uindex level) {
                     );
                 } break;
                 case DTYPE_TIME: {
-                    next_neidx = t_pivot_processor<DTYPE_INT64>()(
+                    next_neidx = t_pivot_processor<DTYPE_TIME>()(
                         pivcol,
                         &m_nodes,
                         &(m_values[pidx]),
@@ -360,7 +360,7 @@ t_dtree::pivot(const t_filter& filter, t_uindex level) {
                     );
                 } break;
                 case DTYPE_DATE: {
-                    next_neidx = t_pivot_processor<DTYPE_UINT32>()(
+                    next_neidx = t_pivot_processor<DTYPE_DATE>()(
                         pivcol,
                         &m_nodes,
                         &(m_values[pidx]),
@@ -0,0 +1,795 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/expression_kernel.h>
+#include <perspective/env_vars.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace perspective {
+
+// Number of rows evaluated per pass over the plan - small enough that every
+// node's lanes stay in cache, large enough to amortize the dispatch.
+static const t_uindex KERNEL_CHUNK_SIZE = 1024;
+
+/**
+ * @brief A recursive-descent parser over the subset of ExprTk syntax that
+ * `t_expression_kernel` supports. Operator precedence follows ExprTk:
+ * `or` < `and` < comparisons < `+ -` < `* / %` < unary minus.
+ */
+class t_expression_kernel_parser {
+public:
+    t_expression_kernel_parser(
+        const std::string& expression,
+        const std::vector<std::pair<std::string, std::string>>& column_ids,
+        t_expression_kernel& kernel
+    ) :
+        m_expression(expression),
+        m_column_ids(column_ids),
+        m_kernel(kernel),
+        m_pos(0) {}
+
+    bool
+    parse() {
+        t_index root = parse_or();
+        skip_whitespace();
+        return root >= 0 && m_pos == m_expression.size();
+    }
+
+private:
+    void
+    skip_whitespace() {
+        while (m_pos < m_expression.size()
+               && std::isspace(
+                   static_cast<unsigned char>(m_expression[m_pos])
+               )) {
+            ++m_pos;
+        }
+    }
+
+    bool
+    consume(const char* token) {
+        skip_whitespace();
+        auto len = std::strlen(token);
+        if (m_expression.compare(m_pos, len, token) != 0) {
+            return false;
+        }
+
+        m_pos += len;
+        return true;
+    }
+
+    static bool
+    is_ident_char(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    }
+
+    // Peek at the identifier at the cursor without consuming it.
+    std::string
+    peek_identifier() {
+        skip_whitespace();
+        t_uindex end = m_pos;
+        if (end < m_expression.size()
+            && (std::isalpha(static_cast<unsigned char>(m_expression[end]))
+                || m_expression[end] == '_')) {
+            while (end < m_expression.size() && is_ident_char(m_expression[end]
+                   )) {
+                ++end;
+            }
+        }
+
+        std::string ident = m_expression.substr(m_pos, end - m_pos);
+        for (auto& c : ident) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        return ident;
+    }
+
+    bool
+    consume_keyword(const char* keyword) {
+        if (peek_identifier() != keyword) {
+            return false;
+        }
+
+        m_pos += std::strlen(keyword);
+        return true;
+    }
+
+    t_index
+    push(
+        t_expression_kernel_op op,
+        t_index arg0 = -1,
+        t_index arg1 = -1,
+        t_index arg2 = -1
+    ) {
+        t_expression_kernel_node node{};
+        node.m_op = op;
+        node.m_args[0] = arg0;
+        node.m_args[1] = arg1;
+        node.m_args[2] = arg2;
+        m_kernel.m_nodes.push_back(node);
+        return static_cast<t_index>(m_kernel.m_nodes.size() - 1);
+    }
+
+    t_index
+    parse_or() {
+        t_index lhs = parse_and();
+        while (lhs >= 0 && consume_keyword("or")) {
+            t_index rhs = parse_and();
+            lhs = rhs < 0 ? -1 : push(KERNEL_OP_OR, lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    t_index
+    parse_and() {
+        t_index lhs = parse_comparison();
+        while (lhs >= 0 && consume_keyword("and")) {
+            t_index rhs = parse_comparison();
+            lhs = rhs < 0 ? -1 : push(KERNEL_OP_AND, lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    t_index
+    parse_comparison() {
+        t_index lhs = parse_additive();
+        while (lhs >= 0) {
+            t_expression_kernel_op op;
+
+            // Longest tokens first so `<=` is not read as `<`.
+            if (consume("<=")) {
+                op = KERNEL_OP_LTE;
+            } else if (consume(">=")) {
+                op = KERNEL_OP_GTE;
+            } else if (consume("==")) {
+                op = KERNEL_OP_EQ;
+            } else if (consume("!=") || consume("<>")) {
+                op = KERNEL_OP_NE;
+            } else if (consume("<")) {
+                op = KERNEL_OP_LT;
+            } else if (consume(">")) {
+                op = KERNEL_OP_GT;
+            } else if (consume("=")) {
+                op = KERNEL_OP_EQ;
+            } else {
+                break;
+            }
+
+            t_index rhs = parse_additive();
+            lhs = rhs < 0 ? -1 : push(op, lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    t_index
+    parse_additive() {
+        t_index lhs = parse_multiplicative();
+        while (lhs >= 0) {
+            t_expression_kernel_op op;
+            if (consume("+")) {
+                op = KERNEL_OP_ADD;
+            } else if (consume("-")) {
+                op = KERNEL_OP_SUB;
+            } else {
+                break;
+            }
+
+            t_index rhs = parse_multiplicative();
+            lhs = rhs < 0 ? -1 : push(op, lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    t_index
+    parse_multiplicative() {
+        t_index lhs = parse_unary();
+        while (lhs >= 0) {
+            t_expression_kernel_op op;
+            if (consume("*")) {
+                op = KERNEL_OP_MUL;
+            } else if (consume("/")) {
+                op = KERNEL_OP_DIV;
+            } else if (consume("%")) {
+                op = KERNEL_OP_MOD;
+            } else {
+                break;
+            }
+
+            t_index rhs = parse_unary();
+            lhs = rhs < 0 ? -1 : push(op, lhs, rhs);
+        }
+
+        return lhs;
+    }
+
+    t_index
+    parse_unary() {
+        if (consume("-")) {
+            t_index arg = parse_unary();
+            if (arg < 0) {
+                return -1;
+            }
+
+            // ExprTk folds negated literals into a single float constant.
+            auto& node = m_kernel.m_nodes[arg];
+            if (node.m_op == KERNEL_OP_LITERAL) {
+                node.m_literal = -node.m_literal;
+                return arg;
+            }
+
+            return push(KERNEL_OP_NEG, arg);
+        }
+
+        return parse_primary();
+    }
+
+    t_index
+    parse_primary() {
+        skip_whitespace();
+        if (m_pos >= m_expression.size()) {
+            return -1;
+        }
+
+        char c = m_expression[m_pos];
+
+        if (c == '(') {
+            ++m_pos;
+            t_index inner = parse_or();
+            if (inner < 0 || !consume(")")) {
+                return -1;
+            }
+
+            return inner;
+        }
+
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            return parse_number();
+        }
+
+        std::string ident = peek_identifier();
+        if (ident.empty()) {
+            return -1;
+        }
+
+        if (ident == "if") {
+            m_pos += ident.size();
+            if (!consume("(")) {
+                return -1;
+            }
+
+            t_index cond = parse_or();
+            if (cond < 0 || !consume(",")) {
+                return -1;
+            }
+
+            t_index consequent = parse_or();
+            if (consequent < 0 || !consume(",")) {
+                return -1;
+            }
+
+            t_index alternative = parse_or();
+            if (alternative < 0 || !consume(")")) {
+                return -1;
+            }
+
+            return push(KERNEL_OP_IF, cond, consequent, alternative);
+        }
+
+        // Anything else must be one of the input columns - function calls,
+        // constants and variables are left to ExprTk.
+        std::string raw_ident = m_expression.substr(m_pos, ident.size());
+        for (t_uindex cidx = 0; cidx < m_column_ids.size(); ++cidx) {
+            if (m_column_ids[cidx].first == raw_ident) {
+                m_pos += ident.size();
+                t_index idx = push(KERNEL_OP_COLUMN);
+                m_kernel.m_nodes[idx].m_column_idx = cidx;
+                return idx;
+            }
+        }
+
+        return -1;
+    }
+
+    t_index
+    parse_number() {
+        t_uindex start = m_pos;
+        t_uindex end = m_pos;
+        bool has_digits = false;
+
+        while (end < m_expression.size()
+               && std::isdigit(static_cast<unsigned char>(m_expression[end]))) {
+            ++end;
+            has_digits = true;
+        }
+
+        if (end < m_expression.size() && m_expression[end] == '.') {
+            ++end;
+            while (end < m_expression.size()
+                   && std::isdigit(
+                       static_cast<unsigned char>(m_expression[end])
+                   )) {
+                ++end;
+                has_digits = true;
+            }
+        }
+
+        if (!has_digits) {
+            return -1;
+        }
+
+        if (end < m_expression.size()
+            && (m_expression[end] == 'e' || m_expression[end] == 'E')) {
+            t_uindex exp = end + 1;
+            if (exp < m_expression.size()
+                && (m_expression[exp] == '+' || m_expression[exp] == '-')) {
+                ++exp;
+            }
+
+            if (exp >= m_expression.size()
+                || !std::isdigit(static_cast<unsigned char>(m_expression[exp])
+                )) {
+                return -1;
+            }
+
+            while (exp < m_expression.size()
+                   && std::isdigit(
+                       static_cast<unsigned char>(m_expression[exp])
+                   )) {
+                ++exp;
+            }
+
+            end = exp;
+        }
+
+        // Reject implicit multiplication such as `2COLUMN0`.
+        if (end < m_expression.size() && is_ident_char(m_expression[end])) {
+            return -1;
+        }
+
+        std::string token = m_expression.substr(start, end - start);
+        m_pos = end;
+
+        t_index idx = push(KERNEL_OP_LITERAL);
+        m_kernel.m_nodes[idx].m_literal = std::strtod(token.c_str(), nullptr);
+        return idx;
+    }
+
+    const std::string& m_expression;
+    const std::vector<std::pair<std::string, std::string>>& m_column_ids;
+    t_expression_kernel& m_kernel;
+    t_uindex m_pos;
+};
+
+std::shared_ptr<t_expression_kernel>
+t_expression_kernel::compile(
+    const std::string& parsed_expression_string,
+    const std::vector<std::pair<std::string, std::string>>& column_ids
+) {
+    if (t_env::disable_expression_kernel()) {
+        return nullptr;
+    }
+
+    auto kernel = std::make_shared<t_expression_kernel>();
+    t_expression_kernel_parser parser(
+        parsed_expression_string, column_ids, *kernel
+    );
+
+    if (!parser.parse()) {
+        return nullptr;
+    }
+
+    // A bare literal has nothing to vectorize.
+    if (kernel->m_nodes.size() == 1
+        && kernel->m_nodes[0].m_op == KERNEL_OP_LITERAL) {
+        return nullptr;
+    }
+
+    return kernel;
+}
+
+t_uindex
+t_expression_kernel::size() const {
+    return m_nodes.size();
+}
+
+bool
+t_expression_kernel::infer_dtypes(
+    const std::vector<std::shared_ptr<t_column>>& inputs,
+    std::vector<t_dtype>& dtypes
+) const {
+    dtypes.resize(m_nodes.size());
+
+    for (t_uindex nidx = 0; nidx < m_nodes.size(); ++nidx) {
+        const auto& node = m_nodes[nidx];
+        switch (node.m_op) {
+            case KERNEL_OP_LITERAL: {
+                dtypes[nidx] = DTYPE_FLOAT64;
+            } break;
+            case KERNEL_OP_COLUMN: {
+                if (node.m_column_idx >= inputs.size()
+                    || inputs[node.m_column_idx] == nullptr) {
+                    return false;
+                }
+
+                t_dtype dtype = inputs[node.m_column_idx]->get_dtype();
+                if (!is_numeric_type(dtype)) {
+                    return false;
+                }
+
+                dtypes[nidx] = dtype;
+            } break;
+            case KERNEL_OP_NEG: {
+                // `t_tscalar::operator-()` preserves the input type, which
+                // wraps for unsigned types.
+                t_dtype dtype = dtypes[node.m_args[0]];
+                if (!is_numeric_type(dtype)
+                    || (!is_floating_point(dtype) && dtype != DTYPE_INT64
+                        && dtype != DTYPE_INT32 && dtype != DTYPE_INT16
+                        && dtype != DTYPE_INT8)) {
+                    return false;
+                }
+
+                dtypes[nidx] = dtype;
+            } break;
+            case KERNEL_OP_ADD:
+            case KERNEL_OP_SUB:
+            case KERNEL_OP_MUL:
+            case KERNEL_OP_DIV:
+            case KERNEL_OP_MOD: {
+                if (!is_numeric_type(dtypes[node.m_args[0]])
+                    || !is_numeric_type(dtypes[node.m_args[1]])) {
+                    return false;
+                }
+
+                dtypes[nidx] = DTYPE_FLOAT64;
+            } break;
+            case KERNEL_OP_LT:
+            case KERNEL_OP_LTE:
+            case KERNEL_OP_GT:
+            case KERNEL_OP_GTE:
+            case KERNEL_OP_EQ:
+            case KERNEL_OP_NE: {
+                // `t_tscalar` comparisons order by dtype before value, so
+                // only float/float comparisons are value comparisons.
+                if (dtypes[node.m_args[0]] != DTYPE_FLOAT64
+                    || dtypes[node.m_args[1]] != DTYPE_FLOAT64) {
+                    return false;
+                }
+
+                dtypes[nidx] = DTYPE_BOOL;
+            } break;
+            case KERNEL_OP_AND:
+            case KERNEL_OP_OR: {
+                dtypes[nidx] = DTYPE_BOOL;
+            } break;
+            case KERNEL_OP_IF: {
+                // ExprTk tests the condition with `!= mktscalar(false)`,
+                // which only agrees with a numeric truth test for bools.
+                t_dtype consequent = dtypes[node.m_args[1]];
+                t_dtype alternative = dtypes[node.m_args[2]];
+                if (dtypes[node.m_args[0]] != DTYPE_BOOL
+                    || consequent != alternative) {
+                    return false;
+                }
+
+                dtypes[nidx] = consequent;
+            } break;
+        }
+    }
+
+    return true;
+}
+
+namespace {
+
+    template <typename T>
+    void
+    load_column_chunk(
+        const t_column& column,
+        t_uindex bidx,
+        t_uindex count,
+        double* __restrict values,
+        std::uint8_t* __restrict valid
+    ) {
+        const T* __restrict data = column.get_nth<T>(bidx);
+        for (t_uindex i = 0; i < count; ++i) {
+            values[i] = static_cast<double>(data[i]);
+        }
+
+        if (column.is_status_enabled()) {
+            const t_status* __restrict status = column.get_nth_status(bidx);
+            for (t_uindex i = 0; i < count; ++i) {
+                valid[i] = status[i] == STATUS_VALID;
+            }
+        } else {
+            std::memset(valid, 1, count);
+        }
+    }
+
+    void
+    load_column_chunk(
+        const t_column& column,
+        t_uindex bidx,
+        t_uindex count,
+        double* values,
+        std::uint8_t* valid
+    ) {
+        switch (column.get_dtype()) {
+            case DTYPE_INT64: {
+                load_column_chunk<std::int64_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_INT32: {
+                load_column_chunk<std::int32_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_INT16: {
+                load_column_chunk<std::int16_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_INT8: {
+                load_column_chunk<std::int8_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_UINT64: {
+                load_column_chunk<std::uint64_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_UINT32: {
+                load_column_chunk<std::uint32_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_UINT16: {
+                load_column_chunk<std::uint16_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_UINT8: {
+                load_column_chunk<std::uint8_t>(
+                    column, bidx, count, values, valid
+                );
+            } break;
+            case DTYPE_FLOAT64: {
+                load_column_chunk<double>(column, bidx, count, values, valid);
+            } break;
+            case DTYPE_FLOAT32: {
+                load_column_chunk<float>(column, bidx, count, values, valid);
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected dtype in expression kernel");
+            }
+        }
+    }
+
+    // `t_tscalar::operator==` compares the raw union bits of valid doubles.
+    inline bool
+    bitwise_equal(double a, double b) {
+        std::uint64_t x;
+        std::uint64_t y;
+        std::memcpy(&x, &a, sizeof(double));
+        std::memcpy(&y, &b, sizeof(double));
+        return x == y;
+    }
+
+} // namespace
+
+bool
+t_expression_kernel::compute(
+    const std::vector<std::shared_ptr<t_column>>& inputs,
+    t_uindex num_rows,
+    t_dtype output_dtype,
+    t_column& output,
+    std::vector<t_uindex>& fallback_rows
+) const {
+    std::vector<t_dtype> dtypes;
+    if (!infer_dtypes(inputs, dtypes)) {
+        return false;
+    }
+
+    if (dtypes.back() != output_dtype
+        || (output_dtype != DTYPE_FLOAT64 && output_dtype != DTYPE_BOOL)
+        || output.get_dtype() != output_dtype) {
+        return false;
+    }
+
+    const t_uindex num_nodes = m_nodes.size();
+    std::vector<double> values(num_nodes * KERNEL_CHUNK_SIZE);
+    std::vector<std::uint8_t> valid(num_nodes * KERNEL_CHUNK_SIZE);
+    std::vector<std::uint8_t> fallback(KERNEL_CHUNK_SIZE);
+
+    for (t_uindex bidx = 0; bidx < num_rows; bidx += KERNEL_CHUNK_SIZE) {
+        const t_uindex count = std::min(KERNEL_CHUNK_SIZE, num_rows - bidx);
+        std::memset(fallback.data(), 0, count);
+
+        for (t_uindex nidx = 0; nidx < num_nodes; ++nidx) {
+            const auto& node = m_nodes[nidx];
+            double* __restrict out = values.data() + nidx * KERNEL_CHUNK_SIZE;
+            std::uint8_t* __restrict out_valid =
+                valid.data() + nidx * KERNEL_CHUNK_SIZE;
+
+            const double* a = nullptr;
+            const std::uint8_t* a_valid = nullptr;
+            const double* b = nullptr;
+            const std::uint8_t* b_valid = nullptr;
+
+            if (node.m_args[0] >= 0) {
+                a = values.data() + node.m_args[0] * KERNEL_CHUNK_SIZE;
+                a_valid = valid.data() + node.m_args[0] * KERNEL_CHUNK_SIZE;
+            }
+
+            if (node.m_args[1] >= 0) {
+                b = values.data() + node.m_args[1] * KERNEL_CHUNK_SIZE;
+                b_valid = valid.data() + node.m_args[1] * KERNEL_CHUNK_SIZE;
+            }
+
+            switch (node.m_op) {
+                case KERNEL_OP_LITERAL: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = node.m_literal;
+                    }
+
+                    std::memset(out_valid, 1, count);
+                } break;
+                case KERNEL_OP_COLUMN: {
+                    load_column_chunk(
+                        *inputs[node.m_column_idx], bidx, count, out, out_valid
+                    );
+                } break;
+                case KERNEL_OP_NEG: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = -a[i];
+                        out_valid[i] = a_valid[i];
+                    }
+                } break;
+                case KERNEL_OP_ADD: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = a[i] + b[i];
+                        out_valid[i] = a_valid[i] & b_valid[i];
+                    }
+                } break;
+                case KERNEL_OP_SUB: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = a[i] - b[i];
+                        out_valid[i] = a_valid[i] & b_valid[i];
+                    }
+                } break;
+                case KERNEL_OP_MUL: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = a[i] * b[i];
+                        out_valid[i] = a_valid[i] & b_valid[i];
+                    }
+                } break;
+                case KERNEL_OP_DIV: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = a[i] / b[i];
+                        out_valid[i] =
+                            a_valid[i] & b_valid[i] & (b[i] != 0);
+                    }
+                } break;
+                case KERNEL_OP_MOD: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        out[i] = std::fmod(a[i], b[i]);
+                        out_valid[i] =
+                            a_valid[i] & b_valid[i] & (b[i] != 0);
+                    }
+                } break;
+                case KERNEL_OP_LT:
+                case KERNEL_OP_LTE:
+                case KERNEL_OP_GT:
+                case KERNEL_OP_GTE:
+                case KERNEL_OP_EQ:
+                case KERNEL_OP_NE: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        bool rval = false;
+                        switch (node.m_op) {
+                            case KERNEL_OP_LT:
+                                rval = a[i] < b[i];
+                                break;
+                            case KERNEL_OP_LTE:
+                                rval = a[i] <= b[i];
+                                break;
+                            case KERNEL_OP_GT:
+                                rval = a[i] > b[i];
+                                break;
+                            case KERNEL_OP_GTE:
+                                rval = a[i] >= b[i];
+                                break;
+                            case KERNEL_OP_EQ:
+                                rval = bitwise_equal(a[i], b[i]);
+                                break;
+                            default:
+                                rval = !bitwise_equal(a[i], b[i]);
+                                break;
+                        }
+
+                        out[i] = rval ? 1.0 : 0.0;
+                        out_valid[i] = 1;
+
+                        // Comparisons against null order by status in
+                        // `t_tscalar` - leave those rows to the interpreter.
+                        fallback[i] |= !(a_valid[i] & b_valid[i]);
+                    }
+                } break;
+                case KERNEL_OP_AND: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        bool lhs = a_valid[i] && a[i] != 0;
+                        bool rhs = b_valid[i] && b[i] != 0;
+                        out[i] = (lhs && rhs) ? 1.0 : 0.0;
+                        out_valid[i] = 1;
+                    }
+                } break;
+                case KERNEL_OP_OR: {
+                    for (t_uindex i = 0; i < count; ++i) {
+                        bool lhs = a_valid[i] && a[i] != 0;
+                        bool rhs = b_valid[i] && b[i] != 0;
+                        out[i] = (lhs || rhs) ? 1.0 : 0.0;
+                        out_valid[i] = 1;
+                    }
+                } break;
+                case KERNEL_OP_IF: {
+                    const double* c = values.data()
+                        + node.m_args[2] * KERNEL_CHUNK_SIZE;
+                    const std::uint8_t* c_valid =
+                        valid.data() + node.m_args[2] * KERNEL_CHUNK_SIZE;
+                    for (t_uindex i = 0; i < count; ++i) {
+                        bool cond = a_valid[i] && a[i] != 0;
+                        out[i] = cond ? b[i] : c[i];
+                        out_valid[i] = cond ? b_valid[i] : c_valid[i];
+                    }
+                } break;
+            }
+        }
+
+        const t_uindex root = num_nodes - 1;
+        const double* result = values.data() + root * KERNEL_CHUNK_SIZE;
+        const std::uint8_t* result_valid =
+            valid.data() + root * KERNEL_CHUNK_SIZE;
+
+        for (t_uindex i = 0; i < count; ++i) {
+            t_uindex ridx = bidx + i;
+            if (fallback[i]) {
+                fallback_rows.push_back(ridx);
+                continue;
+            }
+
+            if (!result_valid[i]) {
+                output.clear(ridx);
+                continue;
+            }
+
+            if (output_dtype == DTYPE_BOOL) {
+                output.set_nth<bool>(ridx, result[i] != 0);
+            } else {
+                output.set_nth<double>(ridx, result[i]);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // end namespace perspective
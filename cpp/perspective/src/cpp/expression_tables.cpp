@@ -58,6 +58,12 @@ t_expression_tables::get_table() const {
     return m_master.get();
 }
 
+t_uindex
+t_expression_tables::nbytes() const {
+    return m_master->nbytes() + m_flattened->nbytes() + m_prev->nbytes()
+        + m_current->nbytes() + m_delta->nbytes() + m_transitions->nbytes();
+}
+
 void
 t_expression_tables::set_flattened(
     const std::shared_ptr<t_data_table>& flattened
@@ -59,6 +59,16 @@ t_expression_vocab::pprint() const {
     }
 }
 
+t_uindex
+t_expression_vocab::nbytes() const {
+    t_uindex rv = 0;
+    for (const auto& vocab : m_vocabs) {
+        rv += vocab.nbytes();
+    }
+
+    return rv;
+}
+
 void
 t_expression_vocab::allocate_new_vocab() {
     t_vocab vocab;
@@ -60,6 +60,10 @@ extract_aggregate(
         case AGGTYPE_ANY:
         case AGGTYPE_DOMINANT:
         case AGGTYPE_MEDIAN:
+        case AGGTYPE_P25:
+        case AGGTYPE_P75:
+        case AGGTYPE_P90:
+        case AGGTYPE_P99:
         case AGGTYPE_FIRST:
         case AGGTYPE_AND:
         case AGGTYPE_OR:
@@ -81,7 +85,17 @@ extract_aggregate(
         case AGGTYPE_DISTINCT_COUNT:
         case AGGTYPE_DISTINCT_LEAF:
         case AGGTYPE_VARIANCE:
-        case AGGTYPE_STANDARD_DEVIATION: {
+        case AGGTYPE_STANDARD_DEVIATION:
+        case AGGTYPE_APPROX_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_MEDIAN:
+        case AGGTYPE_APPROX_P90:
+        case AGGTYPE_APPROX_P99:
+        case AGGTYPE_ROLLING_SUM:
+        case AGGTYPE_ROLLING_COUNT:
+        case AGGTYPE_ROLLING_MEAN:
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN:
+        case AGGTYPE_ROLLING_MIN:
+        case AGGTYPE_ROLLING_MAX: {
             t_tscalar rval = aggcol->get_scalar(ridx);
             return rval;
         } break;
@@ -12,6 +12,7 @@
 
 #include <perspective/first.h>
 #include <perspective/filter.h>
+#include <perspective/column.h>
 
 #include <utility>
 
@@ -61,6 +62,92 @@ t_fterm::coerce_numeric(t_dtype dtype) {
     }
 }
 
+// Whether comparing `threshold` to the bounds of `zone` gives the result
+// `t_tscalar::cmp` would give for each row: it must be a valid value of the
+// same type, as null and NaN thresholds compare equal to rows bit for bit
+// and other types compare by dtype. Chunks without valid rows match no
+// valid threshold at all.
+static bool
+is_zone_comparable(const t_tscalar& threshold, const t_zone& zone) {
+    if (!threshold.is_valid() || threshold.is_nan()) {
+        return false;
+    }
+
+    if (zone.m_nnull == zone.m_nrows) {
+        return true;
+    }
+
+    return zone.m_min.is_valid()
+        && threshold.get_dtype() == zone.m_min.get_dtype();
+}
+
+// Whether `threshold` lies within the bounds of `zone`.
+static bool
+in_zone(const t_tscalar& threshold, const t_zone& zone) {
+    return zone.m_min.is_valid() && !(threshold < zone.m_min)
+        && !(zone.m_max < threshold);
+}
+
+bool
+t_fterm::may_match(const t_zone& zone) const {
+    if (m_negated) {
+        return true;
+    }
+
+    switch (m_op) {
+        case FILTER_OP_IS_NULL: {
+            return zone.m_nnull > 0;
+        } break;
+        case FILTER_OP_IS_NOT_NULL: {
+            return zone.m_nnull < zone.m_nrows;
+        } break;
+        case FILTER_OP_IN: {
+            for (const auto& v : m_bag) {
+                if (!is_zone_comparable(v, zone) || in_zone(v, zone)) {
+                    return true;
+                }
+            }
+
+            return false;
+        } break;
+        case FILTER_OP_LT:
+        case FILTER_OP_LTEQ:
+        case FILTER_OP_GT:
+        case FILTER_OP_GTEQ:
+        case FILTER_OP_EQ: {
+            if (!is_zone_comparable(m_threshold, zone)) {
+                return true;
+            }
+        } break;
+        default: {
+            return true;
+        } break;
+    }
+
+    // Only valid values pass a comparison with a valid threshold.
+    if (zone.m_nnull == zone.m_nrows) {
+        return false;
+    }
+
+    switch (m_op) {
+        case FILTER_OP_LT: {
+            return zone.m_min < m_threshold;
+        } break;
+        case FILTER_OP_LTEQ: {
+            return !(m_threshold < zone.m_min);
+        } break;
+        case FILTER_OP_GT: {
+            return zone.m_max > m_threshold;
+        } break;
+        case FILTER_OP_GTEQ: {
+            return !(zone.m_max < m_threshold);
+        } break;
+        default: {
+            return in_zone(m_threshold, zone);
+        } break;
+    }
+}
+
 std::string
 t_fterm::get_expr() const {
     std::stringstream ss;
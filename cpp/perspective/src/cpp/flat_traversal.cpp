@@ -13,7 +13,9 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/config.h>
+#include <perspective/env_vars.h>
 #include <perspective/flat_traversal.h>
+#include <perspective/memory_usage.h>
 #include <perspective/scalar.h>
 #include <perspective/schema.h>
 
@@ -189,6 +191,18 @@ t_ftrav::size() const {
     return m_index->size();
 }
 
+t_uindex
+t_ftrav::nbytes() const {
+    t_uindex rv = m_index->capacity() * sizeof(t_mselem);
+    for (const auto& elem : *m_index) {
+        rv += elem.m_row.capacity() * sizeof(t_tscalar);
+    }
+
+    rv += hash_container_nbytes(m_pkeyidx);
+    rv += hash_container_nbytes(m_new_elems);
+    return rv;
+}
+
 void
 t_ftrav::get_row_indices(
     const tsl::hopscotch_set<t_tscalar>& pkeys,
@@ -398,6 +412,31 @@ t_ftrav::empty_sort_by() const {
     return m_sortby.empty();
 }
 
+bool
+t_ftrav::sort_columns_changed(
+    const t_gstate& gstate, const t_config& config
+) const {
+    if (t_env::disable_column_subset_updates()) {
+        return true;
+    }
+
+    for (const t_sortspec& sort : m_sortby) {
+        std::string colname;
+
+        if (!sort.m_colname.empty()) {
+            colname = config.get_sort_by(sort.m_colname);
+        } else {
+            colname = config.col_at(sort.m_agg_index);
+        }
+
+        if (gstate.column_changed_by_last_update(config.get_sort_by(colname))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void
 t_ftrav::reset_step_state() {
     m_step_deletes = 0;
@@ -25,6 +25,8 @@
 #include <perspective/utils.h>
 #include <perspective/parallel_for.h>
 #include <perspective/pyutils.h>
+#include <tsl/hopscotch_map.h>
+#include <tsl/hopscotch_set.h>
 
 #include <utility>
 
@@ -48,7 +50,9 @@ calc_negate(t_tscalar val) {
     return val.negate();
 }
 
-t_gnode::t_gnode(t_schema input_schema, t_schema output_schema) :
+t_gnode::t_gnode(
+    t_schema input_schema, t_schema output_schema, t_storage_options storage
+) :
     m_mode(NODE_PROCESSING_SIMPLE_DATAFLOW)
 #ifdef PSP_PARALLEL_FOR
     ,
@@ -58,9 +62,11 @@ t_gnode::t_gnode(t_schema input_schema, t_schema output_schema) :
     m_gnode_type(GNODE_TYPE_PKEYED),
     m_input_schema(std::move(input_schema)),
     m_output_schema(std::move(output_schema)),
+    m_storage(std::move(storage)),
     m_init(false),
     m_id(0),
     m_last_input_port_id(0),
+    m_retention_ttl(0),
     m_pool_cleanup([]() {}) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_gnode");
@@ -97,7 +103,9 @@ void
 t_gnode::init() {
     PSP_TRACE_SENTINEL();
 
-    m_gstate = std::make_shared<t_gstate>(m_input_schema, m_output_schema);
+    m_gstate = std::make_shared<t_gstate>(
+        m_input_schema, m_output_schema, m_storage
+    );
     m_gstate->init();
 
     // Create and store the main input port, which is always port 0. The next
@@ -298,7 +306,27 @@ t_gnode::_process_table(t_uindex port_id) {
     }
 
     m_was_updated = true;
-    flattened = input_port->get_table()->flatten();
+
+    {
+        t_stage_timer timer(
+            m_trace, TRACE_STAGE_FLATTEN, input_port->get_table()->size()
+        );
+        std::shared_ptr<t_data_table> input_table = input_port->get_table();
+        flattened = _get_flatten_target(*input_table);
+
+        if (flattened != nullptr) {
+            input_table->flatten(flattened);
+        } else {
+            flattened = input_table->flatten();
+        }
+    }
+
+    // Columns that held no values in any pending update are neither copied
+    // into the master table nor reported as changed to contexts.
+    tsl::hopscotch_set<std::string> updated_columns =
+        input_port->get_updated_columns();
+    const tsl::hopscotch_set<std::string>* updated_columns_ptr =
+        t_env::disable_column_subset_updates() ? nullptr : &updated_columns;
 
     PSP_GNODE_VERIFY_TABLE(flattened);
     PSP_GNODE_VERIFY_TABLE(get_table());
@@ -308,18 +336,36 @@ t_gnode::_process_table(t_uindex port_id) {
     std::vector<t_rlookup> row_lookup(flattened_num_rows);
     t_column* pkey_col = flattened->get_column("psp_pkey").get();
 
-    for (t_uindex idx = 0; idx < flattened_num_rows; ++idx) {
-        // See if each primary key in flattened already exist in the dataset
-        t_tscalar pkey = pkey_col->get_scalar(idx);
-        row_lookup[idx] = m_gstate->lookup(pkey);
+    {
+        t_stage_timer timer(
+            m_trace, TRACE_STAGE_PKEY_LOOKUP, flattened_num_rows
+        );
+
+        for (t_uindex idx = 0; idx < flattened_num_rows; ++idx) {
+            // See if each primary key in flattened already exist in the
+            // dataset
+            t_tscalar pkey = pkey_col->get_scalar(idx);
+            row_lookup[idx] = m_gstate->lookup(pkey);
+        }
     }
 
     // first update - master table is empty
     if (m_gstate->mapping_size() == 0) {
-        m_gstate->update_master_table(flattened.get());
+        {
+            t_stage_timer timer(
+                m_trace, TRACE_STAGE_UPDATE_MASTER, flattened_num_rows
+            );
+            m_gstate->update_master_table(flattened.get());
+        }
+
         m_oports[PSP_PORT_FLATTENED]->set_table(flattened);
 
-        _compute_expressions(flattened);
+        {
+            t_stage_timer timer(
+                m_trace, TRACE_STAGE_COMPUTE_EXPRESSIONS, flattened_num_rows
+            );
+            _compute_expressions(flattened);
+        }
 
         // Update all contexts registered with the gnode with data.
         _update_contexts_from_state(flattened);
@@ -343,7 +389,7 @@ t_gnode::_process_table(t_uindex port_id) {
 
     _process_state.m_state_data_table = get_table_sptr();
     _process_state.m_flattened_data_table = flattened;
-    _process_state.m_lookup = row_lookup;
+    _process_state.m_lookup = std::move(row_lookup);
 
     // Get data tables for process state
     _process_state.m_delta_data_table = m_oports[PSP_PORT_DELTA]->get_table();
@@ -355,8 +401,19 @@ t_gnode::_process_table(t_uindex port_id) {
     _process_state.m_existed_data_table =
         m_oports[PSP_PORT_EXISTED]->get_table();
 
-    // Clear delta, prev, current, transitions, existed on EACH call.
-    _process_state.clear_transitional_data_tables();
+    t_stage_timer process_columns_timer(
+        m_trace, TRACE_STAGE_PROCESS_COLUMNS, flattened_num_rows
+    );
+
+    // Clear delta, prev, current, transitions, existed on EACH call, keeping
+    // their storage for the next update.
+    if (t_env::disable_table_recycling()) {
+        _process_state.clear_transitional_data_tables();
+    } else {
+        for (t_uindex idx = PSP_PORT_DELTA; idx <= PSP_PORT_EXISTED; ++idx) {
+            m_oports[idx]->recycle();
+        }
+    }
 
     // And re-reserved for the amount of data in `flattened`
     _process_state.reserve_transitional_data_tables(flattened_num_rows);
@@ -372,23 +429,37 @@ t_gnode::_process_table(t_uindex port_id) {
         get_output_schema().m_columns;
     t_uindex ncols = column_names.size();
 
+    // Only write the transitional columns that a context or expression reads;
+    // the rest are left unwritten for this update.
+    t_transitional_needs needs = _get_transitional_needs();
+
     parallel_for(
         int(ncols),
-        [&_process_state, &column_names, this](int colidx) {
+        [&_process_state, &column_names, &needs, this](int colidx) {
             const std::string& cname = column_names[colidx];
+            std::uint8_t tables = needs.get(cname);
+
+            if (tables == 0) {
+                return;
+            }
+
             auto* fcolumn =
                 _process_state.m_flattened_data_table->get_column(cname).get();
             auto* scolumn =
                 _process_state.m_state_data_table->get_column(cname).get();
-            auto* dcolumn =
-                _process_state.m_delta_data_table->get_column(cname).get();
-            auto* pcolumn =
-                _process_state.m_prev_data_table->get_column(cname).get();
-            auto* ccolumn =
-                _process_state.m_current_data_table->get_column(cname).get();
-            auto* tcolumn =
-                _process_state.m_transitions_data_table->get_column(cname).get(
-                );
+            auto* dcolumn = (tables & TRANSITIONAL_TABLE_DELTA) != 0
+                ? _process_state.m_delta_data_table->get_column(cname).get()
+                : nullptr;
+            auto* pcolumn = (tables & TRANSITIONAL_TABLE_PREV) != 0
+                ? _process_state.m_prev_data_table->get_column(cname).get()
+                : nullptr;
+            auto* ccolumn = (tables & TRANSITIONAL_TABLE_CURRENT) != 0
+                ? _process_state.m_current_data_table->get_column(cname).get()
+                : nullptr;
+            auto* tcolumn = (tables & TRANSITIONAL_TABLE_TRANSITIONS) != 0
+                ? _process_state.m_transitions_data_table->get_column(cname)
+                      .get()
+                : nullptr;
 
             t_dtype col_dtype = fcolumn->get_dtype();
 
@@ -555,6 +626,8 @@ t_gnode::_process_table(t_uindex port_id) {
         }
     );
 
+    process_columns_timer.stop();
+
     /**
      * After all columns have been processed (transitional tables written into),
      * `_process_state.m_flattened_data_table` contains the accumulated state
@@ -565,6 +638,10 @@ t_gnode::_process_table(t_uindex port_id) {
      * `OP_DELETE`. If there are any `OP_DELETE`s, the next step returns a
      * new `t_data_table` with the deleted rows masked out.
      */
+    t_stage_timer update_master_timer(
+        m_trace, TRACE_STAGE_UPDATE_MASTER, mask_count
+    );
+
     std::shared_ptr<t_data_table> flattened_masked;
 
     if (existed_mask.count() == _process_state.m_flattened_data_table->size()) {
@@ -583,7 +660,9 @@ t_gnode::_process_table(t_uindex port_id) {
     }
 #endif
 
-    m_gstate->update_master_table(flattened_masked.get());
+    m_gstate->update_master_table(flattened_masked.get(), updated_columns_ptr);
+    _compact_state();
+    update_master_timer.stop();
 
 #ifdef PSP_GNODE_VERIFY
     {
@@ -594,7 +673,12 @@ t_gnode::_process_table(t_uindex port_id) {
 
     m_oports[PSP_PORT_FLATTENED]->set_table(flattened_masked);
 
-    _compute_expressions(get_table_sptr(), flattened_masked);
+    {
+        t_stage_timer timer(
+            m_trace, TRACE_STAGE_COMPUTE_EXPRESSIONS, mask_count
+        );
+        _compute_expressions(get_table_sptr(), flattened_masked);
+    }
 
     result.m_flattened_data_table = flattened_masked;
     result.m_should_notify_userspace = true;
@@ -613,7 +697,9 @@ t_gnode::_process_column<std::string>(
     t_column* tcolumn,
     const t_process_state& process_state
 ) {
-    pcolumn->borrow_vocabulary(*scolumn);
+    if (pcolumn != nullptr) {
+        pcolumn->borrow_vocabulary(*scolumn);
+    }
 
     for (t_uindex idx = 0, loop_end = fcolumn->size(); idx < loop_end; ++idx) {
         std::uint8_t op_ = process_state.m_op_base[idx];
@@ -657,28 +743,34 @@ t_gnode::_process_column<std::string>(
                     prev_pkey_eq
                 );
 
-                if (prev_valid) {
-                    pcolumn->set_nth<t_uindex>(
-                        added_count,
-                        *(scolumn->get_nth<t_uindex>(rlookup.m_idx))
-                    );
+                if (pcolumn != nullptr) {
+                    if (prev_valid) {
+                        pcolumn->set_nth<t_uindex>(
+                            added_count,
+                            *(scolumn->get_nth<t_uindex>(rlookup.m_idx))
+                        );
+                    }
+
+                    pcolumn->set_valid(added_count, prev_valid);
                 }
 
-                pcolumn->set_valid(added_count, prev_valid);
+                if (ccolumn != nullptr) {
+                    if (cur_valid) {
+                        ccolumn->set_nth<const char*>(added_count, cur_value);
+                    }
 
-                if (cur_valid) {
-                    ccolumn->set_nth<const char*>(added_count, cur_value);
-                }
+                    if (!cur_valid && prev_valid) {
+                        ccolumn->set_nth<const char*>(added_count, prev_value);
+                    }
 
-                if (!cur_valid && prev_valid) {
-                    ccolumn->set_nth<const char*>(added_count, prev_value);
+                    ccolumn->set_valid(
+                        added_count, cur_valid ? cur_valid : prev_valid
+                    );
                 }
 
-                ccolumn->set_valid(
-                    added_count, cur_valid ? cur_valid : prev_valid
-                );
-
-                tcolumn->set_nth<std::uint8_t>(idx, trans);
+                if (tcolumn != nullptr) {
+                    tcolumn->set_nth<std::uint8_t>(idx, trans);
+                }
             } break;
             case OP_DELETE: {
                 if (row_pre_existed) {
@@ -687,17 +779,21 @@ t_gnode::_process_column<std::string>(
 
                     bool prev_valid = scolumn->is_valid(rlookup.m_idx);
 
-                    pcolumn->set_nth<const char*>(added_count, prev_value);
-
-                    pcolumn->set_valid(added_count, prev_valid);
-
-                    ccolumn->set_nth<const char*>(added_count, prev_value);
-
-                    ccolumn->set_valid(added_count, prev_valid);
-
-                    tcolumn->set_nth<std::uint8_t>(
-                        added_count, VALUE_TRANSITION_NEQ_TDF
-                    );
+                    if (pcolumn != nullptr) {
+                        pcolumn->set_nth<const char*>(added_count, prev_value);
+                        pcolumn->set_valid(added_count, prev_valid);
+                    }
+
+                    if (ccolumn != nullptr) {
+                        ccolumn->set_nth<const char*>(added_count, prev_value);
+                        ccolumn->set_valid(added_count, prev_valid);
+                    }
+
+                    if (tcolumn != nullptr) {
+                        tcolumn->set_nth<std::uint8_t>(
+                            added_count, VALUE_TRANSITION_NEQ_TDF
+                        );
+                    }
                 }
             } break;
             default: {
@@ -722,6 +818,28 @@ t_gnode::send(t_uindex port_id, const t_data_table& fragments) {
     input_port->send(fragments);
 }
 
+t_uindex
+t_gnode::num_pending_rows() const {
+    t_uindex rval = 0;
+    for (const auto& iter : m_input_ports) {
+        rval += iter.second->get_table()->size();
+    }
+
+    return rval;
+}
+
+void
+t_gnode::conflate_inputs() {
+    PSP_VERBOSE_ASSERT(
+        m_init, "Cannot `conflate_inputs` on an uninited gnode."
+    );
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    for (const auto& iter : m_input_ports) {
+        iter.second->conflate();
+    }
+}
+
 bool
 t_gnode::process(t_uindex port_id) {
     PSP_TRACE_SENTINEL();
@@ -739,11 +857,140 @@ t_gnode::process(t_uindex port_id) {
     return result.m_should_notify_userspace;
 }
 
+void
+t_gnode::set_retention(const std::string& column, std::int64_t ttl) {
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    m_retention_column = column;
+    m_retention_ttl = ttl;
+}
+
+/**
+ * @brief The scalar `cutoff` compares against in a column of `dtype`.
+ */
+static t_tscalar
+retention_threshold(t_dtype dtype, std::int64_t cutoff) {
+    switch (dtype) {
+        case DTYPE_TIME: {
+            return mktscalar(t_time(cutoff));
+        } break;
+        case DTYPE_INT32: {
+            std::int64_t lower = std::numeric_limits<std::int32_t>::min();
+            return mktscalar(
+                static_cast<std::int32_t>(std::max(cutoff, lower))
+            );
+        } break;
+        default: {
+            return mktscalar(cutoff);
+        } break;
+    }
+}
+
+bool
+t_gnode::queue_expired(t_uindex port_id) {
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    if (m_retention_column.empty() || m_input_ports.count(port_id) == 0) {
+        return false;
+    }
+
+    const t_data_table* master = get_table();
+    auto column = master->get_const_column(m_retention_column);
+
+    // The window is measured from the newest value the table holds, rather
+    // than the wall clock, so replayed or delayed feeds age out
+    // consistently. Removed rows are cleared to invalid, so they neither
+    // set the newest value nor match the filter below.
+    t_tscalar newest = column->get_min_max().second;
+    if (!newest.is_valid()) {
+        return false;
+    }
+
+    t_tscalar threshold = retention_threshold(
+        column->get_dtype(), newest.to_int64() - m_retention_ttl
+    );
+
+    // Goes through the zone maps, so only the oldest chunks are scanned.
+    std::vector<t_fterm> fterms{
+        t_fterm(m_retention_column, FILTER_OP_LT, threshold, {})
+    };
+    t_mask mask = master->filter_cpp(FILTER_OP_AND, fterms);
+    if (mask.count() == 0) {
+        return false;
+    }
+
+    // Rows still pending on any port are left for the update that writes
+    // them, which may refresh them; ports are processed in turn, so a
+    // removal queued here would otherwise land first.
+    tsl::hopscotch_set<t_tscalar> pending_pkeys;
+    for (const auto& [_, port] : m_input_ports) {
+        const t_data_table& pending = *port->get_table();
+        if (pending.size() == 0) {
+            continue;
+        }
+
+        auto pkeys = pending.get_const_column("psp_pkey");
+        for (t_uindex ridx = 0; ridx < pending.size(); ++ridx) {
+            pending_pkeys.insert(pkeys->get_scalar(ridx));
+        }
+    }
+
+    auto pkeys = master->get_const_column("psp_pkey");
+    std::vector<t_tscalar> expired;
+    expired.reserve(mask.count());
+    for (t_uindex ridx = mask.find_first(); ridx != t_mask::m_npos;
+         ridx = mask.find_next(ridx)) {
+        t_tscalar pkey = pkeys->get_scalar(ridx);
+        if (pending_pkeys.count(pkey) == 0) {
+            expired.push_back(pkey);
+        }
+    }
+
+    if (expired.empty()) {
+        return false;
+    }
+
+    t_data_table removes(m_input_schema);
+    removes.init();
+    removes.extend(expired.size());
+
+    auto* pkey_col = removes.get_column("psp_pkey").get();
+    auto* okey_col = removes.get_column("psp_okey").get();
+    for (t_uindex ridx = 0; ridx < expired.size(); ++ridx) {
+        pkey_col->set_scalar(ridx, expired[ridx]);
+        okey_col->set_scalar(ridx, expired[ridx]);
+    }
+
+    removes.get_column("psp_op")->raw_fill<std::uint8_t>(OP_DELETE);
+    m_input_ports[port_id]->send(removes);
+    return true;
+}
+
 t_uindex
 t_gnode::mapping_size() const {
     return m_gstate->mapping_size();
 }
 
+void
+t_gnode::save_snapshot(const std::string& dirname) const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    m_gstate->save_snapshot(dirname);
+}
+
+void
+t_gnode::load_snapshot(const std::string& dirname) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    if (!m_contexts.empty() || !m_suspended_contexts.empty()) {
+        PSP_COMPLAIN_AND_ABORT("Cannot restore a snapshot into a table with "
+                               "views.");
+    }
+
+    m_gstate->load_snapshot(dirname);
+}
+
 t_data_table*
 t_gnode::_get_otable(t_uindex port_id) {
     PSP_TRACE_SENTINEL();
@@ -840,6 +1087,10 @@ t_gnode::update_context_from_state(
         return;
     }
 
+    t_stage_timer timer(
+        ctx->get_trace(), TRACE_STAGE_CONTEXT_NOTIFY, flattened->size()
+    );
+
     // Need to cast shared ptr to a const reference before passing to notify,
     // reference is valid as `notify` is not async
     const auto& const_flattened = const_cast<const t_data_table&>(*flattened);
@@ -868,13 +1119,22 @@ t_gnode::_update_contexts_from_state(std::shared_ptr<t_data_table> tbl) {
         count++;
     }
 
+    // Contexts sharing sparse trees are reset and rebuilt by the first
+    // context in their group, and then re-attached to its new trees.
+    std::vector<t_index> tree_leaders = _group_shared_trees(context_handles);
+
     auto update_contexts_helper = [this,
                                    &context_names,
                                    &context_handles,
+                                   &tree_leaders,
                                    &tbl](t_index ctx_idx) {
         const std::string& name = context_names[ctx_idx];
         const t_ctx_handle& ctxh = context_handles[ctx_idx];
 
+        if (tree_leaders[ctx_idx] != INVALID_INDEX) {
+            return;
+        }
+
         switch (ctxh.get_type()) {
             case TWO_SIDED_CONTEXT: {
                 auto* ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
@@ -912,6 +1172,40 @@ t_gnode::_update_contexts_from_state(std::shared_ptr<t_data_table> tbl) {
     parallel_for(int(num_contexts), [&update_contexts_helper](int ctx_idx) {
         update_contexts_helper(ctx_idx);
     });
+
+    for (t_index ctx_idx = 0; ctx_idx < num_contexts; ++ctx_idx) {
+        t_index leader_idx = tree_leaders[ctx_idx];
+        if (leader_idx == INVALID_INDEX) {
+            continue;
+        }
+
+        const t_ctx_handle& ctxh = context_handles[ctx_idx];
+        const t_ctx_handle& leader = context_handles[leader_idx];
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                auto* ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
+                ctx->reset(false);
+                ctx->share_trees(*static_cast<t_ctx2*>(leader.m_ctx));
+                ctx->set_tree_shared(true);
+                static_cast<t_ctx2*>(leader.m_ctx)->set_tree_shared(true);
+                ctx->step_begin();
+                ctx->step_end();
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                auto* ctx = static_cast<t_ctx1*>(ctxh.m_ctx);
+                ctx->reset(false);
+                ctx->share_trees(*static_cast<t_ctx1*>(leader.m_ctx));
+                ctx->set_tree_shared(true);
+                static_cast<t_ctx1*>(leader.m_ctx)->set_tree_shared(true);
+                ctx->step_begin();
+                ctx->step_end();
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected context type");
+            } break;
+        }
+    }
 }
 
 /**
@@ -940,6 +1234,10 @@ t_gnode::notify_context<t_ctxunit>(
         m_oports[PSP_PORT_TRANSITIONS]->get_table();
     const t_data_table& existed = *(m_oports[PSP_PORT_EXISTED]->get_table());
 
+    t_stage_timer timer(
+        ctx->get_trace(), TRACE_STAGE_CONTEXT_NOTIFY, flattened->size()
+    );
+
     ctx->step_begin();
 
     // pass the tables as const references - the destructors for all of the
@@ -1009,6 +1307,7 @@ t_gnode::_register_context(
     std::shared_ptr<t_data_table> pkeyed_table;
 
     if (should_update) {
+        _compact_state();
         pkeyed_table = m_gstate->get_pkeyed_table();
     }
 
@@ -1034,7 +1333,16 @@ t_gnode::_register_context(
                         ctx->get_expression_tables()->m_master
                     )
                 );
+            }
+
+            auto* other =
+                _find_shared_tree_context<t_ctx2>(name, TWO_SIDED_CONTEXT, ctx);
 
+            if (other != nullptr) {
+                ctx->share_trees(*other);
+                ctx->set_tree_shared(true);
+                other->set_tree_shared(true);
+            } else if (should_update) {
                 update_context_from_state<t_ctx2>(ctx, name, pkeyed_table);
             }
         } break;
@@ -1055,7 +1363,16 @@ t_gnode::_register_context(
                         ctx->get_expression_tables()->m_master
                     )
                 );
+            }
 
+            auto* other =
+                _find_shared_tree_context<t_ctx1>(name, ONE_SIDED_CONTEXT, ctx);
+
+            if (other != nullptr) {
+                ctx->share_trees(*other);
+                ctx->set_tree_shared(true);
+                other->set_tree_shared(true);
+            } else if (should_update) {
                 update_context_from_state<t_ctx1>(ctx, name, pkeyed_table);
             }
         } break;
@@ -1127,6 +1444,94 @@ t_gnode::_unregister_context(const std::string& name) {
     if (m_contexts.count(name) != 0) {
         m_contexts.erase(name);
     }
+
+    m_suspended_contexts.erase(name);
+}
+
+void
+t_gnode::suspend_context(const std::string& name) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    auto iter = m_contexts.find(name);
+    if (iter == m_contexts.end()) {
+        return;
+    }
+
+    t_suspended_context suspended;
+    suspended.m_ctxh = iter->second;
+
+    switch (suspended.m_ctxh.get_type()) {
+        case TWO_SIDED_CONTEXT: {
+            auto* ctx = static_cast<t_ctx2*>(suspended.m_ctxh.m_ctx);
+            suspended.m_row_expansions = ctx->get_expansion_state(HEADER_ROW);
+            suspended.m_column_expansions =
+                ctx->get_expansion_state(HEADER_COLUMN);
+        } break;
+        case ONE_SIDED_CONTEXT: {
+            auto* ctx = static_cast<t_ctx1*>(suspended.m_ctxh.m_ctx);
+            suspended.m_row_expansions = ctx->get_expansion_state();
+        } break;
+        case GROUPED_PKEY_CONTEXT: {
+            auto* ctx =
+                static_cast<t_ctx_grouped_pkey*>(suspended.m_ctxh.m_ctx);
+            suspended.m_row_expansions = ctx->get_expansion_state();
+        } break;
+        default: {
+        } break;
+    }
+
+    m_suspended_contexts[name] = std::move(suspended);
+    m_contexts.erase(iter);
+}
+
+void
+t_gnode::resume_context(const std::string& name) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_GIL_UNLOCK();
+    PSP_WRITE_LOCK(*m_lock);
+    auto iter = m_suspended_contexts.find(name);
+    if (iter == m_suspended_contexts.end()) {
+        return;
+    }
+
+    t_suspended_context suspended = std::move(iter->second);
+    m_suspended_contexts.erase(iter);
+
+    // Registering again resets the context and rebuilds it, along with its
+    // expression columns, from the master table - or re-attaches it to the
+    // trees of a live context with the same tree config.
+    const t_ctx_handle& ctxh = suspended.m_ctxh;
+    _register_context(
+        name, ctxh.get_type(), reinterpret_cast<std::uintptr_t>(ctxh.m_ctx)
+    );
+
+    switch (ctxh.get_type()) {
+        case TWO_SIDED_CONTEXT: {
+            auto* ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
+            ctx->set_expansion_state(
+                HEADER_COLUMN, suspended.m_column_expansions
+            );
+            ctx->set_expansion_state(HEADER_ROW, suspended.m_row_expansions);
+        } break;
+        case ONE_SIDED_CONTEXT: {
+            static_cast<t_ctx1*>(ctxh.m_ctx)
+                ->set_expansion_state(suspended.m_row_expansions);
+        } break;
+        case GROUPED_PKEY_CONTEXT: {
+            static_cast<t_ctx_grouped_pkey*>(ctxh.m_ctx)
+                ->set_expansion_state(suspended.m_row_expansions);
+        } break;
+        default: {
+        } break;
+    }
+}
+
+bool
+t_gnode::is_context_suspended(const std::string& name) const {
+    return m_suspended_contexts.count(name) != 0;
 }
 
 void
@@ -1146,11 +1551,21 @@ t_gnode::notify_contexts(std::shared_ptr<t_data_table> flattened) {
         ctxh_count++;
     }
 
+    // Contexts that share sparse trees with an earlier context skip the tree
+    // update, and only refresh their traversals once the tree is notified.
+    std::vector<t_index> tree_leaders = _group_shared_trees(ctxhvec);
+
     auto notify_context_helper =
-        [this, &context_names, &ctxhvec, &flattened](t_index ctx_idx) {
+        [this, &context_names, &ctxhvec, &tree_leaders, &flattened](
+            t_index ctx_idx
+        ) {
             const std::string& name = context_names[ctx_idx];
             const t_ctx_handle& ctxh = ctxhvec[ctx_idx];
 
+            if (tree_leaders[ctx_idx] != INVALID_INDEX) {
+                return;
+            }
+
             switch (ctxh.get_type()) {
                 case TWO_SIDED_CONTEXT: {
                     notify_context<t_ctx2>(flattened, ctxh, name);
@@ -1176,6 +1591,142 @@ t_gnode::notify_contexts(std::shared_ptr<t_data_table> flattened) {
     parallel_for(int(num_contexts), [&notify_context_helper](int ctx_idx) {
         notify_context_helper(ctx_idx);
     });
+
+    // Traversals over a shared tree are refreshed serially, as they may all
+    // flag the tree as having deltas.
+    for (t_index ctx_idx = 0; ctx_idx < num_contexts; ++ctx_idx) {
+        if (tree_leaders[ctx_idx] == INVALID_INDEX) {
+            continue;
+        }
+
+        const t_ctx_handle& ctxh = ctxhvec[ctx_idx];
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                notify_context_from_shared_tree<t_ctx2>(
+                    ctxh, flattened->size()
+                );
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                notify_context_from_shared_tree<t_ctx1>(
+                    ctxh, flattened->size()
+                );
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected context type");
+            } break;
+        }
+    }
+}
+
+template <typename CTX_T>
+void
+t_gnode::notify_context_from_shared_tree(
+    const t_ctx_handle& ctxh, t_uindex num_rows
+) {
+    CTX_T* ctx = ctxh.get<CTX_T>();
+
+    t_stage_timer timer(ctx->get_trace(), TRACE_STAGE_CONTEXT_NOTIFY, num_rows);
+
+    ctx->step_begin();
+    ctx->notify_from_shared_tree();
+    ctx->step_end();
+}
+
+template <typename CTX_T>
+CTX_T*
+t_gnode::_find_shared_tree_context(
+    const std::string& name, t_ctx_type type, const CTX_T* ctx
+) const {
+    if (t_env::disable_shared_trees()) {
+        return nullptr;
+    }
+
+    std::string tree_key = ctx->get_config().get_tree_key();
+    if (tree_key.empty()) {
+        return nullptr;
+    }
+
+    for (const auto& [other_name, other_ctxh] : m_contexts) {
+        if (other_name == name || other_ctxh.get_type() != type) {
+            continue;
+        }
+
+        auto* other = static_cast<CTX_T*>(other_ctxh.m_ctx);
+        if (other->get_config().get_tree_key() == tree_key) {
+            return other;
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<t_index>
+t_gnode::_group_shared_trees(const std::vector<t_ctx_handle>& ctxhvec) {
+    t_index num_contexts = ctxhvec.size();
+    std::vector<t_index> tree_leaders(num_contexts, INVALID_INDEX);
+    std::vector<std::vector<t_stree*>> trees(num_contexts);
+
+    // Contexts sharing trees hold the same tree pointers, so the first tree
+    // identifies the group.
+    tsl::hopscotch_map<const t_stree*, t_index> groups;
+
+    for (t_index ctx_idx = 0; ctx_idx < num_contexts; ++ctx_idx) {
+        const t_ctx_handle& ctxh = ctxhvec[ctx_idx];
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                trees[ctx_idx] = static_cast<t_ctx2*>(ctxh.m_ctx)->get_trees();
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                trees[ctx_idx] = static_cast<t_ctx1*>(ctxh.m_ctx)->get_trees();
+            } break;
+            default:
+                break;
+        }
+
+        if (trees[ctx_idx].empty()) {
+            continue;
+        }
+
+        auto [iter, inserted] = groups.emplace(trees[ctx_idx][0], ctx_idx);
+        if (!inserted) {
+            tree_leaders[ctx_idx] = iter->second;
+        }
+    }
+
+    std::vector<bool> is_shared(num_contexts, false);
+    for (t_index ctx_idx = 0; ctx_idx < num_contexts; ++ctx_idx) {
+        if (tree_leaders[ctx_idx] != INVALID_INDEX) {
+            is_shared[ctx_idx] = true;
+            is_shared[tree_leaders[ctx_idx]] = true;
+        }
+    }
+
+    for (t_index ctx_idx = 0; ctx_idx < num_contexts; ++ctx_idx) {
+        const t_ctx_handle& ctxh = ctxhvec[ctx_idx];
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                static_cast<t_ctx2*>(ctxh.m_ctx)
+                    ->set_tree_shared(is_shared[ctx_idx]);
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                static_cast<t_ctx1*>(ctxh.m_ctx)
+                    ->set_tree_shared(is_shared[ctx_idx]);
+            } break;
+            default:
+                break;
+        }
+
+        if (is_shared[ctx_idx] && tree_leaders[ctx_idx] == INVALID_INDEX) {
+            for (auto* tree : trees[ctx_idx]) {
+                tree->clear_deltas();
+            }
+        }
+    }
+
+    return tree_leaders;
 }
 
 /******************************************************************************
@@ -1352,11 +1903,167 @@ t_gnode::_compute_expressions(
     }
 }
 
+std::shared_ptr<t_data_table>
+t_gnode::_get_flatten_target(const t_data_table& input) {
+    if (t_env::disable_table_recycling()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<t_port>& port = m_oports[PSP_PORT_FLATTENED];
+    std::shared_ptr<t_data_table> table = port->get_table();
+
+    // The port and `table` are the only owners unless a caller has kept the
+    // flattened table returned from the previous update.
+    if (table == nullptr || table.use_count() > 2
+        || !(table->get_schema() == input.get_schema())) {
+        return nullptr;
+    }
+
+    port->recycle();
+    return table;
+}
+
+void
+t_gnode::_compact_state() {
+    if (t_env::disable_gstate_compaction()) {
+        return;
+    }
+
+    t_uindex prev_num_rows = m_gstate->num_rows();
+    auto moves = m_gstate->compact();
+    t_uindex num_rows = m_gstate->num_rows();
+
+    if (num_rows == prev_num_rows) {
+        return;
+    }
+
+    for (const auto& iter : m_contexts) {
+        const t_ctx_handle& ctxh = iter.second;
+        std::shared_ptr<t_expression_tables> expression_tables;
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                expression_tables =
+                    static_cast<t_ctx2*>(ctxh.m_ctx)->get_expression_tables();
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                expression_tables =
+                    static_cast<t_ctx1*>(ctxh.m_ctx)->get_expression_tables();
+            } break;
+            case ZERO_SIDED_CONTEXT: {
+                expression_tables =
+                    static_cast<t_ctx0*>(ctxh.m_ctx)->get_expression_tables();
+            } break;
+            case GROUPED_PKEY_CONTEXT: {
+                expression_tables =
+                    static_cast<t_ctx_grouped_pkey*>(ctxh.m_ctx)
+                        ->get_expression_tables();
+            } break;
+            case UNIT_CONTEXT:
+                break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected context type");
+            } break;
+        }
+
+        if (expression_tables == nullptr) {
+            continue;
+        }
+
+        // The master expression table is aligned with the gstate's rows, but
+        // does not have the rows appended by this update yet - grow it so
+        // every move has a source, as `_compute_expressions` fills them in.
+        const auto& master = expression_tables->m_master;
+        if (master->size() > prev_num_rows) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Expression table has more rows than the gnode state"
+            );
+        }
+
+        master->reserve(prev_num_rows);
+        master->set_size(prev_num_rows);
+        master->move_rows(moves);
+        master->set_size(num_rows);
+    }
+}
+
+t_transitional_needs
+t_gnode::_get_transitional_needs() const {
+    t_transitional_needs needs;
+
+    if (t_env::disable_demand_transitions()) {
+        needs.require_all();
+        return needs;
+    }
+
+    for (const auto& iter : m_contexts) {
+        const t_ctx_handle& ctxh = iter.second;
+
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT: {
+                _merge_transitional_needs<t_ctx2>(ctxh, needs);
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                _merge_transitional_needs<t_ctx1>(ctxh, needs);
+            } break;
+            case ZERO_SIDED_CONTEXT: {
+                _merge_transitional_needs<t_ctx0>(ctxh, needs);
+            } break;
+            case GROUPED_PKEY_CONTEXT: {
+                _merge_transitional_needs<t_ctx_grouped_pkey>(ctxh, needs);
+            } break;
+            case UNIT_CONTEXT: {
+                auto* ctx = static_cast<const t_ctxunit*>(ctxh.m_ctx);
+                needs.merge(ctx->get_transitional_needs());
+            } break;
+            default: {
+                PSP_COMPLAIN_AND_ABORT("Unexpected context type");
+            } break;
+        }
+
+        if (needs.m_all) {
+            break;
+        }
+    }
+
+    return needs;
+}
+
 /******************************************************************************
  *
  * Getters
  */
 
+t_stage_trace&
+t_gnode::get_trace() const {
+    return m_trace;
+}
+
+t_gnode_memory_usage
+t_gnode::get_memory_usage() const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    t_gnode_memory_usage rv;
+    const t_data_table* master = get_table();
+    rv.m_column_bytes = master->column_nbytes();
+    rv.m_vocab_bytes = master->nbytes() - rv.m_column_bytes;
+    rv.m_mapping_bytes = m_gstate->mapping_nbytes();
+    rv.m_expression_vocab_bytes = m_expression_vocab->nbytes();
+
+    // Output port tables borrow their vocabularies from the master table, so
+    // only their column buffers are counted.
+    for (const auto& kv : m_input_ports) {
+        rv.m_port_bytes += kv.second->get_table()->column_nbytes();
+    }
+
+    for (const auto& port : m_oports) {
+        rv.m_port_bytes += port->get_table()->column_nbytes();
+    }
+
+    return rv;
+}
+
 const t_gstate::t_mapping&
 t_gnode::get_pkey_map() const {
     PSP_TRACE_SENTINEL();
@@ -17,33 +17,72 @@
 #include <perspective/context_two.h>
 #include <perspective/gnode_state.h>
 #include <perspective/mask.h>
+#include <perspective/memory_usage.h>
 #include <perspective/sym_table.h>
 #include <perspective/parallel_for.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <utility>
 
 namespace perspective {
 
-t_gstate::t_gstate(t_schema input_schema, t_schema output_schema) :
+t_gstate::t_gstate(
+    t_schema input_schema, t_schema output_schema, t_storage_options storage
+) :
     m_input_schema(std::move(input_schema)),
     m_output_schema(std::move(output_schema)),
-    m_init(false) {
+    m_storage(std::move(storage)),
+    m_init(false),
+    m_last_update_rows_changed(true),
+    m_last_update_all_columns(true) {
     LOG_CONSTRUCTOR("t_gstate");
 }
 
-t_gstate::~t_gstate() { LOG_DESTRUCTOR("t_gstate"); }
+t_gstate::~t_gstate() {
+    LOG_DESTRUCTOR("t_gstate");
+
+    // The column stores remove their own files; drop the then empty
+    // directory too, leaving it alone if anything else is still in it.
+    if (m_storage.m_backing_store == BACKING_STORE_DISK) {
+        m_table.reset();
+        std::error_code ec;
+        std::filesystem::remove(m_storage.m_dirname, ec);
+    }
+}
 
 void
 t_gstate::init() {
+    if (m_storage.m_backing_store == BACKING_STORE_DISK) {
+        std::filesystem::create_directories(m_storage.m_dirname);
+    }
+
     m_table = std::make_shared<t_data_table>(
-        "", "", m_input_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY
+        "",
+        m_storage.m_dirname,
+        m_input_schema,
+        DEFAULT_EMPTY_CAPACITY,
+        m_storage.m_backing_store
     );
     m_table->init();
     m_pkcol = m_table->get_column("psp_pkey");
     m_opcol = m_table->get_column("psp_op");
+    index_columns();
     m_init = true;
 }
 
+void
+t_gstate::index_columns() {
+    for (const auto& colname : m_storage.m_indexed_columns) {
+        if (m_table->get_schema().has_column(colname)) {
+            m_table->get_column(colname)->set_indexed(true);
+        }
+    }
+}
+
 t_rlookup
 t_gstate::lookup(t_tscalar pkey) const {
     t_rlookup rval(0, false);
@@ -134,9 +173,20 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
     t_uindex ncols = m_table->num_columns();
     auto* master_table = m_table.get();
 
+    // Disk backed columns are copied into rather than replaced by clones,
+    // which would live in memory.
+    bool copy_into_master =
+        m_storage.m_backing_store == BACKING_STORE_DISK;
+
+    if (copy_into_master) {
+        master_table->reserve(flattened->get_capacity());
+    }
+
     parallel_for(
         int(ncols),
-        [&master_table, &master_table_schema, &flattened](int idx) {
+        [&master_table, &master_table_schema, &flattened, copy_into_master](
+            int idx
+        ) {
             // Clone each column from flattened into `m_table`
             const std::string& column_name = master_table_schema.m_columns[idx];
             // No need for safe lookup as master_table schema == flattened
@@ -146,13 +196,24 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
             if (!flattened_column) {
                 return;
             }
-            master_table->set_column(idx, flattened_column->clone());
+
+            if (copy_into_master) {
+                master_table->get_column(column_name)
+                    ->copy_from(*flattened_column);
+            } else {
+                master_table->set_column(idx, flattened_column->clone());
+            }
         }
     );
 
     m_pkcol = master_table->get_column("psp_pkey");
     m_opcol = master_table->get_column("psp_op");
 
+    // Clones of the flattened columns are not indexed.
+    if (!copy_into_master) {
+        index_columns();
+    }
+
     master_table->set_capacity(flattened->get_capacity());
     master_table->set_size(flattened->size());
 
@@ -184,12 +245,26 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
 }
 
 void
-t_gstate::update_master_table(const t_data_table* flattened) {
+t_gstate::update_master_table(
+    const t_data_table* flattened,
+    const tsl::hopscotch_set<std::string>* updated_columns
+) {
+    m_last_update_all_columns = updated_columns == nullptr;
+    m_last_updated_columns.clear();
+
     if (num_rows() == 0) {
+        m_last_update_rows_changed = true;
+        m_last_update_all_columns = true;
         fill_master_table(flattened);
+        enforce_resident_budget();
+        compress_idle_columns();
         return;
     }
 
+    if (updated_columns != nullptr) {
+        m_last_updated_columns = *updated_columns;
+    }
+
     // Update existing `m_table`
     const t_column* flattened_pkey_col =
         flattened->get_const_column("psp_pkey").get();
@@ -198,6 +273,8 @@ t_gstate::update_master_table(const t_data_table* flattened) {
 
     t_data_table* master_table = m_table.get();
     std::vector<t_uindex> master_table_indexes(flattened->num_rows());
+    t_uindex prev_mapping_size = m_mapping.size();
+    bool has_removes = false;
 
     for (t_uindex idx = 0, loop_end = flattened->num_rows(); idx < loop_end;
          ++idx) {
@@ -220,6 +297,7 @@ t_gstate::update_master_table(const t_data_table* flattened) {
                 // Erase the pkey from the master table, but this does not
                 // change the size as the row isn't removed, just cleared out.
                 erase(pkey);
+                has_removes = true;
             } break;
             default: {
                 PSP_COMPLAIN_AND_ABORT("Unexpected OP");
@@ -227,6 +305,9 @@ t_gstate::update_master_table(const t_data_table* flattened) {
         }
     }
 
+    m_last_update_rows_changed =
+        has_removes || m_mapping.size() != prev_mapping_size;
+
     const t_schema& master_schema = m_table->get_schema();
     t_uindex ncols = master_table->num_columns();
 
@@ -239,6 +320,13 @@ t_gstate::update_master_table(const t_data_table* flattened) {
          &master_table_indexes,
          this](int idx) {
             const std::string& column_name = master_schema.m_columns[idx];
+
+            // Columns absent from the update hold no valid or cleared values,
+            // so `update_master_column` would skip every row.
+            if (!column_changed_by_last_update(column_name)) {
+                return;
+            }
+
             t_column* master_column =
                 master_table->get_column(column_name).get();
             auto flattened_column =
@@ -255,6 +343,100 @@ t_gstate::update_master_table(const t_data_table* flattened) {
             );
         }
     );
+
+    enforce_resident_budget();
+    compress_idle_columns();
+}
+
+void
+t_gstate::compress_idle_columns() {
+    if (m_storage.m_backing_store != BACKING_STORE_MEMORY
+        || m_storage.m_compress_after_updates == 0) {
+        return;
+    }
+
+    const auto& columns = m_table->get_schema().m_columns;
+    m_idle_updates.resize(columns.size(), 0);
+
+    for (t_uindex idx = 0; idx < columns.size(); ++idx) {
+        t_column* column = m_table->get_column(columns[idx]).get();
+
+        // A column read since the last update, e.g. by a context, would only
+        // be decompressed again, so it is not idle.
+        bool read = column->take_read();
+        if (read || column_changed_by_last_update(columns[idx])) {
+            m_idle_updates[idx] = 0;
+            continue;
+        }
+
+        if (++m_idle_updates[idx] == m_storage.m_compress_after_updates) {
+            column->compress();
+        }
+    }
+}
+
+void
+t_gstate::enforce_resident_budget() {
+    if (m_storage.m_backing_store != BACKING_STORE_DISK
+        || m_storage.m_resident_budget == 0) {
+        return;
+    }
+
+    const auto& columns = m_table->get_schema().m_columns;
+    std::vector<std::pair<t_uindex, t_uindex>> resident(columns.size());
+    t_uindex total = 0;
+
+    for (t_uindex idx = 0; idx < columns.size(); ++idx) {
+        t_uindex nbytes =
+            m_table->get_const_column(columns[idx])->resident_nbytes();
+        resident[idx] = {nbytes, idx};
+        total += nbytes;
+    }
+
+    if (total <= m_storage.m_resident_budget) {
+        return;
+    }
+
+    // Page out columns the last update did not write first, then the
+    // largest.
+    std::sort(
+        resident.begin(),
+        resident.end(),
+        [&](const std::pair<t_uindex, t_uindex>& a,
+            const std::pair<t_uindex, t_uindex>& b) {
+            bool a_hot = column_changed_by_last_update(columns[a.second]);
+            bool b_hot = column_changed_by_last_update(columns[b.second]);
+            if (a_hot != b_hot) {
+                return b_hot;
+            }
+
+            return a.first > b.first;
+        }
+    );
+
+    for (const auto& [nbytes, idx] : resident) {
+        if (total <= m_storage.m_resident_budget) {
+            break;
+        }
+
+        m_table->get_const_column(columns[idx])->advise(ACCESS_ADVICE_DONTNEED);
+        total -= nbytes;
+    }
+}
+
+bool
+t_gstate::rows_changed_by_last_update() const {
+    return m_last_update_rows_changed;
+}
+
+bool
+t_gstate::column_changed_by_last_update(const std::string& colname) const {
+    if (m_last_update_all_columns
+        || !m_table->get_schema().has_column(colname)) {
+        return true;
+    }
+
+    return m_last_updated_columns.find(colname) != m_last_updated_columns.end();
 }
 
 void
@@ -387,6 +569,51 @@ t_gstate::pprint() const {
     m_table->pprint(indices);
 }
 
+std::vector<std::pair<t_uindex, t_uindex>>
+t_gstate::compact() {
+    std::vector<std::pair<t_uindex, t_uindex>> moves;
+
+    if (m_free.empty()) {
+        return moves;
+    }
+
+    std::vector<t_uindex> holes(m_free.begin(), m_free.end());
+    std::sort(holes.begin(), holes.end());
+
+    // Walk the holes from both ends: a hole at the end of the table is
+    // dropped, otherwise the last (live) row is moved into the lowest hole.
+    t_uindex table_size = m_table->size();
+    auto lo = holes.begin();
+    auto hi = holes.end();
+
+    while (lo != hi) {
+        if (*(hi - 1) == table_size - 1) {
+            --hi;
+        } else {
+            moves.emplace_back(table_size - 1, *lo);
+            ++lo;
+        }
+
+        --table_size;
+    }
+
+    m_table->move_rows(moves);
+
+    for (const auto& [from, to] : moves) {
+        t_tscalar pkey = m_pkcol->get_scalar(to);
+        auto iter = m_mapping.find(pkey);
+        PSP_VERBOSE_ASSERT(
+            iter != m_mapping.end(), "Moved row has no primary key"
+        );
+        iter.value() = to;
+    }
+
+    m_table->set_size(table_size);
+    m_free.clear();
+
+    return moves;
+}
+
 t_mask
 t_gstate::get_cpp_mask() const {
     t_uindex sz = m_table->size();
@@ -635,7 +862,8 @@ t_gstate::get_pkeyed_table(
     const t_schema& schema, const std::shared_ptr<t_data_table>& table
 ) const {
     // If there are no removes, just return the gstate table. Removes would
-    // cause m_mapping to be smaller than m_table.
+    // cause m_mapping to be smaller than m_table, which only happens here
+    // if `t_gnode` has not compacted the state since the last remove.
     if (m_mapping.size() == table->size()) {
         return table;
     }
@@ -772,6 +1000,11 @@ t_gstate::mapping_size() const {
     return m_mapping.size();
 }
 
+t_uindex
+t_gstate::mapping_nbytes() const {
+    return hash_container_nbytes(m_mapping) + hash_container_nbytes(m_free);
+}
+
 void
 t_gstate::reset() {
     m_table->reset();
@@ -779,6 +1012,187 @@ t_gstate::reset() {
     m_free.clear();
 }
 
+// Bumped whenever the manifest or store layout written by `save_snapshot`
+// changes, so stale snapshots are rejected instead of misread.
+static const std::uint32_t SNAPSHOT_VERSION = 1;
+
+static std::string
+snapshot_column_fname(const std::string& dirname, t_uindex cidx) {
+    std::stringstream ss;
+    ss << dirname << "/column_" << cidx;
+    return ss.str();
+}
+
+void
+t_gstate::save_snapshot(const std::string& dirname) const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    std::filesystem::create_directories(dirname);
+
+    std::ofstream manifest(dirname + "/manifest");
+    if (!manifest) {
+        PSP_COMPLAIN_AND_ABORT("Cannot write snapshot to `" + dirname + "`");
+    }
+
+    manifest << "psp_snapshot " << SNAPSHOT_VERSION << '\n';
+    manifest << "rows " << m_table->num_rows() << '\n';
+
+    std::vector<t_uindex> free_rows(m_free.begin(), m_free.end());
+    std::sort(free_rows.begin(), free_rows.end());
+    manifest << "free " << free_rows.size();
+    for (auto ridx : free_rows) {
+        manifest << ' ' << ridx;
+    }
+
+    const auto& columns = m_input_schema.columns();
+    manifest << "\ncolumns " << columns.size() << '\n';
+
+    for (t_uindex cidx = 0; cidx < columns.size(); ++cidx) {
+        auto col = m_table->get_const_column(columns[cidx]);
+        t_column_recipe recipe = col->get_recipe();
+        manifest << std::quoted(columns[cidx]) << ' '
+                 << static_cast<std::int32_t>(recipe.m_dtype) << ' '
+                 << recipe.m_size << ' ' << recipe.m_status_enabled << ' '
+                 << recipe.m_vlenidx << ' ' << recipe.m_data.m_size << ' '
+                 << (recipe.m_status_enabled ? recipe.m_status.m_size : 0)
+                 << ' ' << (recipe.m_isvlen ? recipe.m_vlendata.m_size : 0)
+                 << ' ' << (recipe.m_isvlen ? recipe.m_extents.m_size : 0)
+                 << '\n';
+
+        col->save(snapshot_column_fname(dirname, cidx));
+    }
+
+    if (!manifest) {
+        PSP_COMPLAIN_AND_ABORT("Cannot write snapshot to `" + dirname + "`");
+    }
+}
+
+/**
+ * @brief Whether the store `load` reads from `fname` holds exactly `size`
+ * bytes, so a truncated or mismatched snapshot is rejected before it is
+ * read.
+ */
+static bool
+snapshot_store_matches(const std::string& fname, t_uindex size) {
+    if (size == 0) {
+        return true;
+    }
+
+    std::error_code ec;
+    auto fsize = std::filesystem::file_size(fname, ec);
+    return !ec && fsize == size;
+}
+
+void
+t_gstate::load_snapshot(const std::string& dirname) {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    if (m_table->num_rows() != 0 || !m_mapping.empty()) {
+        PSP_COMPLAIN_AND_ABORT("Cannot restore a snapshot into a non-empty "
+                               "table.");
+    }
+
+    std::ifstream manifest(dirname + "/manifest");
+    std::string tag;
+    std::uint32_t version = 0;
+    manifest >> tag >> version;
+
+    if (!manifest || tag != "psp_snapshot" || version != SNAPSHOT_VERSION) {
+        PSP_COMPLAIN_AND_ABORT(
+            "`" + dirname + "` is not a compatible table snapshot."
+        );
+    }
+
+    // The whole manifest is checked against the schema and the store files
+    // before anything is loaded, so a corrupt snapshot fails with an error
+    // rather than reading past the end of a store.
+    std::string rows_tag;
+    std::string free_tag;
+    t_uindex nrows = 0;
+    t_uindex nfree = 0;
+    manifest >> rows_tag >> nrows >> free_tag >> nfree;
+    if (!manifest || rows_tag != "rows" || free_tag != "free"
+        || nfree > nrows) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot manifest is corrupt.");
+    }
+
+    std::vector<t_uindex> free_rows(nfree);
+    for (auto& ridx : free_rows) {
+        manifest >> ridx;
+        if (!manifest || ridx >= nrows) {
+            PSP_COMPLAIN_AND_ABORT("Snapshot manifest is corrupt.");
+        }
+    }
+
+    t_uindex ncols = 0;
+    manifest >> tag >> ncols;
+    if (!manifest || tag != "columns" || ncols != m_input_schema.size()) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot does not match the table schema.");
+    }
+
+    std::vector<std::pair<std::string, t_column_recipe>> recipes(ncols);
+    for (t_uindex cidx = 0; cidx < ncols; ++cidx) {
+        auto& [colname, recipe] = recipes[cidx];
+        std::int32_t dtype;
+        manifest >> std::quoted(colname) >> dtype >> recipe.m_size
+            >> recipe.m_status_enabled >> recipe.m_vlenidx
+            >> recipe.m_data.m_size >> recipe.m_status.m_size
+            >> recipe.m_vlendata.m_size >> recipe.m_extents.m_size;
+
+        if (!manifest || !m_input_schema.has_column(colname)
+            || m_input_schema.get_dtype(colname) != dtype
+            || recipe.m_size != nrows) {
+            PSP_COMPLAIN_AND_ABORT("Snapshot does not match the table schema."
+            );
+        }
+
+        recipe.m_dtype = static_cast<t_dtype>(dtype);
+        std::string fname = snapshot_column_fname(dirname, cidx);
+        if (recipe.m_data.m_size < nrows * get_dtype_size(recipe.m_dtype)
+            || (recipe.m_status_enabled && recipe.m_status.m_size < nrows)
+            || !snapshot_store_matches(fname + ".data", recipe.m_data.m_size)
+            || !snapshot_store_matches(
+                fname + ".status", recipe.m_status.m_size
+            )
+            || !snapshot_store_matches(
+                fname + ".vlendata", recipe.m_vlendata.m_size
+            )
+            || !snapshot_store_matches(
+                fname + ".extents", recipe.m_extents.m_size
+            )) {
+            PSP_COMPLAIN_AND_ABORT("Snapshot column `" + colname
+                                   + "` is corrupt.");
+        }
+    }
+
+    m_table->reserve(nrows);
+    for (t_uindex cidx = 0; cidx < ncols; ++cidx) {
+        const auto& [colname, recipe] = recipes[cidx];
+        m_table->get_column(colname)->load(
+            snapshot_column_fname(dirname, cidx), recipe
+        );
+    }
+
+    m_table->set_size(nrows);
+    m_free.reserve(nfree);
+    m_free.insert(free_rows.begin(), free_rows.end());
+
+    // The mapping holds interned keys, so it is rebuilt through the symbol
+    // table rather than stored in the snapshot.
+    m_mapping.reserve(nrows - nfree);
+    for (t_uindex ridx = 0; ridx < nrows; ++ridx) {
+        if (m_free.find(ridx) != m_free.end()) {
+            continue;
+        }
+
+        t_tscalar pkey = m_pkcol->get_scalar(ridx);
+        m_mapping[m_symtable.get_interned_tscalar(pkey)] = ridx;
+    }
+
+    m_last_update_rows_changed = true;
+    m_last_update_all_columns = true;
+    enforce_resident_budget();
+}
+
 const t_schema&
 t_gstate::get_input_schema() const {
     return m_input_schema;
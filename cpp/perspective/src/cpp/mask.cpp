@@ -88,6 +88,11 @@ t_mask::operator-=(const t_mask& b) {
     return *this;
 }
 
+void
+t_mask::flip() {
+    m_bitmap.flip();
+}
+
 t_uindex
 t_mask::find_first() const {
     return m_bitmap.find_first();
@@ -0,0 +1,43 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/first.h>
+#include <perspective/memory_usage.h>
+
+namespace perspective {
+
+t_gnode_memory_usage::t_gnode_memory_usage() :
+    m_column_bytes(0),
+    m_vocab_bytes(0),
+    m_mapping_bytes(0),
+    m_expression_vocab_bytes(0),
+    m_port_bytes(0) {}
+
+t_uindex
+t_gnode_memory_usage::total() const {
+    return m_column_bytes + m_vocab_bytes + m_mapping_bytes
+        + m_expression_vocab_bytes + m_port_bytes;
+}
+
+t_ctx_memory_usage::t_ctx_memory_usage() :
+    m_tree_bytes(0),
+    m_traversal_bytes(0),
+    m_expression_bytes(0),
+    m_delta_bytes(0) {}
+
+t_uindex
+t_ctx_memory_usage::total() const {
+    return m_tree_bytes + m_traversal_bytes + m_expression_bytes
+        + m_delta_bytes;
+}
+
+} // end namespace perspective
@@ -0,0 +1,186 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/order_statistic.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace perspective {
+
+bool
+is_percentile_aggtype(t_aggtype agg) {
+    switch (agg) {
+        case AGGTYPE_MEDIAN:
+        case AGGTYPE_P25:
+        case AGGTYPE_P75:
+        case AGGTYPE_P90:
+        case AGGTYPE_P99: {
+            return true;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+}
+
+std::uint32_t
+get_aggtype_percentile(t_aggtype agg) {
+    switch (agg) {
+        case AGGTYPE_MEDIAN:
+        case AGGTYPE_APPROX_MEDIAN: {
+            return 50;
+        } break;
+        case AGGTYPE_P25: {
+            return 25;
+        } break;
+        case AGGTYPE_P75: {
+            return 75;
+        } break;
+        case AGGTYPE_P90:
+        case AGGTYPE_APPROX_P90: {
+            return 90;
+        } break;
+        case AGGTYPE_P99:
+        case AGGTYPE_APPROX_P99: {
+            return 99;
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Not a percentile aggregate");
+            return 0;
+        } break;
+    }
+}
+
+t_tscalar
+get_percentile(std::vector<t_tscalar>& values, std::uint32_t percentile) {
+    values.erase(
+        std::remove_if(
+            values.begin(),
+            values.end(),
+            [](const t_tscalar& value) { return value.is_nan(); }
+        ),
+        values.end()
+    );
+
+    t_uindex size = values.size();
+
+    if (size == 0) {
+        return {};
+    }
+
+    t_uindex rank = std::min(size - 1, t_uindex(percentile) * size / 100);
+    auto nth = values.begin() + rank;
+    std::nth_element(values.begin(), nth, values.end());
+
+    if (rank > 0 && nth->is_floating_point()
+        && (t_uindex(percentile) * size) % 100 == 0) {
+        // `nth_element` leaves the values before `nth` unordered.
+        auto prev = std::max_element(values.begin(), nth);
+        t_tscalar rval;
+        rval.set((*nth + *prev) / static_cast<t_tscalar>(2));
+        return rval;
+    }
+
+    return *nth;
+}
+
+t_order_statistic::t_order_statistic(std::uint32_t percentile) :
+    m_percentile(percentile) {}
+
+void
+t_order_statistic::insert(const t_tscalar& pkey, const t_tscalar& value) {
+    erase(pkey);
+    m_values[pkey] = value;
+
+    if (value.is_nan()) {
+        return;
+    }
+
+    if (!m_lower.empty() && value < *m_lower.rbegin()) {
+        m_lower.insert(value);
+    } else {
+        m_upper.insert(value);
+    }
+
+    rebalance();
+}
+
+void
+t_order_statistic::erase(const t_tscalar& pkey) {
+    auto iter = m_values.find(pkey);
+    if (iter == m_values.end()) {
+        return;
+    }
+
+    t_tscalar value = iter->second;
+    m_values.erase(iter);
+
+    if (value.is_nan()) {
+        return;
+    }
+
+    // Every value of the upper multiset is at least the largest value of
+    // the lower one, so a value no greater than it is always in the lower.
+    if (!m_lower.empty() && !(*m_lower.rbegin() < value)) {
+        m_lower.erase(m_lower.find(value));
+    } else {
+        m_upper.erase(m_upper.find(value));
+    }
+
+    rebalance();
+}
+
+t_tscalar
+t_order_statistic::value() const {
+    if (m_lower.empty()) {
+        return {};
+    }
+
+    t_uindex size = m_lower.size() + m_upper.size();
+    auto nth = std::prev(m_lower.end());
+
+    if (m_lower.size() > 1 && nth->is_floating_point()
+        && (t_uindex(m_percentile) * size) % 100 == 0) {
+        t_tscalar rval;
+        rval.set((*nth + *std::prev(nth)) / static_cast<t_tscalar>(2));
+        return rval;
+    }
+
+    return *nth;
+}
+
+t_uindex
+t_order_statistic::size() const {
+    return m_values.size();
+}
+
+void
+t_order_statistic::rebalance() {
+    t_uindex size = m_lower.size() + m_upper.size();
+    t_uindex target =
+        size == 0 ? 0 : std::min(size, t_uindex(m_percentile) * size / 100 + 1);
+
+    while (m_lower.size() > target) {
+        auto last = std::prev(m_lower.end());
+        m_upper.insert(m_upper.begin(), *last);
+        m_lower.erase(last);
+    }
+
+    while (m_lower.size() < target) {
+        auto first = m_upper.begin();
+        m_lower.insert(m_lower.end(), *first);
+        m_upper.erase(first);
+    }
+}
+
+} // end namespace perspective
@@ -12,7 +12,9 @@
 
 #include <perspective/first.h>
 #include <perspective/port.h>
+#include <perspective/env_vars.h>
 
+#include <algorithm>
 #include <utility>
 
 namespace perspective {
@@ -21,7 +23,9 @@ t_port::t_port(t_port_mode mode, t_schema schema) :
     m_schema(std::move(schema)),
     m_init(false),
     m_table(nullptr),
-    m_prevsize(0) {
+    m_prevsize(0),
+    m_high_water(0),
+    m_recycle_count(0) {
     LOG_CONSTRUCTOR("t_port");
 }
 
@@ -51,11 +55,13 @@ t_port::set_table(std::shared_ptr<t_data_table> table) {
 void
 t_port::send(const std::shared_ptr<const t_data_table>& table) {
     m_table->append(*table);
+    mark_updated_columns(*table);
 }
 
 void
 t_port::send(const t_data_table& table) {
     m_table->append(table);
+    mark_updated_columns(table);
 }
 
 t_schema
@@ -63,6 +69,36 @@ t_port::get_schema() const {
     return m_schema;
 }
 
+const tsl::hopscotch_set<std::string>&
+t_port::get_updated_columns() const {
+    return m_updated_columns;
+}
+
+void
+t_port::mark_updated_columns(const t_data_table& table) {
+    const t_schema& schema = table.get_schema();
+    bool has_removes = false;
+
+    auto op_col = table.get_const_column_safe("psp_op");
+    if (op_col && table.size() > 0) {
+        const auto* ops = op_col->get_nth<std::uint8_t>(0);
+        has_removes =
+            std::any_of(ops, ops + table.size(), [](std::uint8_t op) {
+                return static_cast<t_op>(op) == OP_DELETE;
+            });
+    }
+
+    for (const auto& colname : schema.m_columns) {
+        if (m_updated_columns.find(colname) != m_updated_columns.end()) {
+            continue;
+        }
+
+        if (has_removes || !table.get_const_column(colname)->all_invalid()) {
+            m_updated_columns.insert(colname);
+        }
+    }
+}
+
 void
 t_port::release()
 
@@ -78,6 +114,7 @@ t_port::release()
         "", "", m_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY
     );
     m_table->init();
+    m_updated_columns.clear();
 
     m_prevsize = size;
 }
@@ -90,10 +127,16 @@ t_port::release_or_clear()
         return;
     }
 
+    if (!t_env::disable_table_recycling()) {
+        recycle();
+        return;
+    }
+
     t_uindex size = m_table->size();
 
     if (static_cast<double>(size) < 0.4 * double(m_prevsize)) {
         m_table->clear();
+        m_updated_columns.clear();
     } else {
         release();
     }
@@ -108,6 +151,45 @@ t_port::clear() {
     }
 
     m_table->clear();
+    m_updated_columns.clear();
+}
+
+void
+t_port::conflate() {
+    if (m_table == nullptr || m_table->size() == 0) {
+        return;
+    }
+
+    m_table = m_table->flatten();
+}
+
+void
+t_port::recycle() {
+    if (m_table == nullptr) {
+        return;
+    }
+
+    t_uindex size = m_table->size();
+
+    m_table->clear_with_vocabularies();
+    m_updated_columns.clear();
+    m_prevsize = size;
+    m_high_water = std::max(m_high_water, size);
+
+    if (++m_recycle_count < DEFAULT_RECYCLE_WINDOW) {
+        return;
+    }
+
+    t_uindex target = std::max(
+        m_high_water, static_cast<t_uindex>(DEFAULT_EMPTY_CAPACITY)
+    );
+
+    if (m_table->get_capacity() > DEFAULT_RECYCLE_SHRINK_FACTOR * target) {
+        m_table->shrink(target);
+    }
+
+    m_high_water = 0;
+    m_recycle_count = 0;
 }
 
 } // end namespace perspective
@@ -43,4 +43,45 @@ t_process_state::set_size_transitional_data_tables(t_uindex size) const {
     m_existed_data_table->set_size(size);
 };
 
+t_transitional_needs::t_transitional_needs() : m_all(false) {}
+
+void
+t_transitional_needs::require(
+    const std::string& colname, std::uint8_t tables
+) {
+    if (m_all) {
+        return;
+    }
+
+    m_columns[colname] |= tables;
+}
+
+void
+t_transitional_needs::require_all() {
+    m_all = true;
+    m_columns.clear();
+}
+
+void
+t_transitional_needs::merge(const t_transitional_needs& other) {
+    if (other.m_all) {
+        require_all();
+        return;
+    }
+
+    for (const auto& [colname, tables] : other.m_columns) {
+        require(colname, tables);
+    }
+}
+
+std::uint8_t
+t_transitional_needs::get(const std::string& colname) const {
+    if (m_all) {
+        return TRANSITIONAL_TABLE_ALL;
+    }
+
+    auto iter = m_columns.find(colname);
+    return iter == m_columns.end() ? 0 : iter->second;
+}
+
 } // namespace perspective
\ No newline at end of file
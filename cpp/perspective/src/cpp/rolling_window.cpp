@@ -0,0 +1,277 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/rolling_window.h>
+
+#include <limits>
+
+namespace perspective {
+
+bool
+is_rolling_aggtype(t_aggtype agg) {
+    switch (agg) {
+        case AGGTYPE_ROLLING_SUM:
+        case AGGTYPE_ROLLING_COUNT:
+        case AGGTYPE_ROLLING_MEAN:
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN:
+        case AGGTYPE_ROLLING_MIN:
+        case AGGTYPE_ROLLING_MAX: {
+            return true;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+}
+
+bool
+is_rolling_order_dtype(t_dtype dtype) {
+    switch (dtype) {
+        case DTYPE_TIME:
+        case DTYPE_INT64:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8: {
+            return true;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+}
+
+// Whether `value` is neither null nor NaN.
+static bool
+is_present(const t_tscalar& value) {
+    return value.is_valid() && !value.is_none() && !value.is_nan();
+}
+
+bool
+t_rolling_window::t_order_less::operator()(
+    const t_order_entry& a, const t_order_entry& b
+) const {
+    return a < b;
+}
+
+bool
+t_rolling_window::t_order_less::operator()(
+    const t_order_entry& a, std::int64_t b
+) const {
+    return a.first < b;
+}
+
+bool
+t_rolling_window::t_order_less::operator()(
+    std::int64_t a, const t_order_entry& b
+) const {
+    return a < b.first;
+}
+
+t_rolling_window::t_rolling_window(t_aggtype agg, std::int64_t width) :
+    m_agg(agg),
+    m_width(width),
+    m_cutoff(std::numeric_limits<std::int64_t>::max()),
+    m_count(0),
+    m_sum(0),
+    m_weighted_sum(0),
+    m_weight(0) {}
+
+void
+t_rolling_window::insert(
+    const t_tscalar& pkey,
+    const t_tscalar& order,
+    const t_tscalar& value,
+    const t_tscalar& weight
+) {
+    erase(pkey);
+
+    t_row row;
+    row.m_has_order = is_present(order);
+    row.m_order = row.m_has_order ? order.to_int64() : 0;
+    row.m_value = value;
+    row.m_has_weight = is_present(weight);
+    row.m_weight = row.m_has_weight ? weight.to_double() : 0;
+    m_rows[pkey] = row;
+
+    // A row without an order value is never in the window.
+    if (!row.m_has_order) {
+        return;
+    }
+
+    m_order.insert({row.m_order, pkey});
+
+    if (row.m_order > m_cutoff) {
+        enter(row);
+    }
+
+    move_window();
+}
+
+void
+t_rolling_window::erase(const t_tscalar& pkey) {
+    auto iter = m_rows.find(pkey);
+    if (iter == m_rows.end()) {
+        return;
+    }
+
+    t_row row = iter->second;
+    m_rows.erase(iter);
+
+    if (!row.m_has_order) {
+        return;
+    }
+
+    if (row.m_order > m_cutoff) {
+        leave(row);
+    }
+
+    m_order.erase({row.m_order, pkey});
+    move_window();
+}
+
+t_tscalar
+t_rolling_window::value() const {
+    if (m_agg == AGGTYPE_ROLLING_COUNT) {
+        return mktscalar(static_cast<std::int64_t>(m_count));
+    }
+
+    if (m_count == 0) {
+        return mknone();
+    }
+
+    switch (m_agg) {
+        case AGGTYPE_ROLLING_SUM: {
+            return mktscalar(m_sum);
+        } break;
+        case AGGTYPE_ROLLING_MEAN: {
+            return mktscalar(m_sum / static_cast<double>(m_count));
+        } break;
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN: {
+            if (m_weight == 0) {
+                return mknone();
+            }
+
+            return mktscalar(m_weighted_sum / m_weight);
+        } break;
+        case AGGTYPE_ROLLING_MIN: {
+            return *m_values.begin();
+        } break;
+        case AGGTYPE_ROLLING_MAX: {
+            return *m_values.rbegin();
+        } break;
+        default: {
+            PSP_COMPLAIN_AND_ABORT("Not a rolling aggregate");
+            return mknone();
+        } break;
+    }
+}
+
+t_uindex
+t_rolling_window::size() const {
+    return m_rows.size();
+}
+
+void
+t_rolling_window::enter(const t_row& row) {
+    if (!is_present(row.m_value)) {
+        return;
+    }
+
+    ++m_count;
+
+    switch (m_agg) {
+        case AGGTYPE_ROLLING_SUM:
+        case AGGTYPE_ROLLING_MEAN: {
+            m_sum += row.m_value.to_double();
+        } break;
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN: {
+            if (row.m_has_weight) {
+                m_weighted_sum += row.m_value.to_double() * row.m_weight;
+                m_weight += row.m_weight;
+            }
+        } break;
+        case AGGTYPE_ROLLING_MIN:
+        case AGGTYPE_ROLLING_MAX: {
+            m_values.insert(row.m_value);
+        } break;
+        default: {
+        } break;
+    }
+}
+
+void
+t_rolling_window::leave(const t_row& row) {
+    if (!is_present(row.m_value)) {
+        return;
+    }
+
+    --m_count;
+
+    switch (m_agg) {
+        case AGGTYPE_ROLLING_SUM:
+        case AGGTYPE_ROLLING_MEAN: {
+            m_sum -= row.m_value.to_double();
+        } break;
+        case AGGTYPE_ROLLING_WEIGHTED_MEAN: {
+            if (row.m_has_weight) {
+                m_weighted_sum -= row.m_value.to_double() * row.m_weight;
+                m_weight -= row.m_weight;
+            }
+        } break;
+        case AGGTYPE_ROLLING_MIN:
+        case AGGTYPE_ROLLING_MAX: {
+            m_values.erase(m_values.find(row.m_value));
+        } break;
+        default: {
+        } break;
+    }
+
+    // Don't let rounding from adding and removing values outlive the rows
+    // that caused it.
+    if (m_count == 0) {
+        m_sum = 0;
+        m_weighted_sum = 0;
+        m_weight = 0;
+    }
+}
+
+void
+t_rolling_window::move_window() {
+    std::int64_t cutoff = std::numeric_limits<std::int64_t>::max();
+    if (!m_order.empty()) {
+        std::int64_t newest = m_order.rbegin()->first;
+        cutoff = newest < std::numeric_limits<std::int64_t>::min() + m_width
+            ? std::numeric_limits<std::int64_t>::min()
+            : newest - m_width;
+    }
+
+    if (cutoff > m_cutoff) {
+        // Rows in `(m_cutoff, cutoff]` leave the window.
+        auto end = m_order.upper_bound(cutoff);
+        for (auto iter = m_order.upper_bound(m_cutoff); iter != end; ++iter) {
+            leave(m_rows.at(iter->second));
+        }
+    } else if (cutoff < m_cutoff) {
+        // Rows in `(cutoff, m_cutoff]` enter the window.
+        auto end = m_order.upper_bound(m_cutoff);
+        for (auto iter = m_order.upper_bound(cutoff); iter != end; ++iter) {
+            enter(m_rows.at(iter->second));
+        }
+    }
+
+    m_cutoff = cutoff;
+}
+
+} // end namespace perspective
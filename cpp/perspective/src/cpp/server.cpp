@@ -15,6 +15,7 @@
 #include "perspective.pb.h"
 #include "perspective/base.h"
 #include "perspective/computed_expression.h"
+#include "perspective/env_vars.h"
 #include "perspective/exception.h"
 #include "perspective/pyutils.h"
 #include "perspective/raw_types.h"
@@ -25,9 +26,11 @@
 #include "perspective/view.h"
 #include "perspective/view_config.h"
 #include "re2/re2.h"
+#include <cctype>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <limits>
 #include <memory>
 #include <perspective/server.h>
@@ -37,6 +40,10 @@
 #include <tsl/ordered_map.h>
 #include <vector>
 #include <ctime>
+#include <fstream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 namespace perspective {
 std::uint32_t server::ProtoServer::m_client_id = 1;
@@ -389,6 +396,7 @@ ServerResources::host_view(
     m_view_to_table.emplace(id, table_id);
     m_table_to_view.emplace(table_id, id);
     m_views.emplace(id, std::move(view));
+    m_view_last_access[id] = std::chrono::steady_clock::now();
     if (!m_client_to_view.contains(client_id)) {
         std::vector vec{id};
         m_client_to_view.emplace(client_id, vec);
@@ -456,6 +464,9 @@ ServerResources::delete_view(const std::uint32_t& client_id, const t_id& id) {
             m_view_to_table.erase(id);
         }
 
+        m_view_last_access.erase(id);
+        m_suspended_views.erase(id);
+
         auto& vec = m_client_to_view[client_id];
         vec.erase(std::remove(vec.begin(), vec.end(), id), vec.end());
         auto range = m_table_to_view.equal_range(table_id);
@@ -478,6 +489,7 @@ ServerResources::delete_table(const t_id& id) {
     if (m_tables.find(id) != m_tables.end()) {
         if (m_table_to_view.find(id) == m_table_to_view.end()) {
             m_tables.erase(id);
+            m_table_schedules.erase(id);
         } else {
             std::cout << *m_table_to_view.find(id) << std::endl;
             PSP_COMPLAIN_AND_ABORT("Cannot delete table with views");
@@ -495,12 +507,55 @@ void
 ServerResources::mark_table_clean(const t_id& id) {
     PSP_WRITE_LOCK(m_write_lock);
     m_dirty_tables.erase(id);
+    auto schedule = m_table_schedules.find(id);
+    if (schedule != m_table_schedules.end()) {
+        schedule.value().last_processed = std::chrono::steady_clock::now();
+        schedule.value().conflated_size = 0;
+    }
 }
 
 void
-ServerResources::mark_all_tables_clean() {
+ServerResources::set_table_schedule(const t_id& id, TableSchedule schedule) {
     PSP_WRITE_LOCK(m_write_lock);
-    m_dirty_tables.clear();
+    m_table_schedules[id] = schedule;
+}
+
+bool
+ServerResources::defer_table(
+    const t_id& id, std::chrono::steady_clock::time_point now
+) {
+    std::shared_ptr<Table> table;
+    TableSchedule schedule;
+    {
+        PSP_READ_LOCK(m_write_lock);
+        auto iter = m_table_schedules.find(id);
+        if (iter == m_table_schedules.end()
+            || now - iter->second.last_processed
+                >= iter->second.min_interval) {
+            return false;
+        }
+
+        table = m_tables.at(id);
+        schedule = iter->second;
+    }
+
+    // Conflate each time the pending rows double, so a table that waits
+    // holds roughly one row per primary key and conflation stays linear in
+    // the rows sent. The pool lock is taken outside of `m_write_lock`.
+    auto gnode = table->get_gnode();
+    t_uindex pending = gnode->num_pending_rows();
+    if (pending > 2 * schedule.conflated_size) {
+        gnode->conflate_inputs();
+        pending = gnode->num_pending_rows();
+
+        PSP_WRITE_LOCK(m_write_lock);
+        auto iter = m_table_schedules.find(id);
+        if (iter != m_table_schedules.end()) {
+            iter.value().conflated_size = pending;
+        }
+    }
+
+    return schedule.max_batch_size == 0 || pending < schedule.max_batch_size;
 }
 
 void
@@ -615,6 +670,109 @@ ServerResources::get_view_on_update_sub(const t_id& view_id) {
     return m_view_on_update_subs.at(view_id);
 }
 
+bool
+ServerResources::hold_view_on_update_sub(
+    const t_id& view_id,
+    const Subscription& sub,
+    std::uint32_t port_id,
+    std::chrono::steady_clock::time_point now
+) {
+    if (sub.min_interval_ms == 0) {
+        return false;
+    }
+
+    PSP_WRITE_LOCK(m_write_lock);
+    auto subs = m_view_on_update_subs.find(view_id);
+    if (subs == m_view_on_update_subs.end()) {
+        return false;
+    }
+
+    for (auto& stored : subs.value()) {
+        if (stored.id != sub.id || stored.client_id != sub.client_id) {
+            continue;
+        }
+
+        if (now - stored.last_sent
+            < std::chrono::milliseconds(stored.min_interval_ms)) {
+            stored.pending_port_id = port_id;
+            return true;
+        }
+
+        stored.last_sent = now;
+        stored.pending_port_id.reset();
+        return false;
+    }
+
+    return false;
+}
+
+std::vector<std::pair<ServerResources::t_id, Subscription>>
+ServerResources::take_due_view_on_update_subs(
+    std::chrono::steady_clock::time_point now
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    std::vector<std::pair<t_id, Subscription>> out;
+    for (auto iter = m_view_on_update_subs.begin();
+         iter != m_view_on_update_subs.end();
+         ++iter) {
+        for (auto& sub : iter.value()) {
+            if (!sub.pending_port_id.has_value()
+                || now - sub.last_sent
+                    < std::chrono::milliseconds(sub.min_interval_ms)) {
+                continue;
+            }
+
+            out.emplace_back(iter->first, sub);
+            sub.last_sent = now;
+            sub.pending_port_id.reset();
+        }
+    }
+
+    return out;
+}
+
+bool
+ServerResources::touch_view(
+    const t_id& view_id, std::chrono::steady_clock::time_point now
+) {
+    PSP_WRITE_LOCK(m_write_lock);
+    if (!m_views.contains(view_id)) {
+        return false;
+    }
+
+    m_view_last_access[view_id] = now;
+    return m_suspended_views.erase(view_id) > 0;
+}
+
+std::vector<std::pair<ServerResources::t_id, ServerResources::t_id>>
+ServerResources::suspend_idle_views(std::chrono::steady_clock::time_point now
+) {
+    std::vector<std::pair<t_id, t_id>> out;
+    auto timeout = std::chrono::milliseconds(t_env::view_idle_timeout_ms());
+    if (timeout.count() == 0) {
+        return out;
+    }
+
+    PSP_WRITE_LOCK(m_write_lock);
+    for (const auto& [view_id, last_access] : m_view_last_access) {
+        if (now - last_access < timeout
+            || m_suspended_views.contains(view_id)) {
+            continue;
+        }
+
+        // Subscribed views are read on every update, so are never idle.
+        auto subs = m_view_on_update_subs.find(view_id);
+        if (subs != m_view_on_update_subs.end() && !subs->second.empty()) {
+            continue;
+        }
+
+        m_suspended_views.insert(view_id);
+        out.emplace_back(view_id, m_view_to_table.at(view_id));
+    }
+
+    return out;
+}
+
 void
 ServerResources::drop_view_on_update_sub(const t_id& view_id) {
     PSP_WRITE_LOCK(m_write_lock);
@@ -820,6 +978,91 @@ parse_format_options(
     return out;
 }
 
+#ifndef PSP_ENABLE_WASM
+/**
+ * @brief The resident set size of the process on Linux, read from
+ * `/proc/self/statm`. Other native targets (and Linux hosts without procfs)
+ * fall back to the bytes accounted by the engine.
+ */
+static double
+native_heap_size(t_uindex accounted_bytes) {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t total_pages = 0;
+    std::uint64_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return static_cast<double>(resident_pages)
+            * static_cast<double>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return static_cast<double>(accounted_bytes);
+}
+#endif
+
+static void
+stage_trace_to_proto(
+    const t_stage_trace& trace,
+    bool include_records,
+    proto::ServerProfileResp::Trace* out
+) {
+    auto stats = trace.get_stats();
+    for (t_uindex stage = 0; stage < stats.size(); ++stage) {
+        const auto& stage_stats = stats[stage];
+        if (stage_stats.m_count == 0) {
+            continue;
+        }
+
+        auto* s = out->add_stages();
+        s->set_stage(trace_stage_to_str(static_cast<t_trace_stage>(stage)));
+        s->set_count(stage_stats.m_count);
+        s->set_total_ns(stage_stats.m_total_ns);
+        s->set_max_ns(stage_stats.m_max_ns);
+        s->set_rows(stage_stats.m_rows);
+    }
+
+    if (include_records) {
+        for (const auto& record : trace.get_records()) {
+            auto* rec = out->add_records();
+            rec->set_stage(trace_stage_to_str(record.m_stage));
+            rec->set_seq(record.m_seq);
+            rec->set_start_ns(record.m_start_ns);
+            rec->set_duration_ns(record.m_duration_ns);
+            rec->set_rows(record.m_rows);
+        }
+    }
+
+    out->set_dropped(trace.get_num_dropped());
+}
+
+/**
+ * @brief The directory in the server's storage directory a client names as
+ * `name`. Names are restricted to a single path component, so clients can't
+ * reach outside of it. WebAssembly builds have no filesystem, so this
+ * always fails there.
+ */
+static std::string
+storage_path(const std::string& name) {
+    bool valid = !name.empty() && name.front() != '.';
+    for (char c : name) {
+        valid = valid
+            && (std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_'
+                || c == '-' || c == '.');
+    }
+
+    if (!valid) {
+        PSP_COMPLAIN_AND_ABORT("Invalid storage name `" + name + "`.");
+    }
+
+#ifdef PSP_ENABLE_WASM
+    PSP_COMPLAIN_AND_ABORT("`" + name + "` needs a server with a filesystem.");
+#endif
+
+    std::filesystem::path dir = t_env::storage_dir() != nullptr
+        ? std::filesystem::path(t_env::storage_dir())
+        : std::filesystem::temp_directory_path() / "perspective";
+    return (dir / name).string();
+}
+
 static constexpr bool
 needs_poll(const proto::Request::ClientReqCase proto_case) {
     using ReqCase = proto::Request::ClientReqCase;
@@ -843,6 +1086,7 @@ needs_poll(const proto::Request::ClientReqCase proto_case) {
         case ReqCase::kViewCollapseReq:
         case ReqCase::kViewExpandReq:
         case ReqCase::kViewSetDepthReq:
+        case ReqCase::kTableSaveSnapshotReq:
             return true;
         case ReqCase::kTableOnDeleteReq:
         case ReqCase::kViewOnDeleteReq:
@@ -858,7 +1102,9 @@ needs_poll(const proto::Request::ClientReqCase proto_case) {
         case ReqCase::kViewExpressionSchemaReq:
         case ReqCase::kViewRemoveOnUpdateReq:
         case ReqCase::kServerSystemInfoReq:
+        case ReqCase::kServerProfileReq:
         case ReqCase::kGetFeaturesReq:
+        case ReqCase::kLoadSnapshotReq:
             return false;
         case proto::Request::CLIENT_REQ_NOT_SET:
             throw std::runtime_error("Unhandled request type 2");
@@ -882,10 +1128,13 @@ entity_type_is_table(const proto::Request::ClientReqCase proto_case) {
         case ReqCase::kTableRemoveDeleteReq:
         case ReqCase::kGetHostedTablesReq:
         case ReqCase::kServerSystemInfoReq:
+        case ReqCase::kServerProfileReq:
         case ReqCase::kGetFeaturesReq:
         case ReqCase::kTableReplaceReq:
         case ReqCase::kTableDeleteReq:
         case ReqCase::kTableMakeViewReq:
+        case ReqCase::kTableSaveSnapshotReq:
+        case ReqCase::kLoadSnapshotReq:
             return true;
         case ReqCase::kViewOnDeleteReq:
         case ReqCase::kViewRemoveDeleteReq:
@@ -934,6 +1183,20 @@ ProtoServer::handle_process_table(
     }
 }
 
+void
+ProtoServer::resume_view(const Request& req) {
+    if (entity_type_is_table(req.client_req_case())
+        || req.client_req_case() == proto::Request::kViewDeleteReq) {
+        return;
+    }
+
+    const auto& view_id = req.entity_id();
+    if (m_resources.touch_view(view_id, std::chrono::steady_clock::now())) {
+        auto table = m_resources.get_table_for_view(view_id);
+        table->get_gnode()->resume_context(view_id);
+    }
+}
+
 static std::string_view
 view_sides_to_string(const ErasedView& view) {
     switch (view.sides()) {
@@ -1101,6 +1364,7 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
     };
 
     handle_process_table(req, proto_resp);
+    resume_view(req);
     switch (req.client_req_case()) {
         case proto::Request::kGetFeaturesReq: {
             proto::Response resp;
@@ -1195,6 +1459,21 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
                     break;
             }
 
+            t_storage_options storage;
+            if (r.storage().has_disk()) {
+                storage = t_storage_options(
+                    storage_path(r.storage().disk()),
+                    r.storage().resident_budget()
+                );
+            }
+
+            storage.m_compress_after_updates =
+                r.storage().compress_after_updates();
+            storage.m_indexed_columns.assign(
+                r.storage().indexed_columns().begin(),
+                r.storage().indexed_columns().end()
+            );
+
             switch (r.data().data_case()) {
                 case proto::MakeTableData::kFromView: {
                     auto view = m_resources.get_view(r.data().from_view());
@@ -1214,26 +1493,31 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
                         dims.end_col
                     );
 
-                    table = Table::from_arrow(index, *arrow, limit);
+                    table = Table::from_arrow(index, *arrow, limit, storage);
                     break;
                 }
                 case proto::MakeTableData::kFromArrow: {
-                    table =
-                        Table::from_arrow(index, r.data().from_arrow(), limit);
+                    table = Table::from_arrow(
+                        index, r.data().from_arrow(), limit, storage
+                    );
                     break;
                 }
                 case proto::MakeTableData::kFromCsv: {
-                    table = Table::from_csv(index, r.data().from_csv(), limit);
+                    table = Table::from_csv(
+                        index, r.data().from_csv(), limit, storage
+                    );
                     break;
                 }
                 case proto::MakeTableData::kFromCols: {
-                    table =
-                        Table::from_cols(index, r.data().from_cols(), limit);
+                    table = Table::from_cols(
+                        index, r.data().from_cols(), limit, storage
+                    );
                     break;
                 }
                 case proto::MakeTableData::kFromRows: {
-                    table =
-                        Table::from_rows(index, r.data().from_rows(), limit);
+                    table = Table::from_rows(
+                        index, r.data().from_rows(), limit, storage
+                    );
                     break;
                 }
                 case proto::MakeTableData::kFromSchema: {
@@ -1246,7 +1530,9 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
                     }
 
                     t_schema table_schema(columns, types);
-                    table = Table::from_schema(index, table_schema, limit);
+                    table = Table::from_schema(
+                        index, table_schema, limit, storage
+                    );
                     break;
                 }
                 case proto::MakeTableData::DATA_NOT_SET: {
@@ -1255,7 +1541,22 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
                 }
             }
 
+            if (r.has_retention()) {
+                table->set_retention(
+                    r.retention().column(), r.retention().ttl()
+                );
+            }
+
             m_resources.host_table(req.entity_id(), table);
+            if (r.has_update_policy()) {
+                TableSchedule schedule;
+                schedule.min_interval = std::chrono::milliseconds(
+                    r.update_policy().min_interval_ms()
+                );
+                schedule.max_batch_size = r.update_policy().max_batch_size();
+                m_resources.set_table_schedule(req.entity_id(), schedule);
+            }
+
             proto::Response resp;
             resp.mutable_make_table_resp();
             push_resp(std::move(resp));
@@ -2204,10 +2505,21 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
             Subscription sub_info;
             sub_info.id = req.msg_id();
             sub_info.client_id = client_id;
-            m_resources.create_view_on_update_sub(req.entity_id(), sub_info);
-            if (req.view_on_update_req().has_mode()
+            if (req.view_on_update_req().has_viewport()) {
+                sub_info.viewport = req.view_on_update_req().viewport();
+            }
+
+            bool is_row_mode = req.view_on_update_req().has_mode()
                 && req.view_on_update_req().mode()
-                    == proto::ViewOnUpdateReq_Mode::ViewOnUpdateReq_Mode_ROW) {
+                    == proto::ViewOnUpdateReq_Mode::ViewOnUpdateReq_Mode_ROW;
+
+            if (!is_row_mode) {
+                sub_info.min_interval_ms =
+                    req.view_on_update_req().min_interval_ms();
+            }
+
+            m_resources.create_view_on_update_sub(req.entity_id(), sub_info);
+            if (is_row_mode) {
                 auto view = m_resources.get_view(req.entity_id());
                 view->set_deltas_enabled(true);
             }
@@ -2262,17 +2574,112 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
         case proto::Request::kServerSystemInfoReq: {
             proto::Response resp;
             auto* sys_info = resp.mutable_server_system_info_resp();
+            t_uindex accounted_bytes = 0;
+            for (const auto& table_id : m_resources.get_table_ids()) {
+                auto table = m_resources.get_table(table_id);
+                auto* table_memory = sys_info->add_tables();
+                table_memory->set_table_id(table_id);
+                auto usage = table->get_gnode()->get_memory_usage();
+                table_memory->set_column_bytes(usage.m_column_bytes);
+                table_memory->set_vocab_bytes(usage.m_vocab_bytes);
+                table_memory->set_mapping_bytes(usage.m_mapping_bytes);
+                table_memory->set_expression_vocab_bytes(
+                    usage.m_expression_vocab_bytes
+                );
+                table_memory->set_port_bytes(usage.m_port_bytes);
+                t_uindex table_total = usage.total();
+
+                for (const auto& view_id : m_resources.get_view_ids(table_id)) {
+                    auto view = m_resources.get_view(view_id);
+                    auto* view_memory = table_memory->add_views();
+                    view_memory->set_view_id(view_id);
+                    auto view_usage = view->get_memory_usage();
+                    view_memory->set_tree_bytes(view_usage.m_tree_bytes);
+                    view_memory->set_traversal_bytes(
+                        view_usage.m_traversal_bytes
+                    );
+                    view_memory->set_expression_bytes(
+                        view_usage.m_expression_bytes
+                    );
+                    view_memory->set_delta_bytes(view_usage.m_delta_bytes);
+                    view_memory->set_total_bytes(view_usage.total());
+                    table_total += view_usage.total();
+                }
+
+                table_memory->set_total_bytes(table_total);
+                accounted_bytes += table_total;
+            }
+
 #ifdef PSP_ENABLE_WASM
             auto heap_size = psp_heap_size();
             sys_info->set_heap_size(heap_size);
 #else
-            PSP_COMPLAIN_AND_ABORT(
-                "ServerSystemInfoReq not implemented for non-emscripten targets"
-            );
+            sys_info->set_heap_size(native_heap_size(accounted_bytes));
 #endif
             push_resp(std::move(resp));
             break;
         }
+        case proto::Request::kServerProfileReq: {
+            const auto& r = req.server_profile_req();
+            proto::Response resp;
+            auto* profile = resp.mutable_server_profile_resp();
+            for (const auto& table_id : m_resources.get_table_ids()) {
+                auto table = m_resources.get_table(table_id);
+                auto* table_profile = profile->add_tables();
+                table_profile->set_table_id(table_id);
+                auto& table_trace = table->get_gnode()->get_trace();
+                stage_trace_to_proto(
+                    table_trace,
+                    r.include_records(),
+                    table_profile->mutable_trace()
+                );
+
+                if (r.reset()) {
+                    table_trace.clear();
+                }
+
+                for (const auto& view_id : m_resources.get_view_ids(table_id)) {
+                    auto view = m_resources.get_view(view_id);
+                    auto* view_profile = table_profile->add_views();
+                    view_profile->set_view_id(view_id);
+                    auto& view_trace = view->get_trace();
+                    stage_trace_to_proto(
+                        view_trace,
+                        r.include_records(),
+                        view_profile->mutable_trace()
+                    );
+
+                    if (r.reset()) {
+                        view_trace.clear();
+                    }
+                }
+            }
+
+            push_resp(std::move(resp));
+            break;
+        }
+        case proto::Request::kTableSaveSnapshotReq: {
+            auto table = m_resources.get_table(req.entity_id());
+            table->save_snapshot(
+                storage_path(req.table_save_snapshot_req().name())
+            );
+
+            proto::Response resp;
+            resp.mutable_table_save_snapshot_resp();
+            push_resp(std::move(resp));
+            break;
+        }
+        case proto::Request::kLoadSnapshotReq: {
+            auto table = Table::from_snapshot(
+                storage_path(req.load_snapshot_req().name())
+            );
+
+            m_resources.host_table(req.entity_id(), table);
+            proto::Response resp;
+            resp.mutable_load_snapshot_resp();
+            push_resp(std::move(resp));
+            break;
+        }
         case proto::Request::CLIENT_REQ_NOT_SET: {
             PSP_COMPLAIN_AND_ABORT("Client request unknown variant")
             break;
@@ -2285,12 +2692,40 @@ ProtoServer::_handle_request(std::uint32_t client_id, const Request& req) {
 std::vector<ProtoServerResp<ProtoServer::Response>>
 ProtoServer::_poll() {
     std::vector<ProtoServerResp<Response>> resp_envs;
+    auto now = std::chrono::steady_clock::now();
+    // Idle views skip notification until they are next read.
+    for (const auto& [view_id, table_id] : m_resources.suspend_idle_views(now)
+    ) {
+        auto table = m_resources.get_table(table_id);
+        table->get_gnode()->suspend_context(view_id);
+    }
+
     auto tables = m_resources.get_dirty_tables();
     for (auto& [table, table_id] : tables) {
+        // A table with an update policy stays dirty until it is due.
+        if (m_resources.defer_table(table_id, now)) {
+            continue;
+        }
+
         _process_table_unchecked(table, table_id, resp_envs);
+        m_resources.mark_table_clean(table_id);
+    }
+
+    // Send the updates held back by subscriptions' `min_interval_ms`.
+    for (auto& [view_id, sub] : m_resources.take_due_view_on_update_subs(now)
+    ) {
+        Response out;
+        out.set_msg_id(sub.id);
+        out.set_entity_id(view_id);
+        auto* r = out.mutable_view_on_update_resp();
+        r->set_port_id(*sub.pending_port_id);
+
+        ProtoServerResp<proto::Response> resp;
+        resp.data = std::move(out);
+        resp.client_id = sub.client_id;
+        resp_envs.emplace_back(std::move(resp));
     }
 
-    m_resources.mark_all_tables_clean();
     return resp_envs;
 }
 
@@ -2306,14 +2741,73 @@ ProtoServer::_process_table_unchecked(
         for (const auto& view_id : view_ids) {
             auto view = m_resources.get_view(view_id);
             auto subscriptions = m_resources.get_view_on_update_sub(view_id);
-            for (auto& subscription : subscriptions) {
+            std::vector<std::shared_ptr<std::string>> deltas(
+                subscriptions.size()
+            );
+
+            if (view->get_deltas_enabled()) {
+                // Viewport-scoped deltas read the pivoted context's deltas
+                // without clearing them, so they must be served before the
+                // full delta, which clears them.
+                bool has_windowed_delta = false;
+                for (std::size_t i = 0; i < subscriptions.size(); ++i) {
+                    const auto& viewport = subscriptions[i].viewport;
+                    if (!viewport.has_value() || view->sides() == 0) {
+                        continue;
+                    }
+
+                    auto config = view->get_view_config();
+                    auto dims = parse_format_options(
+                        *viewport,
+                        view->num_columns(),
+                        view->num_rows(),
+                        view->sides(),
+                        config->is_column_only(),
+                        calculate_num_hidden(*view, *config)
+                    );
+
+                    deltas[i] = view->get_row_delta_as_arrow(
+                        dims.start_row,
+                        dims.end_row,
+                        dims.start_col,
+                        dims.end_col
+                    );
+                    has_windowed_delta = true;
+                }
+
+                std::shared_ptr<std::string> full_delta;
+                for (auto& delta : deltas) {
+                    if (delta == nullptr) {
+                        if (full_delta == nullptr) {
+                            full_delta = view->get_row_delta_as_arrow();
+                        }
+
+                        delta = full_delta;
+                    }
+                }
+
+                if (has_windowed_delta && full_delta == nullptr) {
+                    view->clear_deltas();
+                }
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < subscriptions.size(); ++i) {
+                const auto& subscription = subscriptions[i];
+                if (deltas[i] == nullptr
+                    && m_resources.hold_view_on_update_sub(
+                        view_id, subscription, port_id, now
+                    )) {
+                    continue;
+                }
+
                 Response out;
                 out.set_msg_id(subscription.id);
                 out.set_entity_id(view_id);
                 auto* r = out.mutable_view_on_update_resp();
                 r->set_port_id(port_id);
-                if (view->get_deltas_enabled()) {
-                    *r->mutable_delta() = *view->get_row_delta_as_arrow();
+                if (deltas[i] != nullptr) {
+                    *r->mutable_delta() = *deltas[i];
                 }
 
                 ProtoServerResp<proto::Response> resp2;
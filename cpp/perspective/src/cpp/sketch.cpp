@@ -0,0 +1,324 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/sketch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace perspective {
+
+static const t_uindex HLL_NUM_REGISTERS = t_uindex(1) << DEFAULT_HLL_PRECISION;
+
+// Beyond this many distinct hashes, the registers take less memory.
+static const t_uindex HLL_MAX_EXACT = HLL_NUM_REGISTERS / 8;
+
+static const double PI = 3.14159265358979323846;
+
+/**
+ * @brief The splitmix64 finalizer, so that consecutive integers and short
+ * strings spread over every bit of the hash.
+ */
+static std::uint64_t
+mix_hash(std::uint64_t hash) {
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+/**
+ * @brief A 64-bit hash of a scalar that, like `hash_value`, distinguishes
+ * scalars by value, dtype and status. `std::hash` is only 32 bits wide on
+ * WebAssembly, which is too few to count tens of millions of values.
+ */
+static std::uint64_t
+hash_scalar(const t_tscalar& value) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+
+    if (value.m_type == DTYPE_STR) {
+        const char* c = value.get_char_ptr();
+        for (t_uindex idx = 0, loop_end = std::strlen(c); idx < loop_end;
+             ++idx) {
+            hash ^= static_cast<unsigned char>(c[idx]);
+            hash *= 0x100000001b3ULL;
+        }
+    } else {
+        hash ^= value.m_data.m_uint64;
+    }
+
+    hash ^= (std::uint64_t(value.m_type) << 8 | value.m_status)
+        * 0x9e3779b97f4a7c15ULL;
+    return mix_hash(hash);
+}
+
+bool
+is_sketch_aggtype(t_aggtype agg) {
+    switch (agg) {
+        case AGGTYPE_APPROX_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_MEDIAN:
+        case AGGTYPE_APPROX_P90:
+        case AGGTYPE_APPROX_P99: {
+            return true;
+        } break;
+        default: {
+            return false;
+        } break;
+    }
+}
+
+t_hyperloglog::t_hyperloglog() = default;
+
+void
+t_hyperloglog::add(const t_tscalar& value) {
+    add_hash(hash_scalar(value));
+}
+
+void
+t_hyperloglog::add_hash(std::uint64_t hash) {
+    if (m_registers.empty()) {
+        m_hashes.push_back(hash);
+        if (m_hashes.size() > 2 * HLL_MAX_EXACT) {
+            compact();
+        }
+
+        return;
+    }
+
+    t_uindex idx = hash >> (64 - DEFAULT_HLL_PRECISION);
+    std::uint64_t rest = hash << DEFAULT_HLL_PRECISION;
+
+    // The position of the first set bit after the register index.
+    std::uint8_t rank = 1;
+    while (rank <= 64 - DEFAULT_HLL_PRECISION && (rest >> 63) == 0) {
+        rest <<= 1;
+        ++rank;
+    }
+
+    m_registers[idx] = std::max(m_registers[idx], rank);
+}
+
+void
+t_hyperloglog::compact() {
+    std::sort(m_hashes.begin(), m_hashes.end());
+    m_hashes.erase(
+        std::unique(m_hashes.begin(), m_hashes.end()), m_hashes.end()
+    );
+
+    if (m_hashes.size() > HLL_MAX_EXACT) {
+        to_dense();
+    }
+}
+
+void
+t_hyperloglog::to_dense() {
+    std::vector<std::uint64_t> hashes;
+    std::swap(hashes, m_hashes);
+    m_registers.assign(HLL_NUM_REGISTERS, 0);
+
+    for (auto hash : hashes) {
+        add_hash(hash);
+    }
+}
+
+void
+t_hyperloglog::merge(const t_hyperloglog& other) {
+    if (other.m_registers.empty()) {
+        for (auto hash : other.m_hashes) {
+            add_hash(hash);
+        }
+
+        return;
+    }
+
+    if (m_registers.empty()) {
+        to_dense();
+    }
+
+    for (t_uindex idx = 0; idx < HLL_NUM_REGISTERS; ++idx) {
+        m_registers[idx] = std::max(m_registers[idx], other.m_registers[idx]);
+    }
+}
+
+std::uint64_t
+t_hyperloglog::estimate() const {
+    if (m_registers.empty()) {
+        std::vector<std::uint64_t> hashes(m_hashes);
+        std::sort(hashes.begin(), hashes.end());
+        return std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+    }
+
+    double m = HLL_NUM_REGISTERS;
+    double sum = 0;
+    t_uindex zeros = 0;
+
+    for (auto reg : m_registers) {
+        sum += std::ldexp(1.0, -reg);
+        zeros += reg == 0;
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+
+    // Linear counting is more accurate while many registers are empty.
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(m / double(zeros));
+    }
+
+    return static_cast<std::uint64_t>(std::llround(estimate));
+}
+
+t_tdigest::t_tdigest() :
+    m_num_merged(0),
+    m_min(std::numeric_limits<double>::infinity()),
+    m_max(-std::numeric_limits<double>::infinity()) {}
+
+void
+t_tdigest::add(const t_tscalar& value) {
+    if (!value.is_valid() || !value.is_numeric() || value.is_nan()) {
+        return;
+    }
+
+    double v = value.to_double();
+    m_centroids.emplace_back(v, 1.0);
+    m_min = std::min(m_min, v);
+    m_max = std::max(m_max, v);
+
+    if (m_centroids.size() > m_num_merged + 5 * DEFAULT_TDIGEST_COMPRESSION) {
+        compress();
+    }
+}
+
+void
+t_tdigest::merge(const t_tdigest& other) {
+    m_centroids.insert(
+        m_centroids.end(), other.m_centroids.begin(), other.m_centroids.end()
+    );
+
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    compress();
+}
+
+void
+t_tdigest::compress() {
+    if (m_centroids.size() <= 1) {
+        m_num_merged = m_centroids.size();
+        return;
+    }
+
+    std::sort(m_centroids.begin(), m_centroids.end());
+
+    double total = 0;
+    for (const auto& centroid : m_centroids) {
+        total += centroid.second;
+    }
+
+    // The k1 scale function, which allows smaller centroids at the tails.
+    double delta = DEFAULT_TDIGEST_COMPRESSION;
+    auto q_limit = [&](double q) {
+        double k = delta / (2 * PI) * std::asin(2 * q - 1) + 1;
+        if (k >= delta / 4) {
+            return 1.0;
+        }
+
+        return (std::sin(k * 2 * PI / delta) + 1) / 2;
+    };
+
+    std::vector<std::pair<double, double>> merged;
+    auto current = m_centroids[0];
+    double weight_so_far = 0;
+    double limit = q_limit(0);
+
+    for (t_uindex idx = 1, loop_end = m_centroids.size(); idx < loop_end;
+         ++idx) {
+        const auto& next = m_centroids[idx];
+        double q = (weight_so_far + current.second + next.second) / total;
+
+        if (q <= limit) {
+            double weight = current.second + next.second;
+            current.first +=
+                (next.first - current.first) * next.second / weight;
+            current.second = weight;
+        } else {
+            weight_so_far += current.second;
+            merged.push_back(current);
+            current = next;
+            limit = q_limit(weight_so_far / total);
+        }
+    }
+
+    merged.push_back(current);
+    std::swap(m_centroids, merged);
+    m_num_merged = m_centroids.size();
+}
+
+t_tscalar
+t_tdigest::quantile(double q) const {
+    t_tscalar rval;
+    rval.set(t_none());
+
+    if (m_centroids.empty()) {
+        return rval;
+    }
+
+    // Values added since the last compression are still unsorted.
+    t_tdigest compressed;
+    const t_tdigest* digest = this;
+    if (m_num_merged != m_centroids.size()) {
+        compressed = *this;
+        compressed.compress();
+        digest = &compressed;
+    }
+
+    const auto& centroids = digest->m_centroids;
+
+    double total = 0;
+    for (const auto& centroid : centroids) {
+        total += centroid.second;
+    }
+
+    // Interpolate between the centers of adjacent centroids, and between
+    // the outermost centers and the minimum and maximum.
+    double target = std::min(std::max(q, 0.0), 1.0) * total;
+    double prev_center = 0;
+    double prev_mean = m_min;
+    double cumulative = 0;
+
+    for (const auto& centroid : centroids) {
+        double center = cumulative + centroid.second / 2;
+        if (target < center) {
+            double frac = (target - prev_center) / (center - prev_center);
+            rval.set(prev_mean + frac * (centroid.first - prev_mean));
+            return rval;
+        }
+
+        prev_center = center;
+        prev_mean = centroid.first;
+        cumulative += centroid.second;
+    }
+
+    if (total > prev_center) {
+        double frac = (target - prev_center) / (total - prev_center);
+        rval.set(prev_mean + frac * (m_max - prev_mean));
+    } else {
+        rval.set(m_max);
+    }
+
+    return rval;
+}
+
+} // end namespace perspective
@@ -30,6 +30,7 @@
 #include <perspective/data_table.h>
 #include <perspective/filter_utils.h>
 #include <perspective/context_two.h>
+#include <perspective/memory_usage.h>
 #include <set>
 #include <utility>
 
@@ -91,9 +92,23 @@ t_stree::t_stree(
     m_aggspecs(aggspecs),
     m_schema(std::move(schema)),
     m_cur_aggidx(1),
-    m_has_delta(false) {
+    m_has_delta(false),
+    m_has_order_stats(false),
+    m_has_rolling_windows(false) {
     const auto& g_agg_str = cfg.get_grand_agg_str();
     m_grand_agg_str = g_agg_str.empty() ? "Grand Aggregate" : g_agg_str;
+
+    if (!t_env::disable_incremental_percentiles()) {
+        for (const auto& spec : m_aggspecs) {
+            m_has_order_stats =
+                m_has_order_stats || is_percentile_aggtype(spec.agg());
+        }
+    }
+
+    for (const auto& spec : m_aggspecs) {
+        m_has_rolling_windows =
+            m_has_rolling_windows || is_rolling_aggtype(spec.agg());
+    }
 }
 
 t_stree::~t_stree() {
@@ -810,6 +825,10 @@ t_stree::populate_pkey_idx(
             if (strand_count < 0) {
                 remove_pkey(sptidx, pkey);
             }
+
+            if (m_has_order_stats || m_has_rolling_windows) {
+                m_order_stat_events.push_back({sptidx, pkey, strand_count});
+            }
         }
     }
 }
@@ -820,6 +839,8 @@ t_stree::update_shape_from_static(const t_dtree_ctx& ctx) {
     m_newids.clear();
     m_newleaves.clear();
     m_tree_unification_records.clear();
+    m_order_stat_events.clear();
+    m_order_stat_node_events.clear();
 
     const std::shared_ptr<const t_column> scount =
         ctx.get_aggtable().get_const_column("psp_strand_count_sum");
@@ -948,6 +969,16 @@ t_stree::update_shape_from_static(const t_dtree_ctx& ctx) {
         m_idxpkey->insert(s);
     }
 
+    // Index the rows applied by this update by every node above their leaf,
+    // while the leaves of rows that were removed are still in the tree.
+    for (t_uindex eidx = 0, loop_end = m_order_stat_events.size();
+         eidx < loop_end;
+         ++eidx) {
+        for (auto nidx : get_ancestry(m_order_stat_events[eidx].m_lfidx)) {
+            m_order_stat_node_events[nidx].push_back(eidx);
+        }
+    }
+
     mark_zero_desc();
 }
 
@@ -973,7 +1004,8 @@ void
 t_stree::update_aggs_from_static(
     const t_dtree_ctx& ctx,
     const t_gstate& gstate,
-    const t_data_table& expression_master_table
+    const t_data_table& expression_master_table,
+    const tsl::hopscotch_set<std::string>& unchanged_aggregates
 ) {
     const t_data_table& src_aggtable = ctx.get_aggtable();
 
@@ -1004,8 +1036,17 @@ t_stree::update_aggs_from_static(
     static bool const enable_aggregate_reordering = true;
     static bool const enable_fix_double_calculation = true;
 
+    // Sketch aggregates merge the sketches of each node's children, so are
+    // updated in a separate, bottom-up pass.
+    std::vector<t_uindex> sketch_cols;
+
     tsl::hopscotch_set<t_column*> dst_visited;
     auto push_column = [&](size_t idx) {
+        if (unchanged_aggregates.find(agg_update_info.m_aggspecs[idx].name())
+            != unchanged_aggregates.end()) {
+            return;
+        }
+
         if (enable_fix_double_calculation) {
             t_column* dst = agg_update_info.m_dst[idx];
             if (dst_visited.find(dst) != dst_visited.end()) {
@@ -1013,6 +1054,12 @@ t_stree::update_aggs_from_static(
             }
             dst_visited.insert(dst);
         }
+
+        if (is_sketch_aggtype(agg_update_info.m_aggspecs[idx].agg())) {
+            sketch_cols.push_back(idx);
+            return;
+        }
+
         cols_topo_sorted.push_back(idx);
     };
 
@@ -1052,6 +1099,298 @@ t_stree::update_aggs_from_static(
             expression_master_table
         );
     }
+
+    if (sketch_cols.empty()) {
+        return;
+    }
+
+    // Records are in pre-order, so in reverse every node follows its
+    // updated children.
+    for (auto riter = m_tree_unification_records.rbegin();
+         riter != m_tree_unification_records.rend();
+         ++riter) {
+        if (!node_exists(riter->m_sptidx)) {
+            continue;
+        }
+
+        for (auto idx : sketch_cols) {
+            update_sketch_aggregate(
+                riter->m_sptidx,
+                idx,
+                riter->m_saggidx,
+                agg_update_info,
+                gstate,
+                expression_master_table
+            );
+        }
+    }
+}
+
+template <typename SKETCH_T>
+SKETCH_T
+t_stree::build_sketch(
+    t_uindex nidx,
+    const tsl::hopscotch_map<t_uindex, SKETCH_T>& sketches,
+    const std::string& colname,
+    const t_gstate& gstate,
+    const t_data_table& expression_master_table
+) const {
+    if (!is_leaf(nidx)) {
+        SKETCH_T rval;
+        bool merged = true;
+
+        for (auto child : get_children(nidx)) {
+            auto iter = sketches.find(child);
+            if (iter == sketches.end()) {
+                merged = false;
+                break;
+            }
+
+            rval.merge(iter->second);
+        }
+
+        if (merged) {
+            return rval;
+        }
+    }
+
+    // Leaves, and nodes with a child that has not been sketched yet, are
+    // sketched from their rows.
+    SKETCH_T rval;
+    auto pkeys = get_pkeys(nidx);
+    std::vector<t_tscalar> values;
+    read_column_from_gstate(
+        gstate, expression_master_table, colname, pkeys, values
+    );
+
+    for (const auto& value : values) {
+        rval.add(value);
+    }
+
+    return rval;
+}
+
+void
+t_stree::update_sketch_aggregate(
+    t_uindex nidx,
+    t_uindex aggidx,
+    t_uindex dst_ridx,
+    t_agg_update_info& info,
+    const t_gstate& gstate,
+    const t_data_table& expression_master_table
+) {
+    const t_aggspec& spec = info.m_aggspecs[aggidx];
+    const std::string& colname = spec.get_dependencies()[0].name();
+    t_column* dst = info.m_dst[aggidx];
+    t_tscalar old_value = mknone();
+    t_tscalar new_value = mknone();
+    old_value.set(dst->get_scalar(dst_ridx));
+
+    if (spec.agg() == AGGTYPE_APPROX_DISTINCT_COUNT) {
+        if (m_distinct_sketches.size() <= aggidx) {
+            m_distinct_sketches.resize(aggidx + 1);
+        }
+
+        auto& sketches = m_distinct_sketches[aggidx];
+        auto sketch = build_sketch(
+            nidx, sketches, colname, gstate, expression_master_table
+        );
+
+        new_value.set(static_cast<std::uint32_t>(sketch.estimate()));
+        sketches[nidx] = std::move(sketch);
+    } else {
+        if (m_quantile_sketches.size() <= aggidx) {
+            m_quantile_sketches.resize(aggidx + 1);
+        }
+
+        auto& sketches = m_quantile_sketches[aggidx];
+        auto sketch = build_sketch(
+            nidx, sketches, colname, gstate, expression_master_table
+        );
+
+        new_value.set(
+            sketch.quantile(get_aggtype_percentile(spec.agg()) / 100.0)
+        );
+        sketches[nidx] = std::move(sketch);
+    }
+
+    if (new_value.is_none()) {
+        dst->set_valid(dst_ridx, false);
+    } else {
+        dst->set_scalar(dst_ridx, new_value);
+    }
+
+    bool val_neq = old_value != new_value;
+
+    m_has_delta = m_has_delta || val_neq;
+    bool deltas_enabled = m_features.at(CTX_FEAT_DELTA);
+    if (deltas_enabled && val_neq) {
+        m_deltas->insert(t_tcdelta(nidx, aggidx, old_value, new_value));
+    }
+}
+
+t_tscalar
+t_stree::update_order_statistic(
+    t_uindex nidx,
+    t_uindex aggidx,
+    const t_aggspec& spec,
+    const t_gstate& gstate,
+    const t_data_table& expression_master_table
+) {
+    if (m_order_stats.size() <= aggidx) {
+        m_order_stats.resize(aggidx + 1);
+    }
+
+    auto& stats = m_order_stats[aggidx];
+    const std::string& colname = spec.get_dependencies()[0].name();
+    auto iter = stats.find(nidx);
+
+    // Rows to read the current values of, and those that left the node.
+    std::vector<t_tscalar> pkeys;
+    std::vector<t_tscalar> removed;
+
+    if (iter == stats.end()) {
+        // The node's rows already include those applied by this update.
+        iter = stats
+                   .emplace(
+                       nidx,
+                       t_order_statistic(get_aggtype_percentile(spec.agg()))
+                   )
+                   .first;
+        pkeys = get_pkeys(nidx);
+    } else if (!get_node_row_changes(nidx, pkeys, removed)) {
+        return iter->second.value();
+    }
+
+    std::vector<t_tscalar> values;
+    read_column_from_gstate(
+        gstate, expression_master_table, colname, pkeys, values
+    );
+
+    t_order_statistic& stat = iter.value();
+
+    for (const auto& pkey : removed) {
+        stat.erase(pkey);
+    }
+
+    for (t_uindex idx = 0, loop_end = pkeys.size(); idx < loop_end; ++idx) {
+        stat.insert(pkeys[idx], m_symtable.get_interned_tscalar(values[idx]));
+    }
+
+    return stat.value();
+}
+
+t_tscalar
+t_stree::update_rolling_window(
+    t_uindex nidx,
+    t_uindex aggidx,
+    const t_aggspec& spec,
+    bool rebuild,
+    const t_gstate& gstate,
+    const t_data_table& expression_master_table
+) {
+    if (m_rolling_windows.size() <= aggidx) {
+        m_rolling_windows.resize(aggidx + 1);
+    }
+
+    auto& windows = m_rolling_windows[aggidx];
+    const auto& deps = spec.get_dependencies();
+    auto iter = windows.find(nidx);
+
+    if (rebuild && iter != windows.end()) {
+        windows.erase(iter);
+        iter = windows.end();
+    }
+
+    std::vector<t_tscalar> pkeys;
+    std::vector<t_tscalar> removed;
+
+    if (iter == windows.end()) {
+        iter = windows
+                   .emplace(
+                       nidx, t_rolling_window(spec.agg(), spec.get_window())
+                   )
+                   .first;
+        pkeys = get_pkeys(nidx);
+    } else if (!get_node_row_changes(nidx, pkeys, removed)) {
+        return iter->second.value();
+    }
+
+    std::vector<t_tscalar> orders;
+    std::vector<t_tscalar> values;
+    std::vector<t_tscalar> weights;
+    read_column_from_gstate(
+        gstate, expression_master_table, deps[1].name(), pkeys, orders
+    );
+
+    read_column_from_gstate(
+        gstate, expression_master_table, deps[0].name(), pkeys, values
+    );
+
+    if (deps.size() > 2) {
+        read_column_from_gstate(
+            gstate, expression_master_table, deps[2].name(), pkeys, weights
+        );
+    }
+
+    t_rolling_window& window = iter.value();
+
+    for (const auto& pkey : removed) {
+        window.erase(pkey);
+    }
+
+    for (t_uindex idx = 0, loop_end = pkeys.size(); idx < loop_end; ++idx) {
+        window.insert(
+            pkeys[idx],
+            orders[idx],
+            m_symtable.get_interned_tscalar(values[idx]),
+            weights.empty() ? mknone() : weights[idx]
+        );
+    }
+
+    return window.value();
+}
+
+bool
+t_stree::get_node_row_changes(
+    t_uindex nidx,
+    std::vector<t_tscalar>& pkeys,
+    std::vector<t_tscalar>& removed
+) const {
+    auto events_iter = m_order_stat_node_events.find(nidx);
+    if (events_iter == m_order_stat_node_events.end()) {
+        return false;
+    }
+
+    // A row that moved between two leaves under the node has an event for
+    // each, and is still in the node if either kept it.
+    tsl::hopscotch_map<t_tscalar, bool> in_node;
+    for (auto eidx : events_iter->second) {
+        const auto& event = m_order_stat_events[eidx];
+        bool& is_in_node = in_node[event.m_pkey];
+        is_in_node = is_in_node || event.m_strand_count >= 0;
+    }
+
+    for (const auto& [pkey, is_in_node] : in_node) {
+        if (is_in_node) {
+            pkeys.push_back(pkey);
+        } else {
+            removed.push_back(pkey);
+        }
+    }
+
+    return true;
+}
+
+std::vector<t_uindex>
+t_stree::updated_ids() const {
+    std::vector<t_uindex> rval;
+    rval.reserve(m_tree_unification_records.size());
+    for (const auto& r : m_tree_unification_records) {
+        rval.push_back(r.m_sptidx);
+    }
+
+    return rval;
 }
 
 t_uindex
@@ -1081,6 +1420,27 @@ t_stree::size() const {
     return m_nodes->size();
 }
 
+t_uindex
+t_stree::nbytes() const {
+    if (!m_init) {
+        return 0;
+    }
+
+    // `t_treenodes` is indexed by three ordered and two hashed indices.
+    t_uindex node_bytes = sizeof(t_stnode) + 3 * PSP_ORDERED_INDEX_NODE_BYTES
+        + 2 * PSP_HASHED_INDEX_NODE_BYTES;
+
+    t_uindex rv = m_nodes->size() * node_bytes;
+    rv += ordered_container_nbytes(*m_idxpkey);
+    rv += ordered_container_nbytes(*m_idxleaf);
+    rv += m_aggregates->nbytes();
+    rv += m_agg_freelist.capacity() * sizeof(t_uindex);
+    rv += ordered_container_nbytes(m_newids);
+    rv += ordered_container_nbytes(m_newleaves);
+    rv += ordered_container_nbytes(*m_deltas);
+    return rv;
+}
+
 void
 t_stree::get_child_nodes(t_uindex idx, t_tnodevec& nodes) const {
     t_index num_children = get_num_children(idx);
@@ -1321,25 +1681,65 @@ t_stree::update_agg_table(
 
                 dst->set_scalar(dst_ridx, new_value);
             } break;
-            case AGGTYPE_MEDIAN: {
+            case AGGTYPE_MEDIAN:
+            case AGGTYPE_P25:
+            case AGGTYPE_P75:
+            case AGGTYPE_P90:
+            case AGGTYPE_P99: {
                 old_value.set(dst->get_scalar(dst_ridx));
-                auto pkeys = get_pkeys(nidx);
 
-                new_value.set(
-                    reduce_from_gstate<
-                        std::function<t_tscalar(std::vector<t_tscalar>&)>>(
-                        gstate,
-                        expression_master_table,
-                        spec.get_dependencies()[0].name(),
-                        pkeys,
-                        [&](std::vector<t_tscalar>& values) {
-                            return get_aggregate_median(values);
-                        }
-                    )
-                );
+                // Expression columns may change for rows the update did not
+                // touch, so they are always read in full.
+                if (m_has_order_stats && !is_expr) {
+                    new_value.set(update_order_statistic(
+                        nidx, idx, spec, gstate, expression_master_table
+                    ));
+                } else {
+                    auto pkeys = get_pkeys(nidx);
+                    auto percentile = get_aggtype_percentile(spec.agg());
+
+                    new_value.set(
+                        reduce_from_gstate<
+                            std::function<t_tscalar(std::vector<t_tscalar>&)>>(
+                            gstate,
+                            expression_master_table,
+                            spec.get_dependencies()[0].name(),
+                            pkeys,
+                            [&](std::vector<t_tscalar>& values) {
+                                return get_percentile(values, percentile);
+                            }
+                        )
+                    );
+                }
 
                 dst->set_scalar(dst_ridx, new_value);
             } break;
+            case AGGTYPE_ROLLING_SUM:
+            case AGGTYPE_ROLLING_COUNT:
+            case AGGTYPE_ROLLING_MEAN:
+            case AGGTYPE_ROLLING_WEIGHTED_MEAN:
+            case AGGTYPE_ROLLING_MIN:
+            case AGGTYPE_ROLLING_MAX: {
+                old_value.set(dst->get_scalar(dst_ridx));
+
+                // As for percentiles, a window over any expression column is
+                // rebuilt from all of the node's rows.
+                bool rebuild = false;
+                for (const auto& dep : spec.get_dependencies()) {
+                    rebuild =
+                        rebuild || expression_schema.has_column(dep.name());
+                }
+
+                new_value.set(update_rolling_window(
+                    nidx, idx, spec, rebuild, gstate, expression_master_table
+                ));
+
+                if (new_value.is_none()) {
+                    dst->set_valid(dst_ridx, false);
+                } else {
+                    dst->set_scalar(dst_ridx, new_value);
+                }
+            } break;
             case AGGTYPE_JOIN: {
                 old_value.set(dst->get_scalar(dst_ridx));
                 auto pkeys = get_pkeys(nidx);
@@ -2012,6 +2412,22 @@ t_stree::drop_zero_strands() {
             leaves.push_back(iter->m_idx);
         }
         node_ids.push_back(iter->m_aggidx);
+
+        for (auto& stats : m_order_stats) {
+            stats.erase(iter->m_idx);
+        }
+
+        for (auto& sketches : m_distinct_sketches) {
+            sketches.erase(iter->m_idx);
+        }
+
+        for (auto& sketches : m_quantile_sketches) {
+            sketches.erase(iter->m_idx);
+        }
+
+        for (auto& windows : m_rolling_windows) {
+            windows.erase(iter->m_idx);
+        }
     }
 
     clear_aggregates(node_ids);
@@ -2323,31 +2739,6 @@ t_stree::get_aggregate(t_index idx, t_index aggnum) const {
     return extract_aggregate(m_aggspecs[aggnum], c, agg_ridx, agg_pridx);
 }
 
-t_tscalar
-t_stree::get_aggregate_median(std::vector<t_tscalar>& values) const {
-    int size = values.size();
-    bool is_even_size = size % 2 == 0;
-
-    if (size == 0) {
-        return {};
-    }
-    if (size == 1) {
-        return values[0];
-    }
-    if (is_even_size && values[0].is_floating_point()) {
-        t_tscalar median_average;
-        auto middle = values.begin() + (size / 2);
-        nth_element(values.begin(), middle, values.end());
-        median_average.set(
-            (*middle + *(middle - 1)) / static_cast<t_tscalar>(2)
-        );
-        return median_average;
-    }
-    auto middle = values.begin() + (size / 2);
-    std::nth_element(values.begin(), middle, values.end());
-    return *middle;
-}
-
 void
 t_stree::get_child_indices(t_index idx, std::vector<t_index>& out_data) const {
     t_index num_children = get_num_children(idx);
@@ -2511,6 +2902,16 @@ t_stree::set_has_deltas(bool v) {
     m_has_delta = v;
 }
 
+const t_stree_shape_delta&
+t_stree::get_shape_delta() const {
+    return m_shape_delta;
+}
+
+void
+t_stree::set_shape_delta(t_stree_shape_delta shape_delta) {
+    m_shape_delta = std::move(shape_delta);
+}
+
 t_bfs_iter<t_stree>
 t_stree::bfs() const {
     return {this};
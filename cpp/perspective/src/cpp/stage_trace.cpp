@@ -0,0 +1,183 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#include <perspective/first.h>
+#include <perspective/stage_trace.h>
+#include <perspective/env_vars.h>
+
+namespace perspective {
+
+namespace {
+    /**
+     * @brief Offset from the monotonic clock to the unix epoch, captured once
+     * so records carry wall-clock start times without a second clock read.
+     */
+    std::int64_t
+    steady_to_wall_offset_ns() {
+        static const std::int64_t offset = []() {
+            auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch()
+            )
+                            .count();
+
+            return wall - t_stage_trace::now_ns();
+        }();
+
+        return offset;
+    }
+} // namespace
+
+const char*
+trace_stage_to_str(t_trace_stage stage) {
+    switch (stage) {
+        case TRACE_STAGE_FLATTEN:
+            return "flatten";
+        case TRACE_STAGE_PKEY_LOOKUP:
+            return "pkey_lookup";
+        case TRACE_STAGE_PROCESS_COLUMNS:
+            return "process_columns";
+        case TRACE_STAGE_UPDATE_MASTER:
+            return "update_master";
+        case TRACE_STAGE_COMPUTE_EXPRESSIONS:
+            return "compute_expressions";
+        case TRACE_STAGE_CONTEXT_NOTIFY:
+            return "context_notify";
+        case TRACE_STAGE_DELTA_SERIALIZE:
+            return "delta_serialize";
+        default:
+            PSP_COMPLAIN_AND_ABORT("Unknown trace stage");
+    }
+
+    return "";
+}
+
+t_trace_stage_stats::t_trace_stage_stats() :
+    m_count(0),
+    m_total_ns(0),
+    m_max_ns(0),
+    m_rows(0) {}
+
+t_stage_trace::t_stage_trace(t_uindex capacity) : m_next_seq(0) {
+    m_records.resize(capacity);
+}
+
+bool
+t_stage_trace::enabled() {
+    return !t_env::disable_stage_trace();
+}
+
+std::int64_t
+t_stage_trace::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+void
+t_stage_trace::record(
+    t_trace_stage stage,
+    std::int64_t start_ns,
+    std::int64_t end_ns,
+    t_uindex rows
+) {
+    std::int64_t duration_ns = end_ns - start_ns;
+    std::int64_t wall_start_ns = start_ns + steady_to_wall_offset_ns();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_records.empty()) {
+        t_trace_record& rec = m_records[m_next_seq % m_records.size()];
+        rec.m_stage = stage;
+        rec.m_seq = m_next_seq;
+        rec.m_start_ns = wall_start_ns;
+        rec.m_duration_ns = duration_ns;
+        rec.m_rows = rows;
+    }
+
+    ++m_next_seq;
+
+    t_trace_stage_stats& stats = m_stats[stage];
+    ++stats.m_count;
+    stats.m_total_ns += duration_ns;
+    stats.m_max_ns = std::max(stats.m_max_ns, duration_ns);
+    stats.m_rows += rows;
+}
+
+std::vector<t_trace_record>
+t_stage_trace::get_records() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    t_uindex capacity = m_records.size();
+    t_uindex num_records = std::min<std::uint64_t>(m_next_seq, capacity);
+
+    std::vector<t_trace_record> rval;
+    rval.reserve(num_records);
+
+    for (std::uint64_t seq = m_next_seq - num_records; seq < m_next_seq;
+         ++seq) {
+        rval.push_back(m_records[seq % capacity]);
+    }
+
+    return rval;
+}
+
+std::vector<t_trace_stage_stats>
+t_stage_trace::get_stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return {m_stats, m_stats + TRACE_STAGE_LAST};
+}
+
+std::uint64_t
+t_stage_trace::get_num_dropped() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::uint64_t capacity = m_records.size();
+    return m_next_seq > capacity ? m_next_seq - capacity : 0;
+}
+
+void
+t_stage_trace::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_next_seq = 0;
+
+    for (auto& stats : m_stats) {
+        stats = t_trace_stage_stats();
+    }
+}
+
+t_stage_timer::t_stage_timer(
+    t_stage_trace& trace, t_trace_stage stage, t_uindex rows
+) :
+    m_trace(trace),
+    m_stage(stage),
+    m_rows(rows),
+    m_start_ns(t_stage_trace::enabled() ? t_stage_trace::now_ns() : 0),
+    m_stopped(!t_stage_trace::enabled()) {}
+
+t_stage_timer::~t_stage_timer() { stop(); }
+
+void
+t_stage_timer::stop() {
+    if (m_stopped) {
+        return;
+    }
+
+    m_stopped = true;
+    m_trace.record(m_stage, m_start_ns, t_stage_trace::now_ns(), m_rows);
+}
+
+void
+t_stage_timer::set_rows(t_uindex rows) {
+    m_rows = rows;
+}
+
+} // end namespace perspective
@@ -42,6 +42,19 @@ namespace perspective {
 
 t_lstore_recipe::t_lstore_recipe() : m_alignment(0), m_from_recipe(false) {}
 
+t_storage_options::t_storage_options() :
+    m_backing_store(BACKING_STORE_MEMORY),
+    m_resident_budget(0),
+    m_compress_after_updates(0) {}
+
+t_storage_options::t_storage_options(
+    std::string dirname, t_uindex resident_budget
+) :
+    m_backing_store(BACKING_STORE_DISK),
+    m_dirname(std::move(dirname)),
+    m_resident_budget(resident_budget),
+    m_compress_after_updates(0) {}
+
 t_lstore_recipe::t_lstore_recipe(t_uindex capacity) :
     m_capacity(capacity),
     m_size(0),
@@ -465,14 +478,15 @@ t_lstore::load(const std::string& fname) {
 }
 
 void
-t_lstore::save(const std::string& fname) {
+t_lstore::save(const std::string& fname) const {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
-    PSP_VERBOSE_ASSERT(m_init, "Store not inited.");
+    PSP_VERBOSE_ASSERT(m_size > 0, "Cannot map an empty store to a file.");
 
+    // Only the used bytes are written, so that `load` restores the size.
     t_rfmapping omap;
-    map_file_write(fname, capacity(), omap);
-    memcpy(omap.m_base, m_base, size_t(capacity()));
+    map_file_write(fname, size(), omap);
+    memcpy(omap.m_base, m_base, size_t(size()));
 }
 
 void
@@ -500,6 +514,11 @@ t_lstore::capacity() const {
     return m_capacity;
 }
 
+t_uindex
+t_lstore::nbytes() const {
+    return m_init ? m_capacity : 0;
+}
+
 std::pair<std::uint32_t, std::uint32_t>
 t_lstore::capacity_pair() const {
     PSP_TRACE_SENTINEL();
@@ -22,6 +22,7 @@
 #include <perspective/defaults.h>
 #include <perspective/compat.h>
 #include <perspective/utils.h>
+#include <algorithm>
 #include <iostream>
 #include <cassert>
 #include <csignal>
@@ -117,6 +118,58 @@ t_lstore::destroy_mapping() {
     PSP_VERBOSE_ASSERT(rc, == 0, "Failed to destroy mapping");
 }
 
+t_uindex
+t_lstore::resident_nbytes() const {
+    if (!m_init || m_backing_store != BACKING_STORE_DISK) {
+        return nbytes();
+    }
+
+    auto pgsize = static_cast<t_uindex>(get_page_size());
+    t_uindex npages = (capacity() + pgsize - 1) / pgsize;
+    std::vector<char> in_core(npages);
+
+    if (mincore(m_base, capacity(), in_core.data()) != 0) {
+        return capacity();
+    }
+
+    t_uindex nresident = 0;
+    for (auto page : in_core) {
+        nresident += page & 1;
+    }
+
+    return std::min(nresident * pgsize, capacity());
+}
+
+void
+t_lstore::advise(t_access_advice advice) const {
+    if (!m_init || m_backing_store != BACKING_STORE_DISK) {
+        return;
+    }
+
+    int flag = MADV_NORMAL;
+    switch (advice) {
+        case ACCESS_ADVICE_NORMAL: {
+            flag = MADV_NORMAL;
+        } break;
+        case ACCESS_ADVICE_SEQUENTIAL: {
+            flag = MADV_SEQUENTIAL;
+        } break;
+        case ACCESS_ADVICE_RANDOM: {
+            flag = MADV_RANDOM;
+        } break;
+        case ACCESS_ADVICE_WILLNEED: {
+            flag = MADV_WILLNEED;
+        } break;
+        case ACCESS_ADVICE_DONTNEED: {
+            // Dirty pages must reach the file before they can be dropped.
+            msync(m_base, capacity(), MS_SYNC);
+            flag = MADV_DONTNEED;
+        } break;
+    }
+
+    madvise(m_base, capacity(), flag);
+}
+
 void
 t_lstore::freeze_impl() {
     PSP_COMPLAIN_AND_ABORT("Not implemented");
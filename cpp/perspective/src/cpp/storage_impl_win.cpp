@@ -148,6 +148,23 @@ t_lstore::destroy_mapping() {
     m_base = 0;
 }
 
+t_uindex
+t_lstore::resident_nbytes() const {
+    return nbytes();
+}
+
+void
+t_lstore::advise(t_access_advice advice) const {
+    if (!m_init || m_backing_store != BACKING_STORE_DISK
+        || advice != ACCESS_ADVICE_DONTNEED) {
+        return;
+    }
+
+    // Unlocking pages that are not locked trims them from the working set.
+    flush_mapping(m_base, capacity());
+    VirtualUnlock(m_base, capacity());
+}
+
 void
 t_lstore::freeze_impl() {
     DWORD dwOld;
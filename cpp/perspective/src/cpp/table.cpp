@@ -20,8 +20,11 @@
 #include "rapidjson/document.h"
 #include <chrono>
 #include <ctime>
+#include <fstream>
+#include <iomanip>
 #include <memory>
 #include <optional>
+#include <perspective/pyutils.h>
 #include <perspective/table.h>
 #include <rapidjson/writer.h>
 #include <sstream>
@@ -39,7 +42,8 @@ Table::Table(
     std::vector<std::string> column_names,
     std::vector<t_dtype> data_types,
     std::uint32_t limit,
-    std::string index
+    std::string index,
+    t_storage_options storage
 ) :
     m_init(false),
     m_id(GLOBAL_TABLE_ID++),
@@ -49,6 +53,7 @@ Table::Table(
     m_offset(0),
     m_limit(limit),
     m_index(std::move(index)),
+    m_storage(std::move(storage)),
     m_gnode_set(false) {
     validate_columns(m_column_names);
 }
@@ -183,7 +188,7 @@ Table::validate_expressions(
 std::shared_ptr<t_gnode>
 Table::make_gnode(const t_schema& in_schema) {
     t_schema out_schema = in_schema.drop({"psp_pkey", "psp_op"});
-    auto gnode = std::make_shared<t_gnode>(in_schema, out_schema);
+    auto gnode = std::make_shared<t_gnode>(in_schema, out_schema, m_storage);
     gnode->init();
     return gnode;
 }
@@ -361,7 +366,10 @@ Table::update_csv(const std::string_view& data, std::uint32_t port_id) {
 
 std::shared_ptr<Table>
 Table::from_csv(
-    const std::string& index, const std::string_view& data, std::uint32_t limit
+    const std::string& index,
+    const std::string_view& data,
+    std::uint32_t limit,
+    const t_storage_options& storage
 ) {
     auto pool = std::make_shared<t_pool>();
     pool->init();
@@ -396,7 +404,9 @@ Table::from_csv(
     data_table.extend(row_count);
     arrow_loader.fill_table(data_table, input_schema, index, 0, limit, false);
     auto tbl =
-        std::make_shared<Table>(pool, column_names, data_types, limit, index);
+        std::make_shared<Table>(
+            pool, column_names, data_types, limit, index, storage
+        );
 
     tbl->init(data_table, row_count, t_op::OP_INSERT, 0);
     pool->_process();
@@ -844,6 +854,37 @@ Table::remove_rows(const std::string_view& data) {
     m_pool->send(get_gnode()->get_id(), 0, data_table);
 }
 
+void
+Table::set_retention(const std::string& column, std::int64_t ttl) {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (!column.empty()) {
+        if (m_index.empty()) {
+            PSP_COMPLAIN_AND_ABORT("Cannot set retention on unindexed Table");
+        }
+
+        const t_schema& schema = get_gnode()->get_output_schema();
+        if (!schema.has_column(column)) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Retention column `" + column + "` not found"
+            );
+        }
+
+        t_dtype dtype = schema.get_dtype(column);
+        if (dtype != DTYPE_TIME && dtype != DTYPE_INT64
+            && dtype != DTYPE_INT32) {
+            PSP_COMPLAIN_AND_ABORT(
+                "Retention column must be a datetime or integer column"
+            );
+        }
+
+        if (ttl < 0) {
+            PSP_COMPLAIN_AND_ABORT("Retention window cannot be negative");
+        }
+    }
+
+    m_gnode->set_retention(column, ttl);
+}
+
 void
 Table::remove_cols(const std::string_view& data) {
     // 1.) Infer schema
@@ -996,7 +1037,10 @@ Table::update_cols(const std::string_view& data, std::uint32_t port_id) {
 
 std::shared_ptr<Table>
 Table::from_cols(
-    const std::string& index, const std::string_view& data, std::uint32_t limit
+    const std::string& index,
+    const std::string_view& data,
+    std::uint32_t limit,
+    const t_storage_options& storage
 ) {
     auto pool = std::make_shared<t_pool>();
     pool->init();
@@ -1101,7 +1145,7 @@ Table::from_cols(
     }
 
     auto tbl = std::make_shared<Table>(
-        pool, schema.columns(), schema.types(), limit, index
+        pool, schema.columns(), schema.types(), limit, index, storage
     );
 
     tbl->init(data_table, nrows, t_op::OP_INSERT, 0);
@@ -1228,7 +1272,10 @@ Table::update_rows(const std::string_view& data, std::uint32_t port_id) {
 
 std::shared_ptr<Table>
 Table::from_rows(
-    const std::string& index, const std::string_view& data, std::uint32_t limit
+    const std::string& index,
+    const std::string_view& data,
+    std::uint32_t limit,
+    const t_storage_options& storage
 ) {
     auto pool = std::make_shared<t_pool>();
     pool->init();
@@ -1354,7 +1401,7 @@ Table::from_rows(
     }
 
     auto tbl = std::make_shared<Table>(
-        pool, schema.columns(), schema.types(), limit, index
+        pool, schema.columns(), schema.types(), limit, index, storage
     );
 
     tbl->init(data_table, document.Size(), t_op::OP_INSERT, 0);
@@ -1364,7 +1411,10 @@ Table::from_rows(
 
 std::shared_ptr<Table>
 Table::from_schema(
-    const std::string& index, const t_schema& schema, std::uint32_t limit
+    const std::string& index,
+    const t_schema& schema,
+    std::uint32_t limit,
+    const t_storage_options& storage
 ) {
     auto pool = std::make_shared<t_pool>();
     pool->init();
@@ -1389,7 +1439,7 @@ Table::from_schema(
     }
 
     auto tbl = std::make_shared<Table>(
-        pool, schema.columns(), schema.types(), limit, index
+        pool, schema.columns(), schema.types(), limit, index, storage
     );
 
     tbl->init(data_table, 0, t_op::OP_INSERT, 0);
@@ -1397,6 +1447,69 @@ Table::from_schema(
     return tbl;
 }
 
+void
+Table::save_snapshot(const std::string& dirname) const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    m_gnode->save_snapshot(dirname);
+
+    t_schema schema = get_schema();
+    const auto& columns = schema.columns();
+    const auto& types = schema.types();
+
+    std::ofstream out(dirname + "/table");
+    out << std::quoted(m_index) << ' ' << m_limit << ' ' << m_offset << '\n';
+    out << columns.size() << '\n';
+    for (t_uindex cidx = 0; cidx < columns.size(); ++cidx) {
+        out << std::quoted(columns[cidx]) << ' '
+            << static_cast<std::int32_t>(types[cidx]) << '\n';
+    }
+
+    if (!out) {
+        PSP_COMPLAIN_AND_ABORT("Cannot write snapshot to `" + dirname + "`");
+    }
+}
+
+std::shared_ptr<Table>
+Table::from_snapshot(
+    const std::string& dirname, const t_storage_options& storage
+) {
+    std::ifstream in(dirname + "/table");
+    if (!in) {
+        PSP_COMPLAIN_AND_ABORT("No table snapshot in `" + dirname + "`.");
+    }
+
+    std::string index;
+    std::uint32_t limit = 0;
+    std::uint32_t offset = 0;
+    t_uindex ncols = 0;
+    in >> std::quoted(index) >> limit >> offset >> ncols;
+
+    std::vector<std::string> columns;
+    std::vector<t_dtype> types;
+    for (t_uindex cidx = 0; in && cidx < ncols; ++cidx) {
+        std::string column;
+        std::int32_t dtype = DTYPE_NONE;
+        in >> std::quoted(column) >> dtype;
+        if (dtype <= DTYPE_NONE || dtype >= DTYPE_LAST) {
+            in.setstate(std::ios::failbit);
+        }
+
+        columns.push_back(std::move(column));
+        types.push_back(static_cast<t_dtype>(dtype));
+    }
+
+    if (!in || (limit > 0 && offset >= limit)) {
+        PSP_COMPLAIN_AND_ABORT(
+            "`" + dirname + "` is not a compatible table snapshot."
+        );
+    }
+
+    auto tbl = from_schema(index, t_schema(columns, types), limit, storage);
+    tbl->m_gnode->load_snapshot(dirname);
+    tbl->m_offset = offset;
+    return tbl;
+}
+
 void
 Table::update_arrow(const std::string_view& data, std::uint32_t port_id) {
     apachearrow::ArrowLoader arrow_loader;
@@ -1433,7 +1546,10 @@ Table::update_arrow(const std::string_view& data, std::uint32_t port_id) {
 
 std::shared_ptr<Table>
 Table::from_arrow(
-    const std::string& index, const std::string_view& data, std::uint32_t limit
+    const std::string& index,
+    const std::string_view& data,
+    std::uint32_t limit,
+    const t_storage_options& storage
 ) {
     apachearrow::ArrowLoader arrow_loader;
 
@@ -1470,7 +1586,9 @@ Table::from_arrow(
     // Make Table
     auto pool = std::make_shared<t_pool>();
     pool->init();
-    auto table = std::make_shared<Table>(pool, columns, types, limit, index);
+    auto table = std::make_shared<Table>(
+        pool, columns, types, limit, index, storage
+    );
     table->init(data_table, data_table.num_rows(), t_op::OP_INSERT, 0);
     pool->_process();
     return table;
@@ -33,7 +33,8 @@ t_vdnode::t_vdnode(bool expanded, bool has_children) :
     m_has_children(has_children) {}
 
 t_traversal::t_traversal(const std::shared_ptr<const t_stree>& tree) :
-    m_tree(tree) {
+    m_tree(tree),
+    m_sorted(false) {
     t_stnode_vec rchildren;
     tree->get_child_nodes(0, rchildren);
     populate_root_children(rchildren);
@@ -42,6 +43,7 @@ t_traversal::t_traversal(const std::shared_ptr<const t_stree>& tree) :
 void
 t_traversal::populate_root_children(const t_stnode_vec& rchildren) {
     m_nodes = std::make_shared<std::vector<t_tvnode>>(rchildren.size() + 1);
+    m_sorted = false;
 
     // Initialize root
     (*m_nodes)[0].m_expanded = true;
@@ -104,6 +106,10 @@ t_traversal::expand_node(t_index exp_idx) {
     exp_tvnode.m_ndesc += n_changed;
     exp_tvnode.m_nchild = n_changed;
 
+    if (n_changed > 0) {
+        m_sorted = false;
+    }
+
     // insert children of node into the traversal
     m_nodes->insert(
         m_nodes->begin() + exp_idx + 1, children.begin(), children.end()
@@ -183,6 +189,10 @@ t_traversal::expand_node(
     exp_tvnode.m_ndesc += n_changed;
     exp_tvnode.m_nchild = n_changed;
 
+    if (sortby.empty() && n_changed > 0) {
+        m_sorted = false;
+    }
+
     // insert children of node into the traversal
     m_nodes->insert(
         m_nodes->begin() + exp_idx + 1, children.begin(), children.end()
@@ -324,6 +334,11 @@ t_traversal::size() const {
     return m_nodes->size();
 }
 
+t_uindex
+t_traversal::nbytes() const {
+    return m_nodes->capacity() * sizeof(t_tvnode);
+}
+
 t_depth
 t_traversal::get_depth(t_index idx) const {
     return (*m_nodes)[idx].m_depth;
@@ -682,6 +697,11 @@ t_traversal::drop_tree_indices(const std::vector<t_uindex>& indices) {
     }
 }
 
+void
+t_traversal::invalidate_sort() {
+    m_sorted = false;
+}
+
 bool
 t_traversal::is_valid_idx(t_index idx) const {
     return idx >= 0 && idx < t_index(size());
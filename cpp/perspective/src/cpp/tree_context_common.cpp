@@ -20,12 +20,60 @@
 #include <perspective/env_vars.h>
 #include <perspective/dense_tree.h>
 #include <perspective/dense_tree_context.h>
+#include <perspective/process_state.h>
 #include <tsl/hopscotch_set.h>
 
 #include <utility>
 
 namespace perspective {
 
+void
+notify_traversal(
+    const std::shared_ptr<t_stree>& tree,
+    const std::shared_ptr<t_traversal>& traversal,
+    const std::vector<t_sortspec>& ctx_sortby
+) {
+    const t_stree_shape_delta& shape_delta = tree->get_shape_delta();
+
+    t_uindex t_osize = traversal->size();
+    traversal->drop_tree_indices(shape_delta.m_zero_strands);
+    if (t_osize != traversal->size()) {
+        tree->set_has_deltas(true);
+    }
+
+    if (!shape_delta.m_leaves.empty() && traversal->size() == 1) {
+        if (traversal->get_node(0).m_expanded) {
+            traversal->populate_root_children(tree);
+        }
+
+        return;
+    }
+
+    std::set<t_uindex> visited;
+
+    for (auto lfidx : shape_delta.m_leaves) {
+        auto ancestry = tree->get_ancestry(lfidx);
+
+        t_uindex num_tnodes_existed = 0;
+
+        for (auto nidx : ancestry) {
+            if (shape_delta.m_non_zero_ids.find(nidx)
+                    == shape_delta.m_non_zero_ids.end()
+                || visited.find(nidx) != visited.end()) {
+                ++num_tnodes_existed;
+            } else {
+                break;
+            }
+        }
+
+        traversal->add_node(ctx_sortby, ancestry, num_tnodes_existed);
+
+        for (auto nidx : ancestry) {
+            visited.insert(nidx);
+        }
+    }
+}
+
 void
 notify_sparse_tree_common(
     const std::shared_ptr<t_data_table>& strands,
@@ -37,7 +85,8 @@ notify_sparse_tree_common(
     const std::vector<std::pair<std::string, std::string>>& tree_sortby,
     const std::vector<t_sortspec>& ctx_sortby,
     const t_gstate& gstate,
-    const t_data_table& expression_master_table
+    const t_data_table& expression_master_table,
+    const tsl::hopscotch_set<std::string>& unchanged_aggregates
 ) {
     t_filter fltr;
     if (t_env::log_data_nsparse_strands()) {
@@ -68,27 +117,19 @@ notify_sparse_tree_common(
 
     tree->update_shape_from_static(dctx);
 
-    auto zero_strands = tree->zero_strands();
-
-    t_uindex t_osize = process_traversal ? traversal->size() : 0;
-    if (process_traversal) {
-        traversal->drop_tree_indices(zero_strands);
-    }
-    t_uindex t_nsize = process_traversal ? traversal->size() : 0;
-    if (t_osize != t_nsize) {
-        tree->set_has_deltas(true);
-    }
-
-    auto non_zero_ids = tree->non_zero_ids(zero_strands);
-    auto non_zero_leaves = tree->non_zero_leaves(zero_strands);
+    t_stree_shape_delta shape_delta;
+    shape_delta.m_zero_strands = tree->zero_strands();
+    shape_delta.m_non_zero_ids = tree->non_zero_ids(shape_delta.m_zero_strands);
+    shape_delta.m_updated_ids = tree->updated_ids();
+    auto non_zero_leaves = tree->non_zero_leaves(shape_delta.m_zero_strands);
 
     tree->drop_zero_strands();
 
     tree->populate_leaf_index(non_zero_leaves);
 
-    tree->update_aggs_from_static(dctx, gstate, expression_master_table);
-
-    std::set<t_uindex> visited;
+    tree->update_aggs_from_static(
+        dctx, gstate, expression_master_table, unchanged_aggregates
+    );
 
     struct t_leaf_path {
         std::vector<t_tscalar> m_path;
@@ -116,36 +157,80 @@ notify_sparse_tree_common(
         }
     );
 
-    if (!leaf_paths.empty() && (traversal != nullptr)
-        && traversal->size() == 1) {
-        if (traversal->get_node(0).m_expanded) {
-            traversal->populate_root_children(tree);
-        }
-    } else {
-        for (const auto& lpath : leaf_paths) {
-            t_uindex lfidx = lpath.m_lfidx;
-            auto ancestry = tree->get_ancestry(lfidx);
-
-            t_uindex num_tnodes_existed = 0;
-
-            for (auto nidx : ancestry) {
-                if (non_zero_ids.find(nidx) == non_zero_ids.end()
-                    || visited.find(nidx) != visited.end()) {
-                    ++num_tnodes_existed;
-                } else {
-                    break;
-                }
-            }
+    shape_delta.m_leaves.reserve(leaf_paths.size());
+    for (const auto& lpath : leaf_paths) {
+        shape_delta.m_leaves.push_back(lpath.m_lfidx);
+    }
+
+    tree->set_shape_delta(std::move(shape_delta));
 
-            if (process_traversal) {
-                traversal->add_node(ctx_sortby, ancestry, num_tnodes_existed);
+    if (process_traversal) {
+        notify_traversal(tree, traversal, ctx_sortby);
+    }
+}
+
+/**
+ * @brief Returns the names of the aggregates that the last update of `gstate`
+ * cannot have changed: when the update only changed values of existing rows,
+ * and none of the pivot, sort-by or filter columns, every tree node keeps
+ * its rows, so aggregates over columns the update did not touch keep their
+ * values.
+ */
+static tsl::hopscotch_set<std::string>
+get_unchanged_aggregates(
+    const std::vector<t_aggspec>& aggregates,
+    const t_config& config,
+    const t_gstate& gstate
+) {
+    tsl::hopscotch_set<std::string> rval;
+
+    if (t_env::disable_column_subset_updates()
+        || gstate.rows_changed_by_last_update()) {
+        return rval;
+    }
+
+    auto pivots_changed = [&](const std::vector<t_pivot>& pivots) {
+        for (const auto& pivot : pivots) {
+            if (gstate.column_changed_by_last_update(pivot.colname())
+                || gstate.column_changed_by_last_update(
+                    config.get_sort_by(pivot.colname())
+                )) {
+                return true;
             }
+        }
+
+        return false;
+    };
+
+    if (pivots_changed(config.get_row_pivots())
+        || pivots_changed(config.get_column_pivots())) {
+        return rval;
+    }
+
+    for (const auto& fterm : config.get_fterms()) {
+        if (gstate.column_changed_by_last_update(fterm.m_colname)) {
+            return rval;
+        }
+    }
+
+    for (const auto& aggspec : aggregates) {
+        const auto& deps = aggspec.get_dependencies();
+        bool unchanged = !deps.empty();
 
-            for (auto nidx : ancestry) {
-                visited.insert(nidx);
+        for (const auto& dep : deps) {
+            if (dep.type() != DEPTYPE_COLUMN
+                || gstate.column_changed_by_last_update(dep.name())) {
+                unchanged = false;
+                break;
             }
         }
+
+        if (unchanged) {
+            rval.insert(aggspec.name());
+        }
     }
+
+    return rval;
 }
 
 void
@@ -183,7 +268,8 @@ notify_sparse_tree(
         tree_sortby,
         ctx_sortby,
         gstate,
-        expression_master_table
+        expression_master_table,
+        get_unchanged_aggregates(aggregates, config, gstate)
     );
 }
 
@@ -215,10 +301,59 @@ notify_sparse_tree(
         tree_sortby,
         ctx_sortby,
         gstate,
-        expression_master_table
+        expression_master_table,
+        tsl::hopscotch_set<std::string>()
     );
 }
 
+t_transitional_needs
+tree_transitional_needs(const t_config& config) {
+    t_transitional_needs needs;
+    std::uint8_t pivot_tables = TRANSITIONAL_TABLE_PREV
+        | TRANSITIONAL_TABLE_CURRENT | TRANSITIONAL_TABLE_TRANSITIONS;
+
+    // Pivots and their sort-by columns are compared between `prev` and
+    // `current` by `t_stree::build_strand_table`.
+    auto require_pivots = [&](const std::vector<t_pivot>& pivots) {
+        for (const auto& pivot : pivots) {
+            needs.require(pivot.colname(), pivot_tables);
+            needs.require(config.get_sort_by(pivot.colname()), pivot_tables);
+        }
+    };
+
+    require_pivots(config.get_row_pivots());
+    require_pivots(config.get_column_pivots());
+
+    // Aggregates read the delta for unchanged rows and `current` or `prev`
+    // otherwise, and non-delta aggregates are treated as pivots.
+    for (const auto& aggspec : config.get_aggregates()) {
+        for (const auto& dep : aggspec.get_dependencies()) {
+            if (dep.type() != DEPTYPE_COLUMN) {
+                continue;
+            }
+
+            needs.require(
+                dep.name(),
+                TRANSITIONAL_TABLE_DELTA | TRANSITIONAL_TABLE_PREV
+                    | TRANSITIONAL_TABLE_CURRENT
+            );
+
+            if (aggspec.is_non_delta()) {
+                needs.require(dep.name(), pivot_tables);
+            }
+        }
+    }
+
+    for (const auto& fterm : config.get_fterms()) {
+        needs.require(
+            fterm.m_colname,
+            TRANSITIONAL_TABLE_PREV | TRANSITIONAL_TABLE_CURRENT
+        );
+    }
+
+    return needs;
+}
+
 std::vector<t_path>
 ctx_get_expansion_state(
     const std::shared_ptr<const t_stree>& tree,
@@ -39,6 +39,19 @@ t_update_task::run(std::optional<std::function<void(std::uint32_t)>> callback) {
                         m_pool.notify_userspace(port_id);
                     }
                     g->clear_output_ports();
+
+                    // Rows the update moved out of the table's retention
+                    // window are removed as an update of their own, so
+                    // views are notified of each.
+                    if (did_notify_context && g->queue_expired(port_id)) {
+                        if (g->process(port_id)) {
+                            if (callback) {
+                                (*callback)(port_id);
+                            }
+                            m_pool.notify_userspace(port_id);
+                        }
+                        g->clear_output_ports();
+                    }
                 }
             }
         }
@@ -503,6 +503,58 @@ View<t_ctx1>::get_data(
     return data_slice_ptr;
 }
 
+template <>
+void
+View<t_ctx2>::_get_context_window(
+    t_uindex& start_row,
+    t_uindex& end_row,
+    t_uindex& start_col,
+    t_uindex& end_col,
+    std::vector<t_uindex>& column_indices
+) const {
+    if (is_column_only()) {
+        start_row += m_row_offset;
+        end_row += m_row_offset;
+    }
+
+    /**
+     * Perspective generates headers for sorted columns, so we have to
+     * skip them in the underlying slice.
+     */
+    // Only construct column_indices if start_col > end_col as get_data will
+    // handle the incorrect data window properly, which is consistent
+    // with the implementation for when the context is not sorted.
+    if (m_sort.empty() || start_col >= end_col) {
+        return;
+    }
+
+    auto depth = m_column_pivots.size();
+    auto col_length = m_ctx->unity_get_column_count();
+    column_indices.push_back(0);
+    for (t_uindex i = 0; i < col_length; ++i) {
+        if (m_ctx->unity_get_column_path(i + 1).size() == depth) {
+            column_indices.push_back(i + 1);
+        }
+    }
+
+    // Filter down column indices by user-provided start/end columns
+    column_indices = std::vector<t_uindex>(
+        column_indices.begin()
+            + std::min(start_col, (t_uindex)column_indices.size()),
+        column_indices.begin()
+            + std::min(end_col, (t_uindex)column_indices.size())
+    );
+
+    // If start_col == end_col, then column_indices will be an empty
+    // vector. Only try to access the first and last elements if the
+    // vector is not empty. `get_data` correctly handles cases where
+    // start == end and start < end.
+    if (!column_indices.empty()) {
+        start_col = column_indices.front();
+        end_col = column_indices.back() + 1;
+    }
+}
+
 template <>
 std::shared_ptr<t_data_slice<t_ctx2>>
 View<t_ctx2>::get_data(
@@ -512,50 +564,16 @@ View<t_ctx2>::get_data(
     std::vector<t_uindex> column_indices;
     std::vector<std::vector<t_tscalar>> cols;
     bool is_sorted = !m_sort.empty();
+    t_uindex start_col_index = start_col;
+    t_uindex end_col_index = end_col;
 
-    if (is_column_only()) {
-        start_row += m_row_offset;
-        end_row += m_row_offset;
-    }
+    _get_context_window(
+        start_row, end_row, start_col_index, end_col_index, column_indices
+    );
 
     if (is_sorted) {
-        /**
-         * Perspective generates headers for sorted columns, so we have to
-         * skip them in the underlying slice.
-         */
-        t_uindex start_col_index = start_col;
-        t_uindex end_col_index = end_col;
-
-        // Only construct column_indices if start_col > end_col as get_data will
-        // handle the incorrect data window properly, which is consistent
-        // with the implementation for when the context is not sorted.
         if (start_col < end_col) {
-            auto depth = m_column_pivots.size();
-            auto col_length = m_ctx->unity_get_column_count();
-            column_indices.push_back(0);
-            for (t_uindex i = 0; i < col_length; ++i) {
-                if (m_ctx->unity_get_column_path(i + 1).size() == depth) {
-                    column_indices.push_back(i + 1);
-                }
-            }
-
-            cols = column_names(true, depth);
-
-            // Filter down column indices by user-provided start/end columns
-            column_indices = std::vector<t_uindex>(
-                column_indices.begin() + start_col,
-                column_indices.begin()
-                    + std::min(end_col, (t_uindex)column_indices.size())
-            );
-
-            // If start_col == end_col, then column_indices will be an empty
-            // vector. Only try to access the first and last elements if the
-            // vector is not empty. `get_data` correctly handles cases where
-            // start == end and start < end.
-            if (!column_indices.empty()) {
-                start_col_index = column_indices.front();
-                end_col_index = column_indices.back() + 1;
-            }
+            cols = column_names(true, m_column_pivots.size());
         }
 
         std::vector<t_tscalar> slice_with_headers =
@@ -597,6 +615,23 @@ View<t_ctx2>::get_data(
     return data_slice_ptr;
 }
 
+template <typename CTX_T>
+std::shared_ptr<t_data_slice<CTX_T>>
+View<CTX_T>::get_snapshot(
+    t_uindex start_row,
+    t_uindex end_row,
+    t_uindex start_col,
+    t_uindex end_col,
+    bool with_row_paths,
+    bool with_pkeys
+) const {
+    PSP_READ_LOCK(*get_lock());
+    std::shared_ptr<t_data_slice<CTX_T>> data_slice =
+        get_data(start_row, end_row, start_col, end_col);
+    data_slice->snapshot(start_row, end_row, with_row_paths, with_pkeys);
+    return data_slice;
+}
+
 template <typename CTX_T>
 std::shared_ptr<std::string>
 View<CTX_T>::to_arrow(
@@ -607,8 +642,14 @@ View<CTX_T>::to_arrow(
     bool emit_group_by,
     bool compress
 ) const {
-    std::shared_ptr<t_data_slice<CTX_T>> data_slice =
-        get_data(start_row, end_row, start_col, end_col);
+    std::shared_ptr<t_data_slice<CTX_T>> data_slice = get_snapshot(
+        start_row,
+        end_row,
+        start_col,
+        end_col,
+        emit_group_by && !m_row_pivots.empty(),
+        false
+    );
     return data_slice_to_arrow(data_slice, emit_group_by, compress);
 };
 
@@ -626,8 +667,9 @@ View<t_ctx2>::to_csv(
         return std::make_shared<std::string>("");
     }
 
-    std::shared_ptr<t_data_slice<t_ctx2>> data_slice =
-        get_data(start_row, end_row, start_col, end_col);
+    std::shared_ptr<t_data_slice<t_ctx2>> data_slice = get_snapshot(
+        start_row, end_row, start_col, end_col, !m_row_pivots.empty(), false
+    );
     return data_slice_to_csv(data_slice);
 };
 
@@ -639,8 +681,9 @@ View<t_ctx1>::to_csv(
     std::int32_t start_col,
     std::int32_t end_col
 ) const {
-    std::shared_ptr<t_data_slice<t_ctx1>> data_slice =
-        get_data(start_row, end_row, start_col, end_col);
+    std::shared_ptr<t_data_slice<t_ctx1>> data_slice = get_snapshot(
+        start_row, end_row, start_col, end_col, !m_row_pivots.empty(), false
+    );
     return data_slice_to_csv(data_slice);
 };
 
@@ -659,8 +702,9 @@ View<CTX_T>::to_csv(
         return std::make_shared<std::string>("");
     }
 
-    std::shared_ptr<t_data_slice<CTX_T>> data_slice =
-        get_data(start_row, end_row, start_col, end_col);
+    std::shared_ptr<t_data_slice<CTX_T>> data_slice = get_snapshot(
+        start_row, end_row, start_col, end_col, !m_row_pivots.empty(), false
+    );
     return data_slice_to_csv(data_slice);
 };
 
@@ -725,9 +769,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::Int8Type,
                         std::int8_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -740,9 +784,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::UInt8Type,
                         std::uint8_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -755,9 +799,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::Int16Type,
                         std::int16_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -770,9 +814,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::UInt16Type,
                         std::uint16_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -785,9 +829,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::Int32Type,
                         std::int32_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -800,9 +844,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::UInt32Type,
                         std::uint32_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -815,9 +859,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::Int64Type,
                         std::int64_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -830,9 +874,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::UInt64Type,
                         std::uint64_t>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -845,9 +889,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::FloatType,
                         float>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -860,9 +904,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::numeric_col_to_array<
                         arrow::DoubleType,
                         double>(extents, [&, rpidx](t_uindex ridx) {
-                        auto depth = m_ctx->unity_get_row_depth(ridx);
+                        auto depth = data_slice->get_row_depth(ridx);
                         if (rpidx < depth) {
-                            return m_ctx->unity_get_row_path(ridx).at(
+                            return data_slice->get_row_path(ridx).at(
                                 (depth - 1) - rpidx
                             );
                         }
@@ -875,9 +919,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::date_col_to_array(
                         extents,
                         [&, rpidx](t_uindex ridx) {
-                            auto depth = m_ctx->unity_get_row_depth(ridx);
+                            auto depth = data_slice->get_row_depth(ridx);
                             if (rpidx < depth) {
-                                return m_ctx->unity_get_row_path(ridx).at(
+                                return data_slice->get_row_path(ridx).at(
                                     (depth - 1) - rpidx
                                 );
                             }
@@ -892,9 +936,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::timestamp_col_to_array(
                         extents,
                         [&, rpidx](t_uindex ridx) {
-                            auto depth = m_ctx->unity_get_row_depth(ridx);
+                            auto depth = data_slice->get_row_depth(ridx);
                             if (rpidx < depth) {
-                                return m_ctx->unity_get_row_path(ridx).at(
+                                return data_slice->get_row_path(ridx).at(
                                     (depth - 1) - rpidx
                                 );
                             }
@@ -908,9 +952,9 @@ View<CTX_T>::data_slice_to_batches(
                     vectors[write_idx] = apachearrow::boolean_col_to_array(
                         extents,
                         [&, rpidx](t_uindex ridx) {
-                            auto depth = m_ctx->unity_get_row_depth(ridx);
+                            auto depth = data_slice->get_row_depth(ridx);
                             if (rpidx < depth) {
-                                return m_ctx->unity_get_row_path(ridx).at(
+                                return data_slice->get_row_path(ridx).at(
                                     (depth - 1) - rpidx
                                 );
                             }
@@ -927,9 +971,9 @@ View<CTX_T>::data_slice_to_batches(
                         apachearrow::string_col_to_dictionary_array(
                             extents,
                             [&, rpidx](t_uindex ridx) {
-                                auto depth = m_ctx->unity_get_row_depth(ridx);
+                                auto depth = data_slice->get_row_depth(ridx);
                                 if (rpidx < depth) {
-                                    return m_ctx->unity_get_row_path(ridx).at(
+                                    return data_slice->get_row_path(ridx).at(
                                         (depth - 1) - rpidx
                                     );
                                 }
@@ -1434,7 +1478,54 @@ View<t_ctxunit>::get_step_delta(t_index bidx, t_index eidx) const {
 template <typename CTX_T>
 std::shared_ptr<t_data_slice<CTX_T>>
 View<CTX_T>::get_row_delta() const {
-    t_rowdelta delta = m_ctx->get_row_delta();
+    return row_delta_to_data_slice(m_ctx->get_row_delta());
+}
+
+template <typename CTX_T>
+std::shared_ptr<t_data_slice<CTX_T>>
+View<CTX_T>::get_row_delta(
+    t_uindex start_row, t_uindex end_row, t_uindex start_col, t_uindex end_col
+) const {
+    return row_delta_to_data_slice(m_ctx->get_row_delta());
+}
+
+template <>
+std::shared_ptr<t_data_slice<t_ctx1>>
+View<t_ctx1>::get_row_delta(
+    t_uindex start_row, t_uindex end_row, t_uindex start_col, t_uindex end_col
+) const {
+    return row_delta_to_data_slice(
+        m_ctx->get_row_delta(t_index(start_row), t_index(end_row))
+    );
+}
+
+template <>
+std::shared_ptr<t_data_slice<t_ctx2>>
+View<t_ctx2>::get_row_delta(
+    t_uindex start_row, t_uindex end_row, t_uindex start_col, t_uindex end_col
+) const {
+    std::vector<t_uindex> column_indices;
+    _get_context_window(
+        start_row, end_row, start_col, end_col, column_indices
+    );
+
+    return row_delta_to_data_slice(m_ctx->get_row_delta(
+        t_index(start_row),
+        t_index(end_row),
+        t_index(start_col),
+        t_index(end_col)
+    ));
+}
+
+template <typename CTX_T>
+void
+View<CTX_T>::clear_deltas() const {
+    m_ctx->clear_deltas();
+}
+
+template <typename CTX_T>
+std::shared_ptr<t_data_slice<CTX_T>>
+View<CTX_T>::row_delta_to_data_slice(const t_rowdelta& delta) const {
     const std::vector<t_tscalar>& data = delta.data;
     t_uindex num_rows_changed = delta.num_rows_changed;
 
@@ -1510,6 +1601,8 @@ View<CTX_T>::_map_aggregate_types(
         if (agg.name() == name) {
             switch (agg.agg()) {
                 case AGGTYPE_DISTINCT_COUNT:
+                case AGGTYPE_APPROX_DISTINCT_COUNT:
+                case AGGTYPE_ROLLING_COUNT:
                 case AGGTYPE_COUNT: {
                     return "integer";
                 } break;
@@ -1519,7 +1612,13 @@ View<CTX_T>::_map_aggregate_types(
                 case AGGTYPE_PCT_SUM_PARENT:
                 case AGGTYPE_PCT_SUM_GRAND_TOTAL:
                 case AGGTYPE_VARIANCE:
-                case AGGTYPE_STANDARD_DEVIATION: {
+                case AGGTYPE_STANDARD_DEVIATION:
+                case AGGTYPE_APPROX_MEDIAN:
+                case AGGTYPE_APPROX_P90:
+                case AGGTYPE_APPROX_P99:
+                case AGGTYPE_ROLLING_SUM:
+                case AGGTYPE_ROLLING_MEAN:
+                case AGGTYPE_ROLLING_WEIGHTED_MEAN: {
                     return "float";
                 } break;
                 default: {
@@ -1617,6 +1716,7 @@ View<CTX_T>::write_row_path(
     bool has_row_path,
     bool leaves_only,
     bool is_formatted,
+    std::shared_ptr<t_data_slice<CTX_T>> slice,
     rapidjson::Writer<rapidjson::StringBuffer>& writer
 ) const {
 
@@ -1626,13 +1726,13 @@ View<CTX_T>::write_row_path(
         t_uindex depth = m_row_pivots.size();
         for (auto r = start_row; r < end_row; ++r) {
             if (leaves_only) {
-                if (m_ctx->unity_get_row_depth(r) < depth) {
+                if (slice->get_row_depth(r) < depth) {
                     continue;
                 }
             }
 
             writer.StartArray();
-            const auto row_path = get_row_path(r);
+            const auto row_path = slice->get_row_path(r);
 
             // Question: Why are the row paths reversed?
             for (auto entry = row_path.size(); entry > 0; entry--) {
@@ -1681,7 +1781,7 @@ View<CTX_T>::write_column(
 
     for (auto r = start_row; r < end_row; ++r) {
         if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
+            if (slice->get_row_depth(r) < depth) {
                 continue;
             }
         }
@@ -1711,7 +1811,7 @@ View<CTX_T>::write_index_column(
 
     for (auto r = start_row; r < end_row; ++r) {
         if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
+            if (slice->get_row_depth(r) < depth) {
                 continue;
             }
         }
@@ -1750,8 +1850,14 @@ View<T>::to_rows(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-    auto slice = get_data(start_row, end_row, start_col, end_col);
+    auto slice = get_snapshot(
+        start_row,
+        end_row,
+        start_col,
+        end_col,
+        has_row_path,
+        get_pkeys || get_ids
+    );
     auto& col_names = slice->get_column_names();
     rapidjson::StringBuffer s;
     rapidjson::Writer<rapidjson::StringBuffer> writer(s);
@@ -1785,16 +1891,14 @@ View<T>::to_rows(
     if (start_col <= (end_col + num_virtual_columns)) {
         for (auto r = start_row; r < end_row; ++r) {
             if (has_row_path && leaves_only) {
-                if (m_ctx->unity_get_row_depth(r) < depth) {
+                if (slice->get_row_depth(r) < depth) {
                     continue;
                 }
             }
 
             writer.StartObject();
             if (get_ids) {
-                std::pair<t_uindex, t_uindex> pair{r, 0};
-                std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
-                const auto keys = m_ctx->get_pkeys(vec);
+                const auto keys = slice->get_pkeys(r, 0);
                 const t_tscalar& scalar = keys[0];
                 writer.Key("__ID__");
                 writer.StartArray();
@@ -1847,8 +1951,9 @@ View<t_ctx1>::to_rows(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-    auto slice = get_data(start_row, end_row, start_col, end_col);
+    auto slice = get_snapshot(
+        start_row, end_row, start_col, end_col, true, get_pkeys
+    );
     const auto& col_names = slice->get_column_names();
     rapidjson::StringBuffer s;
     rapidjson::Writer<rapidjson::StringBuffer> writer(s);
@@ -1874,7 +1979,7 @@ View<t_ctx1>::to_rows(
 
     for (auto r = start_row; r < end_row; ++r) {
         if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
+            if (slice->get_row_depth(r) < depth) {
                 continue;
             }
         }
@@ -1885,7 +1990,7 @@ View<t_ctx1>::to_rows(
         // `__ROW_PATH__`
         writer.Key("__ROW_PATH__");
         writer.StartArray();
-        const auto row_path = get_row_path(r);
+        const auto row_path = slice->get_row_path(r);
         for (auto entry = row_path.size(); entry > 0; entry--) {
             const t_tscalar& scalar = row_path[entry - 1];
             write_scalar(scalar, is_formatted, writer);
@@ -1953,8 +2058,9 @@ View<t_ctx2>::to_rows(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-    auto slice = get_data(start_row, end_row, start_col, end_col);
+    auto slice = get_snapshot(
+        start_row, end_row, start_col, end_col, true, get_pkeys
+    );
     const auto& col_names = slice->get_column_names();
     rapidjson::StringBuffer s;
     rapidjson::Writer<rapidjson::StringBuffer> writer(s);
@@ -1974,7 +2080,7 @@ View<t_ctx2>::to_rows(
     bool column_only = is_column_only();
     for (auto r = start_row; r < end_row; ++r) {
         if (has_row_path && leaves_only) {
-            if (m_ctx->unity_get_row_depth(r) < depth) {
+            if (slice->get_row_depth(r) < depth) {
                 continue;
             }
         }
@@ -1983,7 +2089,7 @@ View<t_ctx2>::to_rows(
         writer.StartObject();
 
         // `__ROW_PATH__`
-        const auto row_path = get_row_path(r);
+        const auto row_path = slice->get_row_path(r);
         if (!column_only) {
             writer.Key("__ROW_PATH__");
             writer.StartArray();
@@ -2106,8 +2212,9 @@ View<T>::to_columns(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-    auto slice = get_data(start_row, end_row, start_col, end_col);
+    auto slice = get_snapshot(
+        start_row, end_row, start_col, end_col, false, get_pkeys || get_ids
+    );
     const std::vector<std::vector<t_tscalar>>& col_names =
         slice->get_column_names();
 
@@ -2138,9 +2245,7 @@ View<T>::to_columns(
         writer.Key("__ID__");
         writer.StartArray();
         for (auto x = start_row; x < end_row; ++x) {
-            std::pair<t_uindex, t_uindex> pair{x, 0};
-            std::vector<std::pair<t_uindex, t_uindex>> vec{pair};
-            const auto keys = m_ctx->get_pkeys(vec);
+            const auto keys = slice->get_pkeys(x, 0);
             const t_tscalar& scalar = keys[0];
             writer.StartArray();
             write_scalar(scalar, is_formatted, writer);
@@ -2173,20 +2278,22 @@ View<t_ctx1>::to_columns(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-
-    auto slice = get_data(start_row, end_row, start_col, end_col);
+    auto slice = get_snapshot(
+        start_row, end_row, start_col, end_col, true, get_pkeys
+    );
     const auto& col_names = slice->get_column_names();
     rapidjson::StringBuffer s;
     rapidjson::Writer<rapidjson::StringBuffer> writer(s);
     writer.StartObject();
-    write_row_path(start_row, end_row, true, leaves_only, is_formatted, writer);
+    write_row_path(
+        start_row, end_row, true, leaves_only, is_formatted, slice, writer
+    );
     if (get_ids) {
         writer.Key("__ID__");
         writer.StartArray();
         for (auto r = start_row; r < end_row; ++r) {
             writer.StartArray();
-            const auto row_path = m_ctx->get_row_path(r);
+            const auto row_path = slice->get_row_path(r);
             for (auto entry = row_path.size(); entry > 0; entry--) {
                 const t_tscalar& scalar = row_path[entry - 1];
                 write_scalar(scalar, is_formatted, writer);
@@ -2246,14 +2353,26 @@ View<t_ctx2>::to_columns(
     t_uindex group_by_length
 ) const {
     PSP_GIL_UNLOCK();
-    PSP_READ_LOCK(*get_lock());
-    const auto slice = get_data(start_row, end_row, start_col, end_col);
+    const auto slice = get_snapshot(
+        start_row,
+        end_row,
+        start_col,
+        end_col,
+        has_row_path || get_ids,
+        get_pkeys
+    );
     const auto& col_names = slice->get_column_names();
     rapidjson::StringBuffer s;
     rapidjson::Writer<rapidjson::StringBuffer> writer(s);
     writer.StartObject();
     write_row_path(
-        start_row, end_row, has_row_path, leaves_only, is_formatted, writer
+        start_row,
+        end_row,
+        has_row_path,
+        leaves_only,
+        is_formatted,
+        slice,
+        writer
     );
 
     if (get_ids) {
@@ -2261,7 +2380,7 @@ View<t_ctx2>::to_columns(
         writer.StartArray();
         for (auto r = start_row; r < end_row; ++r) {
             writer.StartArray();
-            const auto row_path = m_ctx->get_row_path(r);
+            const auto row_path = slice->get_row_path(r);
             for (auto entry = row_path.size(); entry > 0; entry--) {
                 const t_tscalar& scalar = row_path[entry - 1];
                 write_scalar(scalar, is_formatted, writer);
@@ -11,11 +11,60 @@
 // ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
 
 #include <perspective/view_config.h>
+#include <perspective/rolling_window.h>
 
 #include <utility>
 
 namespace perspective {
 
+/**
+ * @brief Rolling aggregates are written `[agg, order column, window]`, with
+ * the weight column after the window for "rolling weighted mean".
+ */
+static t_aggspec
+make_rolling_aggspec(
+    const std::string& column,
+    t_aggtype agg_type,
+    const std::vector<std::string>& aggregate
+) {
+    bool weighted = agg_type == AGGTYPE_ROLLING_WEIGHTED_MEAN;
+    if (aggregate.size() != (weighted ? 4 : 3)) {
+        std::stringstream ss;
+        ss << "Aggregate '" << aggregate.at(0) << "' on column '" << column
+           << "' expects an order column, a window"
+           << (weighted ? " and a weight column." : ".") << '\n';
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+
+    // `std::stoll` stops at the first character it cannot parse, so a
+    // window like "10s" is only valid if nothing was left over.
+    const std::string& window_str = aggregate.at(2);
+    std::int64_t window = 0;
+    std::size_t parsed = 0;
+    try {
+        window = std::stoll(window_str, &parsed);
+    } catch (const std::exception&) {
+        parsed = 0;
+    }
+
+    if (parsed == 0 || parsed != window_str.size()) {
+        std::stringstream ss;
+        ss << "Invalid window '" << window_str << "' for column '" << column
+           << "'." << '\n';
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+
+    std::vector<t_dep> dependencies{
+        t_dep(column, DEPTYPE_COLUMN), t_dep(aggregate.at(1), DEPTYPE_COLUMN)
+    };
+
+    if (weighted) {
+        dependencies.emplace_back(aggregate.at(3), DEPTYPE_COLUMN);
+    }
+
+    return {column, agg_type, dependencies, window};
+}
+
 t_view_config::t_view_config(
     const std::vector<std::string>& row_pivots,
     const std::vector<std::string>& column_pivots,
@@ -344,6 +393,14 @@ t_view_config::fill_aggspecs(const std::shared_ptr<t_schema>& schema) {
                 } else {
                     agg_type = str_to_aggtype(col.at(0));
                 }
+
+                if (is_rolling_aggtype(agg_type)) {
+                    m_aggspecs.push_back(
+                        make_rolling_aggspec(column, agg_type, col)
+                    );
+                    m_aggregate_names.push_back(column);
+                    continue;
+                }
             } else {
                 t_dtype dtype = schema->get_dtype(column);
                 agg_type = _get_default_aggregate(dtype);
@@ -430,7 +487,9 @@ t_view_config::make_aggspec(
         }
     }
 
-    if (agg_type == AGGTYPE_FIRST || agg_type == AGGTYPE_LAST_BY_INDEX
+    if (is_rolling_aggtype(agg_type)) {
+        aggspec = make_rolling_aggspec(column, agg_type, aggregate);
+    } else if (agg_type == AGGTYPE_FIRST || agg_type == AGGTYPE_LAST_BY_INDEX
         || agg_type == AGGTYPE_LAST_MINUS_FIRST) {
         dependencies.emplace_back("psp_okey", DEPTYPE_COLUMN);
         aggspec = t_aggspec(
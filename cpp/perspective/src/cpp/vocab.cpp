@@ -12,6 +12,7 @@
 
 #include <perspective/first.h>
 #include <perspective/vocab.h>
+#include <perspective/memory_usage.h>
 #include <tsl/hopscotch_set.h>
 
 #include <memory>
@@ -170,8 +171,9 @@ t_vocab::verify_size() const {
 t_uindex
 t_vocab::nbytes() const {
     t_uindex rv = 0;
-    rv += m_vlendata->capacity();
-    rv += m_extents->capacity();
+    rv += m_vlendata->nbytes();
+    rv += m_extents->nbytes();
+    rv += hash_container_nbytes(m_map);
     return rv;
 }
 
@@ -71,6 +71,19 @@ public:
         double agg_two_weight
     );
 
+    /**
+     * @brief Construct a rolling window aggregate. `dependencies` are the
+     * value column, the order column and, for
+     * `AGGTYPE_ROLLING_WEIGHTED_MEAN`, the weight column. `window` is in
+     * the units of the order column, i.e. milliseconds for datetimes.
+     */
+    t_aggspec(
+        const std::string& aggname,
+        t_aggtype agg,
+        const std::vector<t_dep>& dependencies,
+        std::int64_t window
+    );
+
     std::string name() const;
     t_tscalar name_scalar() const;
     std::string disp_name() const;
@@ -85,6 +98,8 @@ public:
     double get_agg_one_weight() const;
     double get_agg_two_weight() const;
 
+    std::int64_t get_window() const;
+
     t_invmode get_inv_mode() const;
 
     std::vector<std::string> get_input_depnames() const;
@@ -112,6 +127,7 @@ private:
     double m_agg_one_weight;
     double m_agg_two_weight;
     t_invmode m_invmode;
+    std::int64_t m_window{0};
     // t_uindex m_kernel;
 };
 
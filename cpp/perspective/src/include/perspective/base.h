@@ -48,6 +48,14 @@ const t_index INVALID_INDEX = -1;
 #define DEFAULT_CAPACITY 4000
 #define DEFAULT_CHUNK_SIZE 4000
 #define DEFAULT_EMPTY_CAPACITY 8
+#define DEFAULT_TRACE_CAPACITY 256
+#define DEFAULT_RECYCLE_WINDOW 64
+#define DEFAULT_RECYCLE_SHRINK_FACTOR 4
+#define DEFAULT_INCREMENTAL_SORT_FACTOR 4
+#define DEFAULT_HLL_PRECISION 12
+#define DEFAULT_TDIGEST_COMPRESSION 100
+#define DEFAULT_COMPRESSION_BLOCK_SIZE 1024
+#define DEFAULT_ZONE_MAP_CHUNK_SIZE 4096
 #define ROOT_AGGIDX 0
 #ifndef CHAR_BIT
 #define CHAR_BIT 8
@@ -217,6 +225,14 @@ enum t_select_mode {
 
 enum t_backing_store { BACKING_STORE_MEMORY, BACKING_STORE_DISK };
 
+enum t_access_advice {
+    ACCESS_ADVICE_NORMAL,
+    ACCESS_ADVICE_SEQUENTIAL,
+    ACCESS_ADVICE_RANDOM,
+    ACCESS_ADVICE_WILLNEED,
+    ACCESS_ADVICE_DONTNEED
+};
+
 enum t_filter_op {
     FILTER_OP_LT,
     FILTER_OP_LTEQ,
@@ -289,7 +305,21 @@ enum t_aggtype {
     AGGTYPE_PCT_SUM_PARENT,
     AGGTYPE_PCT_SUM_GRAND_TOTAL,
     AGGTYPE_VARIANCE,
-    AGGTYPE_STANDARD_DEVIATION
+    AGGTYPE_STANDARD_DEVIATION,
+    AGGTYPE_P25,
+    AGGTYPE_P75,
+    AGGTYPE_P90,
+    AGGTYPE_P99,
+    AGGTYPE_APPROX_DISTINCT_COUNT,
+    AGGTYPE_APPROX_MEDIAN,
+    AGGTYPE_APPROX_P90,
+    AGGTYPE_APPROX_P99,
+    AGGTYPE_ROLLING_SUM,
+    AGGTYPE_ROLLING_COUNT,
+    AGGTYPE_ROLLING_MEAN,
+    AGGTYPE_ROLLING_WEIGHTED_MEAN,
+    AGGTYPE_ROLLING_MIN,
+    AGGTYPE_ROLLING_MAX
 };
 
 PERSPECTIVE_EXPORT t_aggtype str_to_aggtype(const std::string& str);
@@ -20,6 +20,9 @@
 #include <perspective/mask.h>
 #include <perspective/compat.h>
 #include <perspective/vocab.h>
+#include <perspective/compressed_store.h>
+#include <atomic>
+#include <mutex>
 #include <functional>
 #include <limits>
 #include <cmath>
@@ -49,6 +52,35 @@ class t_column;
 #define COLUMN_CHECK_STRCOL()
 #endif
 
+/**
+ * @brief Statistics for one chunk of `DEFAULT_ZONE_MAP_CHUNK_SIZE` rows of a
+ * column, used to skip chunks that cannot pass a filter. `m_min` and
+ * `m_max` are the extreme valid values, ignoring NaN, or `mknone()` if the
+ * chunk has none.
+ */
+struct PERSPECTIVE_EXPORT t_zone {
+    t_tscalar m_min;
+    t_tscalar m_max;
+    t_uindex m_nrows;
+    t_uindex m_nnull;
+};
+
+/**
+ * @brief Inverted index of one chunk of `DEFAULT_ZONE_MAP_CHUNK_SIZE` rows of
+ * a string column: the chunk's rows, as offsets into the chunk, grouped by
+ * vocabulary index. Rows that are not valid are grouped under
+ * `NULL_KEY`, which sorts last.
+ */
+struct PERSPECTIVE_EXPORT t_postings {
+    static constexpr t_uindex NULL_KEY = std::numeric_limits<t_uindex>::max();
+
+    std::vector<std::uint16_t> m_rows;
+
+    // Each distinct key, in ascending order, and where its rows start in
+    // `m_rows`.
+    std::vector<std::pair<t_uindex, t_uindex>> m_keys;
+};
+
 class PERSPECTIVE_EXPORT t_column {
 public:
 #ifdef PSP_DBG_MALLOC
@@ -124,6 +156,10 @@ public:
 
     void reserve(t_uindex size);
 
+    // Reduce the storage of the column to `size` rows, which must be at
+    // least the current number of rows.
+    void shrink(t_uindex size);
+
     // object storage
     template <typename T>
     void object_copied(t_uindex ptr) const;
@@ -137,6 +173,55 @@ public:
 
     t_uindex size() const;
 
+    // Bytes allocated for the data and validity stores. Vocabularies are
+    // reported separately by `vocab_nbytes()`, as they may be borrowed from
+    // another column.
+    t_uindex nbytes() const;
+    t_uindex vocab_nbytes() const;
+
+    // Bytes of the data, validity and vocabulary stores resident in memory,
+    // and an access hint passed on to each of them - see `t_lstore::advise`.
+    t_uindex resident_nbytes() const;
+    void advise(t_access_advice advice) const;
+
+    // Replace the data and validity stores of an in-memory numeric column
+    // with a block-encoded copy - see `t_compressed_store`. Returns false,
+    // leaving the column as is, when the column cannot be compressed or
+    // encoding would save less than a quarter of its bytes. Any accessor
+    // transparently decompresses the whole column again.
+    bool compress();
+    bool is_compressed() const;
+
+    // Whether the column was accessed since the last call.
+    bool take_read();
+
+    // Whether the column keeps a zone map, i.e. it holds numbers, dates,
+    // times or booleans.
+    bool has_zone_map() const;
+
+    // One `t_zone` per chunk of rows. Chunks written since the last call
+    // are summarised again first; writes through `set_nth`, `set_status`
+    // and appends only dirty the chunks they touch, while any mutable
+    // pointer handed out dirties the whole column.
+    std::vector<t_zone> get_zone_map() const;
+
+    // The smallest and largest valid value in the column, from the zone map.
+    std::pair<t_tscalar, t_tscalar> get_min_max() const;
+
+    // Whether a string column keeps an inverted index of its rows by
+    // vocabulary index. Like the zone map, it is refreshed on lookup for the
+    // chunks written since.
+    void set_indexed(bool indexed);
+    bool is_indexed() const;
+
+    // Set the rows of `mask` that hold one of the vocabulary indices in
+    // `keys`, and those that are not valid if `nulls` is set.
+    void select_indexed(
+        const std::vector<t_uindex>& keys, bool nulls, t_mask& mask
+    ) const;
+
+    bool string_exists(const char* s, t_uindex& interned) const;
+
     t_uindex get_vlenidx() const;
 
     const char* unintern_c(t_uindex idx) const;
@@ -156,6 +241,10 @@ public:
 
     bool is_cleared(t_uindex idx) const;
 
+    // Whether no row is valid or cleared, i.e. the column was absent from the
+    // update that filled it.
+    bool all_invalid() const;
+
     bool is_vlen() const;
 
     void append(const t_column& other);
@@ -163,6 +252,10 @@ public:
     void clear();
     void clear_objects() const;
 
+    // Replace the vocabulary of a string column with an empty one. A
+    // vocabulary borrowed from another column is left untouched.
+    void reset_vocabulary();
+
     template <typename VEC_T>
     void fill(VEC_T& vec, const t_uindex* bidx, const t_uindex* eidx) const;
 
@@ -173,6 +266,19 @@ public:
 
     t_column_recipe get_recipe() const;
 
+    /**
+     * @brief Write the data, status and vocabulary stores of this column to
+     * files named `fname` with a per-store suffix. Empty stores are skipped;
+     * `get_recipe()` records the store sizes `load` needs to read them back.
+     */
+    void save(const std::string& fname) const;
+
+    /**
+     * @brief Replace the contents of this column with the stores written by
+     * `save`, sized by `recipe`, and rebuild the vocabulary's string map.
+     */
+    void load(const std::string& fname, const t_column_recipe& recipe);
+
     // vocabulary must not contain empty string
     // indices should be > 0
     // scalars will be implicitly understood to be of dtype str
@@ -188,8 +294,17 @@ public:
 
     std::shared_ptr<t_column> clone() const;
 
+    // Overwrite this column's values and vocabulary with a copy of `other`,
+    // keeping this column's own stores and their backing.
+    void copy_from(const t_column& other);
+
     std::shared_ptr<t_column> clone(const t_mask& mask) const;
 
+    // Copy the value and status at each `first` row to the `second` row and
+    // clear the `first` row. Used to fill the holes left by removed rows
+    // without copying the rest of the column.
+    void move_rows(const std::vector<std::pair<t_uindex, t_uindex>>& moves);
+
     void valid_raw_fill();
     void invalid_raw_fill();
 
@@ -242,6 +357,56 @@ private:
     bool m_from_recipe;
 
     std::uint32_t m_elemsize;
+
+    // Set by `compress()`, in which case `m_data` and `m_status` are empty
+    // and `m_size` still counts the encoded rows. Mutable as const
+    // accessors must decompress too.
+    mutable std::shared_ptr<t_compressed_store> m_compressed_data;
+    mutable std::shared_ptr<t_compressed_store> m_compressed_status;
+    mutable std::atomic<bool> m_compressed{false};
+    mutable std::atomic<bool> m_read{false};
+
+    void decompress() const;
+
+    // Called by every accessor. The flag is only stored when it changes, so
+    // concurrent readers don't contend for its cache line.
+    void
+    thaw() const {
+        if (!m_read.load(std::memory_order_relaxed)) {
+            m_read.store(true, std::memory_order_relaxed);
+        }
+
+        if (m_compressed.load(std::memory_order_acquire)) {
+            decompress();
+        }
+    }
+
+    // Zone map and index state - see `get_zone_map()` and `is_indexed()`.
+    // `m_chunk_nrows` is the size of the column when the chunks were last
+    // refreshed.
+    bool m_indexed{false};
+    mutable std::mutex m_chunk_mtx;
+    mutable std::vector<t_zone> m_zones;
+    mutable std::vector<t_postings> m_postings;
+    mutable std::vector<std::uint8_t> m_chunk_dirty;
+    mutable t_uindex m_chunk_nrows{0};
+    mutable std::atomic<bool> m_chunks_stale{true};
+
+    void refresh_chunks() const;
+    void refresh_postings(t_uindex nchunks) const;
+
+    void
+    mark_chunk_dirty(t_uindex idx) {
+        t_uindex chunk = idx / DEFAULT_ZONE_MAP_CHUNK_SIZE;
+        if (chunk < m_chunk_dirty.size()) {
+            m_chunk_dirty[chunk] = 1;
+        }
+    }
+
+    void
+    invalidate_chunks() const {
+        m_chunks_stale.store(true, std::memory_order_relaxed);
+    }
 };
 
 template <>
@@ -279,18 +444,23 @@ PERSPECTIVE_EXPORT const char* t_column::get_nth<const char>(t_uindex idx
 template <typename T>
 T*
 t_column::get(t_uindex idx) {
+    thaw();
+    invalidate_chunks();
     return m_data->get<T>(idx);
 }
 
 template <typename T>
 const T*
 t_column::get(t_uindex idx) const {
+    thaw();
     return m_data->get<T>(idx);
 }
 
 template <typename T>
 T*
 t_column::get_nth(t_uindex idx) {
+    thaw();
+    invalidate_chunks();
     COLUMN_CHECK_ACCESS(idx);
     return m_data->get_nth<T>(idx);
 }
@@ -298,6 +468,7 @@ t_column::get_nth(t_uindex idx) {
 template <typename T>
 const T*
 t_column::get_nth(t_uindex idx) const {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     return m_data->get_nth<T>(idx);
 }
@@ -311,6 +482,7 @@ t_column::extend() {
 template <typename T>
 T*
 t_column::extend(t_uindex idx) {
+    thaw();
     T* rv = m_data->extend<T>(idx);
     m_size += idx;
     return rv;
@@ -319,6 +491,7 @@ t_column::extend(t_uindex idx) {
 template <typename DATA_T>
 void
 t_column::push_back(DATA_T elem) {
+    thaw();
     m_data->push_back(elem);
     ++m_size;
 }
@@ -326,6 +499,7 @@ t_column::push_back(DATA_T elem) {
 template <typename DATA_T>
 void
 t_column::push_back(DATA_T elem, t_status status) {
+    thaw();
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Validity not enabled for column");
     m_data->push_back(elem);
     m_status->push_back(status);
@@ -337,8 +511,10 @@ t_column::push_back(DATA_T elem, t_status status) {
 template <typename T>
 void
 t_column::set_nth(t_uindex idx, T v) {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     m_data->set_nth<T>(idx, v);
+    mark_chunk_dirty(idx);
 
     if (is_status_enabled()) {
         m_status->set_nth<t_status>(idx, STATUS_VALID);
@@ -348,8 +524,10 @@ t_column::set_nth(t_uindex idx, T v) {
 template <typename T>
 void
 t_column::set_nth(t_uindex idx, T v, t_status status) {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     m_data->set_nth<T>(idx, v);
+    mark_chunk_dirty(idx);
 
     if (is_status_enabled()) {
         m_status->set_nth<t_status>(idx, status);
@@ -377,10 +555,12 @@ t_column::fill(VEC_T& vec, const t_uindex* bidx, const t_uindex* eidx) const {
 template <typename DATA_T>
 void
 t_column::set_nth_body(t_uindex idx, DATA_T elem, t_status status) {
+    thaw();
     COLUMN_CHECK_ACCESS(idx);
     PSP_VERBOSE_ASSERT(m_dtype == DTYPE_STR, "Setting non string column");
     t_uindex interned = m_vocab->get_interned(elem);
     m_data->set_nth<t_uindex>(idx, interned);
+    mark_chunk_dirty(idx);
 
     if (is_status_enabled()) {
         m_status->set_nth<t_status>(idx, status);
@@ -397,6 +577,8 @@ void t_column::object_cleared<std::uint64_t>(t_uindex ptr) const;
 template <typename DATA_T>
 void
 t_column::raw_fill(DATA_T v) {
+    thaw();
+    invalidate_chunks();
     m_data->raw_fill(v);
 }
 
@@ -0,0 +1,71 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief A copy of a store of fixed-width values, encoded in blocks of
+ * `DEFAULT_COMPRESSION_BLOCK_SIZE` values. Each block uses whichever of
+ * run-length, dictionary, frame-of-reference or delta bit-packing is
+ * smallest for it, or stays raw, and decodes on its own.
+ *
+ * Values are 1, 2, 4 or 8 bytes wide. Signed values are encoded by their
+ * numeric value and everything else by its bit pattern, so floats only
+ * compress through runs or a small set of distinct values.
+ */
+class PERSPECTIVE_EXPORT t_compressed_store {
+public:
+    t_compressed_store();
+
+    /**
+     * @brief Whether values of `dtype` can be encoded.
+     */
+    static bool is_compressible(t_dtype dtype);
+
+    void encode(
+        const void* base, t_uindex nelems, t_uindex elem_size, bool is_signed
+    );
+
+    /**
+     * @brief Decode block `bidx` into `out`, which must have room for
+     * `DEFAULT_COMPRESSION_BLOCK_SIZE` values.
+     */
+    void decode_block(t_uindex bidx, void* out) const;
+
+    /**
+     * @brief Decode every value into `out`, which must have room for
+     * `size()` values.
+     */
+    void decode(void* out) const;
+
+    t_uindex size() const;
+    t_uindex num_blocks() const;
+    t_uindex nbytes() const;
+
+private:
+    t_uindex m_nelems;
+    t_uindex m_elem_size;
+    bool m_signed;
+    std::vector<std::uint8_t> m_bytes;
+    std::vector<t_uindex> m_block_offsets;
+};
+
+} // end namespace perspective
@@ -20,6 +20,7 @@
 #include <perspective/data_table.h>
 #include <perspective/rlookup.h>
 #include <perspective/computed_function.h>
+#include <perspective/expression_kernel.h>
 #include <perspective/gnode_state.h>
 #include <date/date.h>
 #include <tsl/hopscotch_set.h>
@@ -70,6 +71,7 @@ public:
     const std::vector<std::pair<std::string, std::string>>&
     get_column_ids() const;
     t_dtype get_dtype() const;
+    bool is_row_independent() const;
 
 private:
     std::string m_expression_alias;
@@ -77,6 +79,15 @@ private:
     std::string m_parsed_expression_string;
     std::vector<std::pair<std::string, std::string>> m_column_ids;
     t_dtype m_dtype;
+
+    // Vectorized plan for numeric expressions, or `nullptr` if the
+    // expression must be evaluated row-by-row through ExprTk.
+    std::shared_ptr<t_expression_kernel> m_kernel;
+
+    // Whether the expression's result depends only on its input values, i.e.
+    // it does not call `random()`, `now()`, `index()` or other functions
+    // that read the row index, clock or other columns.
+    bool m_is_row_independent;
 };
 
 class PERSPECTIVE_EXPORT t_computed_expression_parser {
@@ -152,6 +152,17 @@ public:
 
     std::string repr() const;
 
+    /**
+     * @brief Returns a key that is equal for two configs exactly when they
+     * build identical sparse trees - the same pivots, aggregates, filters,
+     * expressions and tree sort - regardless of view-level sort and
+     * expansion state. Returns an empty string if the config's trees must
+     * not be shared, e.g. because an expression calls `random()`.
+     *
+     * @return std::string
+     */
+    std::string get_tree_key() const;
+
     t_uindex get_num_aggregates() const;
 
     t_uindex get_num_columns() const;
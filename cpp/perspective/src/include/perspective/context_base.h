@@ -18,11 +18,14 @@
 #include <perspective/schema.h>
 #include <perspective/exports.h>
 #include <perspective/tracing.h>
+#include <perspective/stage_trace.h>
+#include <perspective/memory_usage.h>
 #include <perspective/pivot.h>
 #include <perspective/step_delta.h>
 #include <perspective/slice.h>
 #include <perspective/range.h>
 #include <perspective/gnode_state.h>
+#include <perspective/process_state.h>
 
 namespace perspective {
 
@@ -85,6 +88,8 @@ public:
 
     std::vector<t_tscalar> get_data() const;
 
+    t_stage_trace& get_trace() const;
+
 protected:
     t_schema m_schema;
     t_config m_config;
@@ -94,6 +99,10 @@ protected:
     std::shared_ptr<t_gstate> m_gstate;
     bool m_init;
     std::vector<bool> m_features;
+
+    // Per-view timings for notify and delta serialization, which are written
+    // from the gnode and server rather than by the context itself.
+    mutable t_stage_trace m_trace;
 };
 
 template <typename DERIVED_T>
@@ -144,6 +153,12 @@ t_ctxbase<DERIVED_T>::get_ptr() const {
     return reinterpret_cast<std::int64_t>(this);
 }
 
+template <typename DERIVED_T>
+t_stage_trace&
+t_ctxbase<DERIVED_T>::get_trace() const {
+    return m_trace;
+}
+
 template <typename DERIVED_T>
 void
 t_ctxbase<DERIVED_T>::set_state(std::shared_ptr<t_gstate> gstate) {
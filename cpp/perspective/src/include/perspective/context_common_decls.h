@@ -100,6 +100,13 @@ t_uindex num_expressions() const;
 
 std::shared_ptr<t_expression_tables> get_expression_tables() const;
 
+// Bytes held by the context itself, excluding the gnode's master table.
+t_ctx_memory_usage get_memory_usage() const;
+
+// The columns of the gnode's transitional tables read by `notify`, not
+// including the inputs of the context's expressions.
+t_transitional_needs get_transitional_needs() const;
+
 // Given shared pointers to data tables from the gnode, use them to
 // compute the results of expression columns.
 void compute_expressions(
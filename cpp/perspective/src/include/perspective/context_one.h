@@ -44,13 +44,52 @@ public:
     std::vector<t_tscalar> get_row_path(t_index idx) const;
     void set_depth(t_depth depth);
 
+    /**
+     * @brief The paths of the rows expanded with `open`, so they can be
+     * expanded again after the context is rebuilt. Empty when the expansion
+     * follows `set_depth`, which a rebuild re-applies by itself.
+     */
+    std::vector<t_path> get_expansion_state() const;
+    void set_expansion_state(const std::vector<t_path>& paths);
+
     t_index get_row_idx(const std::vector<t_tscalar>& path) const;
 
     t_depth get_trav_depth(t_index idx) const;
 
+    /**
+     * @brief Returns the changed rows within traversal rows `[bidx, eidx)`
+     * and their data. Unlike `get_row_delta()`, the tree's deltas are not
+     * cleared, so several windows can be read from the same step; callers
+     * must `clear_deltas()` once they are done.
+     */
+    t_rowdelta get_row_delta(t_index bidx, t_index eidx);
+
+    std::vector<t_uindex> get_rows_changed(t_index bidx, t_index eidx) const;
+
     std::pair<t_tscalar, t_tscalar> get_min_max(const std::string& colname
     ) const;
 
+    /**
+     * @brief Back this context with the sparse tree of `other`, which
+     * was built from an identical config (see `t_config::get_tree_key`),
+     * and build this context's traversal over it. Expansion, depth and
+     * sort state stay per-context.
+     */
+    void share_trees(const t_ctx1& other);
+
+    /**
+     * @brief Bring this context's traversal up to date with the last notify
+     * of the tree it shares, without notifying the tree again.
+     */
+    void notify_from_shared_tree();
+
+    /**
+     * @brief Mark whether this context shares its tree with other
+     * contexts. Deltas on shared tree are cleared by the gnode at the
+     * start of each update, not by the contexts that read them.
+     */
+    void set_tree_shared(bool shared);
+
     using t_ctxbase<t_ctx1>::get_data;
 
 private:
@@ -60,6 +99,7 @@ private:
     std::shared_ptr<t_expression_tables> m_expression_tables;
     t_depth m_depth;
     bool m_depth_set;
+    bool m_tree_shared;
 };
 
 } // end namespace perspective
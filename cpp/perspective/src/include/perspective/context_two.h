@@ -56,9 +56,53 @@ public:
 
     void set_depth(t_header header, t_depth depth);
 
+    /**
+     * @brief The paths of the rows or columns expanded with `open`, so they
+     * can be expanded again after the context is rebuilt. Empty when the
+     * expansion follows `set_depth`, which a rebuild re-applies by itself.
+     */
+    std::vector<t_path> get_expansion_state(t_header header) const;
+    void
+    set_expansion_state(t_header header, const std::vector<t_path>& paths);
+
+    /**
+     * @brief Returns the rows with a changed cell inside the given row and
+     * column window, along with their data. Unlike `get_row_delta()`, the
+     * trees' deltas are not cleared, so several windows can be read from the
+     * same step; callers must `clear_deltas()` once they are done.
+     */
+    t_rowdelta get_row_delta(
+        t_index start_row, t_index end_row, t_index start_col, t_index end_col
+    );
+
+    std::vector<t_uindex> get_rows_changed(
+        t_index start_row, t_index end_row, t_index start_col, t_index end_col
+    ) const;
+
     std::pair<t_tscalar, t_tscalar> get_min_max(const std::string& colname
     ) const;
 
+    /**
+     * @brief Back this context with the sparse trees of `other`, which
+     * was built from an identical config (see `t_config::get_tree_key`),
+     * and build this context's traversals over them. Expansion, depth and
+     * sort state stay per-context.
+     */
+    void share_trees(const t_ctx2& other);
+
+    /**
+     * @brief Bring this context's traversals up to date with the last notify
+     * of the trees it shares, without notifying the trees again.
+     */
+    void notify_from_shared_tree();
+
+    /**
+     * @brief Mark whether this context shares its trees with other
+     * contexts. Deltas on shared trees are cleared by the gnode at the
+     * start of each update, not by the contexts that read them.
+     */
+    void set_tree_shared(bool shared);
+
     using t_ctxbase<t_ctx2>::get_data;
 
 protected:
@@ -81,6 +125,12 @@ protected:
 
     t_uindex calc_translated_colidx(t_uindex n_aggs, t_uindex cidx) const;
 
+    /**
+     * @brief Re-sort the row traversal after a notify, moving only the rows
+     * the row tree updated unless the columns the row sort reads changed.
+     */
+    void sort_updated_rows();
+
 private:
     std::shared_ptr<t_traversal> m_rtraversal;
     std::shared_ptr<t_traversal> m_ctraversal;
@@ -93,6 +143,7 @@ private:
     t_depth m_column_depth;
     bool m_column_depth_set;
     std::shared_ptr<t_expression_tables> m_expression_tables;
+    bool m_tree_shared;
 };
 
 } // end namespace perspective
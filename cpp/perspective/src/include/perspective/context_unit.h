@@ -92,6 +92,9 @@ public:
     t_index sidedness() const;
 
     bool get_deltas_enabled() const;
+
+    t_ctx_memory_usage get_memory_usage() const;
+    t_transitional_needs get_transitional_needs() const;
     void set_deltas_enabled(bool enabled_state);
 
     std::vector<t_tscalar>
@@ -21,6 +21,7 @@
 #include <perspective/context_zero.h>
 #include <perspective/context_one.h>
 #include <perspective/context_two.h>
+#include <deque>
 
 namespace perspective {
 /**
@@ -104,6 +105,28 @@ public:
      */
     std::vector<t_tscalar> get_row_path(t_uindex ridx) const;
 
+    t_uindex get_row_depth(t_uindex ridx) const;
+
+    /**
+     * @brief Copy everything serialization reads from the context for rows
+     * `start_row` to `end_row` - row paths, row depths and (optionally)
+     * primary keys - into the slice, along with every string its scalars
+     * point to. Must be called under the pool's read lock; afterwards the
+     * slice can be serialized without the lock, while the context is
+     * updated.
+     *
+     * @param start_row
+     * @param end_row
+     * @param with_row_paths
+     * @param with_pkeys
+     */
+    void snapshot(
+        t_uindex start_row,
+        t_uindex end_row,
+        bool with_row_paths,
+        bool with_pkeys
+    );
+
     std::vector<t_tscalar> get_column_slice(t_uindex cidx) const;
 
     // Getters
@@ -129,6 +152,9 @@ private:
      */
     t_uindex get_slice_idx(t_uindex ridx, t_uindex cidx) const;
 
+    // Point a string scalar at a copy owned by the slice.
+    void own_string(t_tscalar& scalar);
+
     std::shared_ptr<CTX_T> m_ctx;
     t_uindex m_start_row;
     t_uindex m_end_row;
@@ -140,5 +166,14 @@ private:
     std::vector<t_tscalar> m_slice;
     std::vector<std::vector<t_tscalar>> m_column_names;
     std::vector<t_uindex> m_column_indices;
+
+    // Set by `snapshot()`, after which these are read instead of `m_ctx`.
+    bool m_is_snapshot;
+    t_uindex m_snapshot_start_row;
+    t_get_data_extents m_snapshot_extents;
+    std::vector<std::vector<t_tscalar>> m_row_paths;
+    std::vector<t_uindex> m_row_depths;
+    std::vector<std::vector<t_tscalar>> m_pkeys;
+    std::deque<std::string> m_strings;
 };
 } // end namespace perspective
\ No newline at end of file
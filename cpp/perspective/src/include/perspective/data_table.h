@@ -90,6 +90,11 @@ public:
 
     t_uindex size() const;
     t_uindex get_capacity() const;
+
+    // Bytes allocated by all columns, excluding and including their
+    // vocabularies respectively.
+    t_uindex column_nbytes() const;
+    t_uindex nbytes() const;
     t_dtype get_dtype(const std::string& colname) const;
 
     std::shared_ptr<t_column> get_column(std::string_view colname);
@@ -113,6 +118,9 @@ public:
     // Only increment capacity
     void reserve(t_uindex capacity);
 
+    // Reduce capacity to `capacity` rows, or to the table size if larger
+    void shrink(t_uindex capacity);
+
     // Increment capacity and size
     void extend(t_uindex nelems);
 
@@ -129,6 +137,14 @@ public:
 
     std::shared_ptr<t_data_table> flatten() const;
 
+    /**
+     * @brief Flatten into `flattened`, an empty table with the same schema
+     * whose storage is reused rather than allocating a new table.
+     *
+     * @param flattened
+     */
+    void flatten(const std::shared_ptr<t_data_table>& flattened) const;
+
     bool is_pkey_table() const;
     bool is_same_shape(t_data_table& tbl) const;
 
@@ -142,12 +158,25 @@ public:
     void clear();
     void reset();
 
+    // Clear the table and give each string column an empty vocabulary, so a
+    // table reused across updates does not keep every string it has seen.
+    void clear_with_vocabularies();
+
     t_mask
     filter_cpp(t_filter_op combiner, const std::vector<t_fterm>& fterms_) const;
     t_data_table* clone_(const t_mask& mask) const;
     std::shared_ptr<t_data_table> clone(const t_mask& mask) const;
     std::shared_ptr<t_data_table> clone() const;
 
+    /**
+     * @brief Move rows in place for every column in the table - for each
+     * (from, to) pair, the row at `from` is copied to `to` and `from` is
+     * cleared. The table size is not changed.
+     *
+     * @param moves
+     */
+    void move_rows(const std::vector<std::pair<t_uindex, t_uindex>>& moves);
+
     /**
      * @brief Given `other_table`, return a new `t_data_table` that references
      * both the columns of the current table and `table` without making any
@@ -13,6 +13,7 @@
 #pragma once
 #include <perspective/first.h>
 #include <perspective/exports.h>
+#include <cstdint>
 #include <cstdlib>
 
 namespace perspective {
@@ -162,6 +163,107 @@ struct PERSPECTIVE_EXPORT t_env {
         return rv;
     }
 
+    static inline bool
+    disable_expression_kernel() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_EXPRESSION_KERNEL") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_expression_dictionary_eval() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_EXPRESSION_DICTIONARY_EVAL") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_gstate_compaction() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_GSTATE_COMPACTION") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_shared_trees() {
+        static const bool rv = std::getenv("PSP_DISABLE_SHARED_TREES") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_demand_transitions() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_DEMAND_TRANSITIONS") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_column_subset_updates() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_COLUMN_SUBSET_UPDATES") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_table_recycling() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_TABLE_RECYCLING") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_incremental_sort() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_INCREMENTAL_SORT") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_incremental_percentiles() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_INCREMENTAL_PERCENTILES") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_pivot_hash_kernel() {
+        static const bool rv =
+            std::getenv("PSP_DISABLE_PIVOT_HASH_KERNEL") != 0;
+        return rv;
+    }
+
+    static inline bool
+    disable_zone_maps() {
+        static const bool rv = std::getenv("PSP_DISABLE_ZONE_MAPS") != 0;
+        return rv;
+    }
+
+    // Milliseconds a server-hosted view may go without reads or `on_update`
+    // subscriptions before it is suspended. Unset or 0 never suspends views.
+    static inline std::uint64_t
+    view_idle_timeout_ms() {
+        static const std::uint64_t rv = [] {
+            const char* value = std::getenv("PSP_VIEW_IDLE_TIMEOUT_MS");
+            return value != nullptr ? std::strtoull(value, nullptr, 10)
+                                    : 0ULL;
+        }();
+        return rv;
+    }
+
+    // Directory a server keeps table snapshots in. Unset uses a
+    // `perspective` directory in the system temporary directory.
+    static inline const char*
+    storage_dir() {
+        static const char* rv = std::getenv("PSP_STORAGE_DIR");
+        return rv;
+    }
+
+    static inline bool
+    disable_stage_trace() {
+        static const bool rv = std::getenv("PSP_DISABLE_STAGE_TRACE") != 0;
+        return rv;
+    }
+
     static inline bool
     backout_eq_invalid_invalid() {
         static const bool rv =
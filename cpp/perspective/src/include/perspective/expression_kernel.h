@@ -0,0 +1,123 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/column.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace perspective {
+
+enum t_expression_kernel_op {
+    KERNEL_OP_LITERAL,
+    KERNEL_OP_COLUMN,
+    KERNEL_OP_NEG,
+    KERNEL_OP_ADD,
+    KERNEL_OP_SUB,
+    KERNEL_OP_MUL,
+    KERNEL_OP_DIV,
+    KERNEL_OP_MOD,
+    KERNEL_OP_LT,
+    KERNEL_OP_LTE,
+    KERNEL_OP_GT,
+    KERNEL_OP_GTE,
+    KERNEL_OP_EQ,
+    KERNEL_OP_NE,
+    KERNEL_OP_AND,
+    KERNEL_OP_OR,
+    KERNEL_OP_IF
+};
+
+/**
+ * @brief A single instruction in a `t_expression_kernel` plan. Nodes are
+ * stored in post-order, so every operand index is smaller than the index of
+ * the node that consumes it.
+ */
+struct t_expression_kernel_node {
+    t_expression_kernel_op m_op;
+    t_index m_args[3];
+    double m_literal;
+    t_uindex m_column_idx;
+};
+
+/**
+ * @brief A typed, columnar evaluation plan for the subset of expressions that
+ * are plain numeric pipelines - column references, numeric literals,
+ * arithmetic, comparisons, `and`/`or` and `if(cond, a, b)` with a boolean
+ * `cond`.
+ *
+ * The kernel evaluates the plan over the raw column buffers in fixed-size
+ * chunks, keeping a value and validity lane per node so that the inner loops
+ * are branch-free and can be auto-vectorized. Its results are identical to
+ * the ExprTk interpreter over `t_tscalar`: arithmetic always produces
+ * `DTYPE_FLOAT64`, nulls propagate through arithmetic, and division/modulo
+ * by zero produce null. Rows where `t_tscalar` semantics cannot be expressed
+ * in the kernel (a comparison with a null operand) are reported back to the
+ * caller, which evaluates them with the scalar interpreter.
+ */
+class PERSPECTIVE_EXPORT t_expression_kernel {
+public:
+    PSP_NON_COPYABLE(t_expression_kernel);
+
+    t_expression_kernel() = default;
+
+    /**
+     * @brief Lower a parsed expression string (with column names already
+     * replaced by their column IDs) into a kernel plan. Returns `nullptr` if
+     * the expression uses any syntax or function the kernel does not
+     * support, in which case the expression must be evaluated by ExprTk.
+     *
+     * @param parsed_expression_string
+     * @param column_ids
+     * @return std::shared_ptr<t_expression_kernel>
+     */
+    static std::shared_ptr<t_expression_kernel> compile(
+        const std::string& parsed_expression_string,
+        const std::vector<std::pair<std::string, std::string>>& column_ids
+    );
+
+    /**
+     * @brief Evaluate the plan over `num_rows` rows of `inputs` (in the same
+     * order as the `column_ids` the kernel was compiled with), writing into
+     * `output`. Returns false without writing anything if the input or
+     * output types cannot be handled by the kernel. Rows that must be
+     * evaluated by the scalar interpreter are appended to `fallback_rows`.
+     */
+    bool compute(
+        const std::vector<std::shared_ptr<t_column>>& inputs,
+        t_uindex num_rows,
+        t_dtype output_dtype,
+        t_column& output,
+        std::vector<t_uindex>& fallback_rows
+    ) const;
+
+    t_uindex size() const;
+
+private:
+    bool infer_dtypes(
+        const std::vector<std::shared_ptr<t_column>>& inputs,
+        std::vector<t_dtype>& dtypes
+    ) const;
+
+    std::vector<t_expression_kernel_node> m_nodes;
+
+    friend class t_expression_kernel_parser;
+};
+
+} // end namespace perspective
@@ -57,6 +57,9 @@ struct t_expression_tables {
 
     t_data_table* get_table() const;
 
+    // Bytes held by the master and transitional expression tables.
+    t_uindex nbytes() const;
+
     // master table is calculated from t_gstate's master table
     std::shared_ptr<t_data_table> m_master;
 
@@ -46,6 +46,8 @@ public:
 
     void pprint() const;
 
+    t_uindex nbytes() const;
+
 private:
     void allocate_new_vocab();
 
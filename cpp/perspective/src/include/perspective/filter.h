@@ -23,6 +23,8 @@
 
 namespace perspective {
 
+struct t_zone;
+
 // Filter operators
 template <typename DATA_T, template <typename> class OP_T>
 struct t_operator_base {
@@ -170,6 +172,12 @@ struct PERSPECTIVE_EXPORT t_fterm {
 
     void coerce_numeric(t_dtype dtype);
 
+    /**
+     * @brief Whether any row of the chunk summarised by `zone` may pass this
+     * term. Terms that cannot be decided from a zone always return true.
+     */
+    bool may_match(const t_zone& zone) const;
+
     std::string m_colname;
     t_filter_op m_op;
     t_tscalar m_threshold;
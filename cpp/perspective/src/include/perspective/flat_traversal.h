@@ -75,6 +75,9 @@ public:
 
     t_index size() const;
 
+    // Estimated bytes held by the sorted row index and primary key lookups.
+    t_uindex nbytes() const;
+
     void get_row_indices(
         const tsl::hopscotch_set<t_tscalar>& pkeys,
         tsl::hopscotch_map<t_tscalar, t_index>& out_map
@@ -120,6 +123,11 @@ public:
     std::vector<t_sortspec> get_sort_by() const;
     bool empty_sort_by() const;
 
+    // Whether the last update of `gstate` may have changed a column the
+    // traversal sorts by, in which case updated rows must be re-sorted.
+    bool
+    sort_columns_changed(const t_gstate& gstate, const t_config& config) const;
+
     void reset_step_state();
 
     t_uindex lower_bound_row_idx(
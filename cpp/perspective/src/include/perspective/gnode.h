@@ -22,11 +22,14 @@
 #include <perspective/rlookup.h>
 #include <perspective/gnode_state.h>
 #include <perspective/sparse_tree.h>
+#include <perspective/path.h>
 #include <perspective/process_state.h>
 #include <perspective/computed_expression.h>
 #include <perspective/computed_function.h>
 #include <perspective/expression_tables.h>
 #include <perspective/regex.h>
+#include <perspective/stage_trace.h>
+#include <perspective/memory_usage.h>
 #include <tsl/ordered_map.h>
 #include <perspective/parallel_for.h>
 #include <chrono>
@@ -93,7 +96,11 @@ public:
      * @param input_schema
      * @param output_schema
      */
-    t_gnode(t_schema input_schema, t_schema output_schema);
+    t_gnode(
+        t_schema input_schema,
+        t_schema output_schema,
+        t_storage_options storage = t_storage_options()
+    );
     ~t_gnode();
 
     void init();
@@ -108,6 +115,18 @@ public:
      */
     void send(t_uindex port_id, const t_data_table& fragments);
 
+    /**
+     * @brief Returns the number of rows sent to the input ports that have
+     * not been processed yet.
+     */
+    t_uindex num_pending_rows() const;
+
+    /**
+     * @brief Conflate the pending rows of every input port by primary key,
+     * keeping the latest value of each column, without processing them.
+     */
+    void conflate_inputs();
+
     /**
      * @brief Given a port_id, call `process_table` on the port's data table,
      * reconciling all queued calls to `update` and `remove` on that port.
@@ -154,6 +173,46 @@ public:
      */
     void _unregister_context(const std::string& name);
 
+    /**
+     * @brief Stop notifying a registered context on updates, until it is
+     * resumed by `resume_context`. A suspended context is not read from, and
+     * its traversal goes stale while it is suspended.
+     *
+     * @param name
+     */
+    void suspend_context(const std::string& name);
+
+    /**
+     * @brief Re-register a suspended context, rebuilding it from the current
+     * state of the master table.
+     *
+     * @param name
+     */
+    void resume_context(const std::string& name);
+
+    bool is_context_suspended(const std::string& name) const;
+
+    /**
+     * @brief Remove the rows whose `column` value is more than `ttl` older
+     * than the newest value in that column, as updates are processed. An
+     * empty `column` turns retention off.
+     *
+     * @param column
+     * @param ttl
+     */
+    void set_retention(const std::string& column, std::int64_t ttl);
+
+    /**
+     * @brief Queue the removal of the rows the last update on `port_id`
+     * moved out of the retention window, as an update of their own on the
+     * same port. Reads the master table as that update left it, so rows it
+     * refreshed are kept.
+     *
+     * @param port_id
+     * @return whether any rows were queued.
+     */
+    bool queue_expired(t_uindex port_id);
+
     const t_data_table* get_table() const;
     t_data_table* get_table();
 
@@ -196,6 +255,14 @@ public:
 
     t_uindex mapping_size() const;
 
+    /**
+     * @brief Snapshot the gnode state's master table to `dirname`, or
+     * restore it from there - see `t_gstate::save_snapshot`. Restoring is
+     * only valid before any contexts are registered.
+     */
+    void save_snapshot(const std::string& dirname) const;
+    void load_snapshot(const std::string& dirname);
+
     // helper function for JS interface
     void promote_column(const std::string& name, t_dtype new_type);
 
@@ -224,6 +291,18 @@ public:
 
     const t_gstate::t_mapping& get_pkey_map() const;
 
+    /**
+     * @brief Timings for the table-level stages of `process()`; per-view
+     * stages are recorded on each context's own trace.
+     */
+    t_stage_trace& get_trace() const;
+
+    /**
+     * @brief Bytes held by the master table, primary key mapping, expression
+     * vocab and port tables. Contexts report their own usage.
+     */
+    t_gnode_memory_usage get_memory_usage() const;
+
 #ifdef PSP_PARALLEL_FOR
     void set_lock(std::shared_mutex* lock);
 #endif
@@ -277,6 +356,48 @@ protected:
         const std::string& name
     );
 
+    /**
+     * @brief Update a context whose sparse trees are shared with, and have
+     * already been notified by, another context - only the context's own
+     * traversal and sort state need to be brought up to date.
+     *
+     * @tparam CTX_T
+     * @param ctxh
+     * @param num_rows the number of rows in the update, for tracing.
+     */
+    template <typename CTX_T>
+    void notify_context_from_shared_tree(
+        const t_ctx_handle& ctxh, t_uindex num_rows
+    );
+
+    /**
+     * @brief Returns an already registered context of the same type whose
+     * sparse trees can back `ctx`, as both have the same
+     * `t_config::get_tree_key`, or `nullptr` if there is none.
+     *
+     * @tparam CTX_T
+     * @param name the name `ctx` is registered under.
+     * @param type
+     * @param ctx
+     */
+    template <typename CTX_T>
+    CTX_T* _find_shared_tree_context(
+        const std::string& name, t_ctx_type type, const CTX_T* ctx
+    ) const;
+
+    /**
+     * @brief For each context in `ctxhvec`, return the index of the earlier
+     * context whose sparse trees it shares, or `INVALID_INDEX` if it must
+     * notify its own trees. Contexts in a sharing group are marked as
+     * sharing, and the deltas of shared trees are cleared ahead of the
+     * update, as no single context owns them.
+     *
+     * @param ctxhvec
+     * @return std::vector<t_index>
+     */
+    std::vector<t_index>
+    _group_shared_trees(const std::vector<t_ctx_handle>& ctxhvec);
+
     /**
      * @brief Given the process state, create a `t_mask` bitset set to true for
      * all rows in `flattened`, UNLESS the row is an `OP_DELETE`.
@@ -287,10 +408,23 @@ protected:
      */
     t_mask _process_mask_existed_rows(t_process_state& process_state);
 
+    /**
+     * @brief Returns the union of the transitional columns read by each
+     * registered context and by the expressions computed on the
+     * transitional tables for that context.
+     */
+    t_transitional_needs _get_transitional_needs() const;
+
+    template <typename CTX_T>
+    void _merge_transitional_needs(
+        const t_ctx_handle& ctxh, t_transitional_needs& needs
+    ) const;
+
     /**
      * @brief Given a flattened column, the master column from `m_gstate`, and
      * all transitional columns containing metadata, process and calculate
-     * transitional values.
+     * transitional values. Transitional columns that no reader requires are
+     * passed as `nullptr` and left unwritten.
      *
      * @tparam DATA_T
      * @param fcolumn
@@ -358,6 +492,21 @@ protected:
         const std::shared_ptr<t_data_table>& flattened
     );
 
+    /**
+     * @brief Compact the gnode state's master table after rows have been
+     * removed, applying the same row moves to the master expression table
+     * of every registered context so they stay aligned with the gstate.
+     */
+    void _compact_state();
+
+    /**
+     * @brief Returns an empty table to flatten `input` into, reusing the
+     * previous update's flattened table when nothing outside the gnode
+     * still holds it, or `nullptr` if a new table must be allocated.
+     */
+    std::shared_ptr<t_data_table>
+    _get_flatten_target(const t_data_table& input);
+
 private:
     /**
      * @brief Process the input data table by flattening it, calculating
@@ -376,6 +525,9 @@ private:
     // A `t_schema` containing all columns (excluding internal columns).
     t_schema m_output_schema;
 
+    // Where the gnode state's master table keeps its columns.
+    t_storage_options m_storage;
+
     // A vector of `t_schema`s for each transitional `t_data_table`.
     std::vector<t_schema> m_transitional_schemas;
 
@@ -392,6 +544,25 @@ private:
     // `t_gnode_port` enum.
     std::vector<std::shared_ptr<t_port>> m_oports;
     tsl::ordered_map<std::string, t_ctx_handle> m_contexts;
+
+    // A context removed from `m_contexts` by `suspend_context`, along with
+    // the rows and columns it had expanded, which its rebuild on resume
+    // would otherwise lose.
+    struct t_suspended_context {
+        t_ctx_handle m_ctxh;
+        std::vector<t_path> m_row_expansions;
+        std::vector<t_path> m_column_expansions;
+    };
+
+    // Contexts removed from `m_contexts` by `suspend_context`, which skip
+    // notification and expression computation until they are resumed.
+    tsl::ordered_map<std::string, t_suspended_context> m_suspended_contexts;
+
+    // The column and window set by `set_retention`, or an empty column name
+    // if rows are never evicted.
+    std::string m_retention_column;
+    std::int64_t m_retention_ttl;
+
     std::shared_ptr<t_gstate> m_gstate;
 
     std::chrono::high_resolution_clock::time_point m_epoch;
@@ -401,6 +572,8 @@ private:
     std::shared_ptr<t_expression_vocab> m_expression_vocab;
     std::shared_ptr<t_regex_mapping> m_expression_regex_mapping;
 
+    mutable t_stage_trace m_trace;
+
 #ifdef PSP_PARALLEL_FOR
     std::shared_mutex* m_lock;
 #endif
@@ -436,6 +609,10 @@ t_gnode::notify_context(
     // be used as-is from the gnode.
     const t_data_table& existed = *(m_oports[PSP_PORT_EXISTED]->get_table());
 
+    t_stage_timer timer(
+        ctx->get_trace(), TRACE_STAGE_CONTEXT_NOTIFY, flattened->size()
+    );
+
     ctx->step_begin();
 
     if (ctx->num_expressions() > 0) {
@@ -496,6 +673,10 @@ t_gnode::update_context_from_state(
         return;
     }
 
+    t_stage_timer timer(
+        ctx->get_trace(), TRACE_STAGE_CONTEXT_NOTIFY, flattened->size()
+    );
+
     ctx->step_begin();
 
     // This method is called in two places:
@@ -533,6 +714,33 @@ void t_gnode::_process_column<std::string>(
     const t_process_state& process_state
 );
 
+template <typename CTX_T>
+void
+t_gnode::_merge_transitional_needs(
+    const t_ctx_handle& ctxh, t_transitional_needs& needs
+) const {
+    const CTX_T* ctx = static_cast<const CTX_T*>(ctxh.m_ctx);
+    needs.merge(ctx->get_transitional_needs());
+
+    // Expressions are computed on `delta`, `prev` and `current` from their
+    // input columns, unless they can read arbitrary columns through `col()`
+    // or `vlookup()`.
+    for (const auto& expr : ctx->get_config().get_expressions()) {
+        if (!expr->is_row_independent()) {
+            needs.require_all();
+            return;
+        }
+
+        for (const auto& [column_id, column_name] : expr->get_column_ids()) {
+            needs.require(
+                column_name,
+                TRANSITIONAL_TABLE_DELTA | TRANSITIONAL_TABLE_PREV
+                    | TRANSITIONAL_TABLE_CURRENT
+            );
+        }
+    }
+}
+
 template <typename DATA_T>
 void
 t_gnode::_process_column(
@@ -583,22 +791,31 @@ t_gnode::_process_column(
                     prev_pkey_eq
                 );
 
-                dcolumn->set_nth<DATA_T>(
-                    added_count, cur_valid ? cur_value - prev_value : DATA_T(0)
-                );
-                dcolumn->set_valid(added_count, true);
+                if (dcolumn != nullptr) {
+                    dcolumn->set_nth<DATA_T>(
+                        added_count,
+                        cur_valid ? cur_value - prev_value : DATA_T(0)
+                    );
+                    dcolumn->set_valid(added_count, true);
+                }
 
-                pcolumn->set_nth<DATA_T>(added_count, prev_value);
-                pcolumn->set_valid(added_count, prev_valid);
+                if (pcolumn != nullptr) {
+                    pcolumn->set_nth<DATA_T>(added_count, prev_value);
+                    pcolumn->set_valid(added_count, prev_valid);
+                }
 
-                ccolumn->set_nth<DATA_T>(
-                    added_count, cur_valid ? cur_value : prev_value
-                );
-                ccolumn->set_valid(
-                    added_count, cur_valid ? cur_valid : prev_valid
-                );
+                if (ccolumn != nullptr) {
+                    ccolumn->set_nth<DATA_T>(
+                        added_count, cur_valid ? cur_value : prev_value
+                    );
+                    ccolumn->set_valid(
+                        added_count, cur_valid ? cur_valid : prev_valid
+                    );
+                }
 
-                tcolumn->set_nth<std::uint8_t>(idx, trans);
+                if (tcolumn != nullptr) {
+                    tcolumn->set_nth<std::uint8_t>(idx, trans);
+                }
             } break;
             case OP_DELETE: {
                 if (row_pre_existed) {
@@ -606,20 +823,28 @@ t_gnode::_process_column(
                         *(scolumn->get_nth<DATA_T>(rlookup.m_idx));
                     bool prev_valid = scolumn->is_valid(rlookup.m_idx);
 
-                    pcolumn->set_nth<DATA_T>(added_count, prev_value);
-                    pcolumn->set_valid(added_count, prev_valid);
-
-                    ccolumn->set_nth<DATA_T>(added_count, prev_value);
-                    ccolumn->set_valid(added_count, prev_valid);
-
-                    SUPPRESS_WARNINGS_VC(4146)
-                    dcolumn->set_nth<DATA_T>(added_count, -prev_value);
-                    RESTORE_WARNINGS_VC()
-                    dcolumn->set_valid(added_count, true);
-
-                    tcolumn->set_nth<std::uint8_t>(
-                        added_count, VALUE_TRANSITION_NEQ_TDF
-                    );
+                    if (pcolumn != nullptr) {
+                        pcolumn->set_nth<DATA_T>(added_count, prev_value);
+                        pcolumn->set_valid(added_count, prev_valid);
+                    }
+
+                    if (ccolumn != nullptr) {
+                        ccolumn->set_nth<DATA_T>(added_count, prev_value);
+                        ccolumn->set_valid(added_count, prev_valid);
+                    }
+
+                    if (dcolumn != nullptr) {
+                        SUPPRESS_WARNINGS_VC(4146)
+                        dcolumn->set_nth<DATA_T>(added_count, -prev_value);
+                        RESTORE_WARNINGS_VC()
+                        dcolumn->set_valid(added_count, true);
+                    }
+
+                    if (tcolumn != nullptr) {
+                        tcolumn->set_nth<std::uint8_t>(
+                            added_count, VALUE_TRANSITION_NEQ_TDF
+                        );
+                    }
                 }
             } break;
             default: {
@@ -46,8 +46,13 @@ public:
      *
      * @param input_schema
      * @param output_schema
+     * @param storage where the master table keeps its columns.
      */
-    t_gstate(t_schema input_schema, t_schema output_schema);
+    t_gstate(
+        t_schema input_schema,
+        t_schema output_schema,
+        t_storage_options storage = t_storage_options()
+    );
 
     ~t_gstate();
 
@@ -77,8 +82,39 @@ public:
      * by `t_gnode::_process_table`.
      *
      * @param flattened
+     * @param updated_columns if not `nullptr`, the only columns that hold
+     * values in `flattened` - every other column is left untouched.
+     */
+    void update_master_table(
+        const t_data_table* flattened,
+        const tsl::hopscotch_set<std::string>* updated_columns = nullptr
+    );
+
+    /**
+     * @brief Whether the last call to `update_master_table` added or removed
+     * any rows, as opposed to only updating values of existing rows.
+     */
+    bool rows_changed_by_last_update() const;
+
+    /**
+     * @brief Whether the last call to `update_master_table` may have changed
+     * values in `colname`. Columns not in the master table, such as
+     * expression columns, are always reported as changed.
+     */
+    bool column_changed_by_last_update(const std::string& colname) const;
+
+    /**
+     * @brief Fill the holes left in the master `t_data_table` by removed rows
+     * with live rows from the end of the table, then shrink the table so that
+     * every row maps to a primary key again. This touches only as many rows
+     * as were removed, and keeps `get_pkeyed_table` from having to copy the
+     * whole table through a mask.
+     *
+     * @return std::vector<std::pair<t_uindex, t_uindex>> the (from, to) row
+     * moves that were applied, so that tables aligned to the master table's
+     * row indices can apply the same moves.
      */
-    void update_master_table(const t_data_table* flattened);
+    std::vector<std::pair<t_uindex, t_uindex>> compact();
 
     /**
      * @brief Given a column in the master data table and the corresponding
@@ -226,6 +262,14 @@ public:
      */
     t_uindex mapping_size() const;
 
+    /**
+     * @brief Returns the estimated bytes held by the primary key mapping and
+     * the free list of reusable row indices.
+     *
+     * @return t_uindex
+     */
+    t_uindex mapping_nbytes() const;
+
     /**
      * @brief Resets the gnode state and its master `t_data_table` and
      * mapping.
@@ -233,6 +277,26 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Write the master `t_data_table` and free row list to
+     * `dirname`, one file per column store plus a manifest of store sizes.
+     * Store files hold the raw column bytes, so they can be mapped back in
+     * without parsing.
+     *
+     * @param dirname
+     */
+    void save_snapshot(const std::string& dirname) const;
+
+    /**
+     * @brief Restore a snapshot written by `save_snapshot` into this empty
+     * `t_gstate`, then rebuild the primary key mapping from the restored
+     * `psp_pkey` column. Throws, before loading any column, if the manifest
+     * is corrupt or does not match the input schema or the store files.
+     *
+     * @param dirname
+     */
+    void load_snapshot(const std::string& dirname);
+
     // Getters
     std::shared_ptr<t_data_table> get_table() const;
     std::shared_ptr<t_data_table> get_pkeyed_table() const;
@@ -274,6 +338,27 @@ protected:
      */
     t_mask get_cpp_mask() const;
 
+    /**
+     * @brief If the master table is disk backed and more of it is resident
+     * than the storage options' budget allows, page out columns, starting
+     * with those the last update did not touch, until it fits.
+     */
+    void enforce_resident_budget();
+
+    /**
+     * @brief Count one more idle update for each master table column the
+     * last update did not write and nothing read since, and compress the
+     * columns that have been idle for the storage options'
+     * `m_compress_after_updates` updates.
+     */
+    void compress_idle_columns();
+
+    /**
+     * @brief Enable the inverted index of the master table columns named by
+     * the storage options' `m_indexed_columns`.
+     */
+    void index_columns();
+
     void _mark_deleted(t_uindex idx);
     bool has_pkey(t_tscalar pkey) const;
     t_dtype get_pkey_dtype() const;
@@ -287,6 +372,7 @@ private:
 
     t_schema m_input_schema;  // pkeyed
     t_schema m_output_schema; // tblschema
+    t_storage_options m_storage;
 
     bool m_init;
     std::shared_ptr<t_data_table> m_table;
@@ -295,6 +381,15 @@ private:
     t_symtable m_symtable;
     std::shared_ptr<t_column> m_pkcol;
     std::shared_ptr<t_column> m_opcol;
+
+    // What the last `update_master_table` touched; all columns are considered
+    // updated when `m_last_update_all_columns` is set.
+    bool m_last_update_rows_changed;
+    bool m_last_update_all_columns;
+    tsl::hopscotch_set<std::string> m_last_updated_columns;
+
+    // Consecutive idle updates per master table column, by schema index.
+    std::vector<t_uindex> m_idle_updates;
 };
 
 template <typename FN_T>
@@ -43,6 +43,9 @@ public:
     t_mask& operator^=(const t_mask& b);
     t_mask& operator-=(const t_mask& b);
 
+    // Invert every bit.
+    void flip();
+
     t_uindex find_first() const;
     t_uindex find_next(t_uindex pos) const;
     static const t_uindex m_npos = boost::dynamic_bitset<>::npos;
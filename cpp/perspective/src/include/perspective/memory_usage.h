@@ -0,0 +1,100 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+
+#include <cstdint>
+
+namespace perspective {
+
+/**
+ * @brief Bytes held by a `t_gnode` on behalf of a single table, as reported
+ * by `ServerSystemInfoReq`.
+ */
+struct PERSPECTIVE_EXPORT t_gnode_memory_usage {
+    t_gnode_memory_usage();
+
+    t_uindex total() const;
+
+    // Data and validity buffers of the master table's columns.
+    t_uindex m_column_bytes;
+
+    // String vocabularies of the master table's columns.
+    t_uindex m_vocab_bytes;
+
+    // The primary key -> row index mapping and its free list.
+    t_uindex m_mapping_bytes;
+
+    // Strings interned by expressions across all contexts.
+    t_uindex m_expression_vocab_bytes;
+
+    // Input and output port tables, which are transitional but keep their
+    // capacity between updates.
+    t_uindex m_port_bytes;
+};
+
+/**
+ * @brief Bytes held by a single context, as reported by
+ * `ServerSystemInfoReq`.
+ */
+struct PERSPECTIVE_EXPORT t_ctx_memory_usage {
+    t_ctx_memory_usage();
+
+    t_uindex total() const;
+
+    // Sparse tree nodes, indices and aggregate tables.
+    t_uindex m_tree_bytes;
+
+    // Row/column traversals, including the sorted index of flat contexts.
+    t_uindex m_traversal_bytes;
+
+    // The context's expression columns.
+    t_uindex m_expression_bytes;
+
+    // Step deltas retained between updates.
+    t_uindex m_delta_bytes;
+};
+
+/**
+ * @brief Approximate per-element overhead of node-based containers, used to
+ * estimate the size of `std::set`/`std::map` and boost `multi_index`
+ * indices, which do not expose their allocations.
+ */
+const t_uindex PSP_ORDERED_INDEX_NODE_BYTES = 3 * sizeof(void*);
+const t_uindex PSP_HASHED_INDEX_NODE_BYTES = 2 * sizeof(void*);
+
+/**
+ * @brief Estimate the bytes allocated by a `tsl` open-addressing hash map or
+ * set: each bucket stores its value inline alongside a neighborhood bitmap.
+ */
+template <typename T>
+t_uindex
+hash_container_nbytes(const T& container) {
+    return container.bucket_count()
+        * (sizeof(typename T::value_type) + sizeof(std::uint64_t));
+}
+
+/**
+ * @brief Estimate the bytes allocated by a node-based ordered container.
+ */
+template <typename T>
+t_uindex
+ordered_container_nbytes(const T& container) {
+    return container.size()
+        * (sizeof(typename T::value_type) + PSP_ORDERED_INDEX_NODE_BYTES);
+}
+
+} // end namespace perspective
@@ -21,12 +21,91 @@
 #include <perspective/node_processor_types.h>
 #include <perspective/partition.h>
 #include <perspective/mask.h>
+#include <perspective/env_vars.h>
+#include <perspective/parallel_for.h>
+#include <tsl/hopscotch_map.h>
+#include <array>
 #include <csignal>
 #include <cmath>
 #include <map>
+#include <numeric>
+#include <type_traits>
 
 namespace perspective {
 
+/**
+ * @brief The raw type `t_pivot_processor` groups a pivot column's values by:
+ * the vocab index for strings, or the stored value for integral, date, time
+ * and boolean columns. Floating point columns are grouped as `t_tscalar`s,
+ * as NaNs would not hash to a single group.
+ */
+template <int DTYPE_T>
+struct t_pivot_key {
+    typedef void type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_STR> {
+    typedef t_uindex type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_INT64> {
+    typedef std::int64_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_INT32> {
+    typedef std::int32_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_INT16> {
+    typedef std::int16_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_INT8> {
+    typedef std::int8_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_UINT64> {
+    typedef std::uint64_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_UINT32> {
+    typedef std::uint32_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_UINT16> {
+    typedef std::uint16_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_UINT8> {
+    typedef std::uint8_t type;
+};
+
+template <>
+struct t_pivot_key<DTYPE_BOOL> {
+    typedef bool type;
+};
+
+// Stored as the raw `t_time` milliseconds.
+template <>
+struct t_pivot_key<DTYPE_TIME> {
+    typedef std::int64_t type;
+};
+
+// Stored as the raw packed `t_date`.
+template <>
+struct t_pivot_key<DTYPE_DATE> {
+    typedef std::uint32_t type;
+};
+
 template <int DTYPE_T>
 struct t_pivot_processor {
     typedef t_chunk_value_span<t_tscalar> t_spans;
@@ -47,8 +126,136 @@ struct t_pivot_processor {
         t_uindex neidx,
         const t_mask* mask
     );
+
+    /**
+     * @brief Pivot each parent's leaves by hashing their raw values, sorting
+     * only the distinct values, and scattering the leaves into place with a
+     * counting pass. Parents are pivoted in parallel.
+     */
+    template <typename KEY_T>
+    t_uindex pivot_hashed(
+        const t_column* data,
+        std::vector<t_dense_tnode>* nodes,
+        t_column* values,
+        t_column* leaves,
+        t_uindex nbidx,
+        t_uindex neidx
+    );
 };
 
+template <int DTYPE_T>
+template <typename KEY_T>
+t_uindex
+t_pivot_processor<DTYPE_T>::pivot_hashed(
+    const t_column* data,
+    std::vector<t_dense_tnode>* nodes,
+    t_column* values,
+    t_column* leaves,
+    t_uindex nbidx,
+    t_uindex neidx
+) {
+    t_lstore lcopy(leaves->data_lstore(), t_lstore_tmp_init_tag());
+
+    t_uindex* leaves_ptr = leaves->get_nth<t_uindex>(0);
+    t_uindex* lcopy_ptr = lcopy.get_nth<t_uindex>(0);
+    t_uindex nparents = neidx - nbidx;
+    bool has_status = data->is_status_enabled();
+
+    // Each parent's child values and leaf counts, in sort order.
+    std::vector<std::vector<t_tscalar>> child_values(nparents);
+    std::vector<std::vector<t_uindex>> child_counts(nparents);
+
+    parallel_for(int(nparents), [&](int pidx) {
+        const t_dense_tnode& pnode = (*nodes)[nbidx + pidx];
+        t_uindex cbidx = pnode.m_flidx;
+        t_uindex nleaves = pnode.m_nleaves;
+
+        // Raw values are only equal as `t_tscalar`s if their statuses are
+        // too, so each status has its own groups. Groups are numbered in
+        // the order they are first seen.
+        std::array<tsl::hopscotch_map<KEY_T, t_uindex>, STATUS_CLEAR + 1>
+            groups;
+        std::vector<t_uindex> leaf_groups(nleaves);
+        std::vector<t_uindex> group_leaves;
+        std::vector<t_uindex> group_counts;
+
+        for (t_uindex idx = 0; idx < nleaves; ++idx) {
+            t_uindex leaf = leaves_ptr[cbidx + idx];
+            t_status status =
+                has_status ? *(data->get_nth_status(leaf)) : STATUS_VALID;
+            auto [iter, inserted] = groups[status].emplace(
+                *(data->get_nth<KEY_T>(leaf)), group_counts.size()
+            );
+
+            if (inserted) {
+                group_leaves.push_back(leaf);
+                group_counts.push_back(0);
+            }
+
+            leaf_groups[idx] = iter->second;
+            ++group_counts[iter->second];
+        }
+
+        t_uindex ngroups = group_counts.size();
+        std::vector<t_tscalar> group_values(ngroups);
+        for (t_uindex gidx = 0; gidx < ngroups; ++gidx) {
+            group_values[gidx] = data->get_scalar(group_leaves[gidx]);
+        }
+
+        std::vector<t_uindex> order(ngroups);
+        std::iota(order.begin(), order.end(), 0);
+        t_comparator<t_tscalar, DTYPE_T> cmp;
+        std::sort(order.begin(), order.end(), [&](t_uindex a, t_uindex b) {
+            return cmp(group_values[a], group_values[b]);
+        });
+
+        // Each group's leaves start after those of the groups sorted
+        // before it.
+        std::vector<t_uindex> cursors(ngroups);
+        t_uindex offset = cbidx;
+        child_values[pidx].reserve(ngroups);
+        child_counts[pidx].reserve(ngroups);
+
+        for (auto gidx : order) {
+            cursors[gidx] = offset;
+            offset += group_counts[gidx];
+            child_values[pidx].push_back(group_values[gidx]);
+            child_counts[pidx].push_back(group_counts[gidx]);
+        }
+
+        for (t_uindex idx = 0; idx < nleaves; ++idx) {
+            lcopy_ptr[cursors[leaf_groups[idx]]++] = leaves_ptr[cbidx + idx];
+        }
+    });
+
+    t_uindex lvl_nidx = neidx;
+
+    for (t_uindex pidx = 0; pidx < nparents; ++pidx) {
+        t_dense_tnode* pnode = &nodes->at(nbidx + pidx);
+        t_uindex parent_idx = pnode->m_idx;
+        t_uindex flidx = pnode->m_flidx;
+
+        pnode->m_fcidx = lvl_nidx;
+        pnode->m_nchild = child_values[pidx].size();
+
+        for (t_uindex cidx = 0, loop_end = child_values[pidx].size();
+             cidx < loop_end;
+             ++cidx) {
+            t_uindex nleaves = child_counts[pidx][cidx];
+            nodes->push_back({lvl_nidx, parent_idx, 0, 0, flidx, nleaves});
+            flidx += nleaves;
+            lvl_nidx += 1;
+            values->push_back<t_tscalar>(child_values[pidx][cidx]);
+        }
+    }
+
+    t_lstore* llstore = leaves->_get_data_lstore();
+
+    memcpy(leaves_ptr, lcopy_ptr, llstore->size());
+
+    return lvl_nidx;
+}
+
 template <int DTYPE_T>
 t_uindex
 t_pivot_processor<DTYPE_T>::operator()(
@@ -61,6 +268,14 @@ t_pivot_processor<DTYPE_T>::operator()(
     t_uindex neidx,
     const t_mask* mask
 ) {
+    typedef typename t_pivot_key<DTYPE_T>::type t_key;
+    if constexpr (!std::is_void_v<t_key>) {
+        if (!t_env::disable_pivot_hash_kernel()) {
+            return pivot_hashed<t_key>(
+                data, nodes, values, leaves, nbidx, neidx
+            );
+        }
+    }
 
     t_lstore lcopy(leaves->data_lstore(), t_lstore_tmp_init_tag());
 
@@ -0,0 +1,80 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <tsl/hopscotch_map.h>
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace perspective {
+
+PERSPECTIVE_EXPORT bool is_percentile_aggtype(t_aggtype agg);
+
+/**
+ * @brief Returns the percentile computed by an exact or approximate
+ * percentile aggregate, i.e. 50 for `AGGTYPE_MEDIAN` and 90 for
+ * `AGGTYPE_APPROX_P90`.
+ */
+PERSPECTIVE_EXPORT std::uint32_t get_aggtype_percentile(t_aggtype agg);
+
+/**
+ * @brief Returns the value at `percentile` of `values`: the value at index
+ * `floor(percentile * n / 100)` of the sorted values, or for floating point
+ * values where `percentile * n / 100` is a whole number, the mean of that
+ * value and the one before it. NaNs have no order, and are skipped.
+ */
+PERSPECTIVE_EXPORT t_tscalar
+get_percentile(std::vector<t_tscalar>& values, std::uint32_t percentile);
+
+/**
+ * @brief The exact value at a percentile of a set of rows, kept up to date
+ * as rows are inserted, updated and erased.
+ *
+ * The values are split into a lower multiset holding the smallest
+ * `floor(percentile * n / 100) + 1` values and an upper multiset holding
+ * the rest, so the percentile is the largest value of the lower multiset
+ * and every update moves at most one value across. Results are identical
+ * to `get_percentile` over the same values.
+ */
+class PERSPECTIVE_EXPORT t_order_statistic {
+public:
+    explicit t_order_statistic(std::uint32_t percentile);
+
+    /**
+     * @brief Set the value of the row with primary key `pkey`, inserting
+     * the row if it is not already in the set.
+     */
+    void insert(const t_tscalar& pkey, const t_tscalar& value);
+
+    void erase(const t_tscalar& pkey);
+
+    t_tscalar value() const;
+
+    t_uindex size() const;
+
+private:
+    void rebalance();
+
+    std::uint32_t m_percentile;
+    tsl::hopscotch_map<t_tscalar, t_tscalar> m_values;
+    std::multiset<t_tscalar> m_lower;
+    std::multiset<t_tscalar> m_upper;
+};
+
+} // end namespace perspective
@@ -14,6 +14,7 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/data_table.h>
+#include <tsl/hopscotch_set.h>
 
 namespace perspective {
 
@@ -36,16 +37,43 @@ public:
 
     t_schema get_schema() const;
 
+    /**
+     * @brief Returns the names of the columns that held at least one valid or
+     * cleared value in any table sent to the port since it was last released
+     * or cleared. Every column is included once a table with removes has been
+     * sent, as removes touch every column of the removed rows.
+     */
+    const tsl::hopscotch_set<std::string>& get_updated_columns() const;
+
     void release();
     void release_or_clear();
     void clear();
 
+    /**
+     * @brief Clear the table but keep its storage for the next update. The
+     * largest table seen over each window of `DEFAULT_RECYCLE_WINDOW`
+     * recycles is tracked, and storage that has grown far beyond it (after a
+     * single large update, for example) is shrunk at the end of the window.
+     */
+    void recycle();
+
+    /**
+     * @brief Replace the pending table with its flattened form, so that rows
+     * sent for the same primary key are conflated to their latest values.
+     */
+    void conflate();
+
 private:
+    void mark_updated_columns(const t_data_table& table);
+
     // t_port_mode m_mode;
     t_schema m_schema;
     bool m_init;
     std::shared_ptr<t_data_table> m_table;
     t_uindex m_prevsize;
+    t_uindex m_high_water;
+    t_uindex m_recycle_count;
+    tsl::hopscotch_set<std::string> m_updated_columns;
 };
 
 } // end namespace perspective
@@ -16,9 +16,56 @@
 #include <perspective/port.h>
 #include <perspective/schema.h>
 #include <perspective/rlookup.h>
+#include <tsl/hopscotch_map.h>
 
 namespace perspective {
 
+/**
+ * @brief Flags for the transitional `t_data_table`s that
+ * `t_gnode::_process_table` writes per column. `existed` is not listed, as it
+ * is written per row and is always available to contexts.
+ */
+enum t_transitional_table {
+    TRANSITIONAL_TABLE_DELTA = 1,
+    TRANSITIONAL_TABLE_PREV = 1 << 1,
+    TRANSITIONAL_TABLE_CURRENT = 1 << 2,
+    TRANSITIONAL_TABLE_TRANSITIONS = 1 << 3,
+    TRANSITIONAL_TABLE_ALL = (1 << 4) - 1
+};
+
+/**
+ * @brief The columns of the transitional tables that a reader (a context's
+ * `notify`, or the expressions computed on the transitional tables) depends
+ * on, as a bitmask of `t_transitional_table` per column name. Columns that
+ * are not required are left unwritten by `t_gnode::_process_table`.
+ */
+struct t_transitional_needs {
+    t_transitional_needs();
+
+    /**
+     * @brief Mark the tables in the `t_transitional_table` bitmask `tables`
+     * as required for the column `colname`.
+     */
+    void require(const std::string& colname, std::uint8_t tables);
+
+    /**
+     * @brief Mark every table as required for every column, for readers that
+     * cannot enumerate the columns they depend on.
+     */
+    void require_all();
+
+    void merge(const t_transitional_needs& other);
+
+    /**
+     * @brief Returns the bitmask of tables required for `colname`, which is
+     * 0 if the column does not need to be processed at all.
+     */
+    std::uint8_t get(const std::string& colname) const;
+
+    bool m_all;
+    tsl::hopscotch_map<std::string, std::uint8_t> m_columns;
+};
+
 /**
  * @brief Manages the intermediate data structures and transitional
  * `t_data_table`s associated with a single call to `t_gnode::_process_table`.
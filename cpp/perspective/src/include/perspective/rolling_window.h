@@ -0,0 +1,110 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <tsl/hopscotch_map.h>
+
+#include <cstdint>
+#include <set>
+#include <utility>
+
+namespace perspective {
+
+/**
+ * @brief Whether `agg` is a rolling window aggregate, i.e. one computed over
+ * the rows of a node whose order column is within a window width of the
+ * node's newest row.
+ */
+PERSPECTIVE_EXPORT bool is_rolling_aggtype(t_aggtype agg);
+
+/**
+ * @brief Whether `dtype` can order the rows of a rolling window aggregate.
+ */
+PERSPECTIVE_EXPORT bool is_rolling_order_dtype(t_dtype dtype);
+
+/**
+ * @brief A rolling window aggregate over a set of rows, kept up to date as
+ * rows are inserted, updated and erased.
+ *
+ * The window holds the rows whose order value is greater than the newest
+ * order value minus the width. Rows are indexed by their order value, so
+ * when the newest value moves, only the rows that enter or leave the window
+ * are visited. Sums and counts are kept as running totals; minimums and
+ * maximums in a multiset of the values in the window. Null and NaN values
+ * take part in ordering, but not in the aggregate.
+ */
+class PERSPECTIVE_EXPORT t_rolling_window {
+public:
+    t_rolling_window(t_aggtype agg, std::int64_t width);
+
+    /**
+     * @brief Set the order, value and weight of the row with primary key
+     * `pkey`, inserting the row if it is not already in the set. `weight`
+     * is only read by `AGGTYPE_ROLLING_WEIGHTED_MEAN`.
+     */
+    void insert(
+        const t_tscalar& pkey,
+        const t_tscalar& order,
+        const t_tscalar& value,
+        const t_tscalar& weight
+    );
+
+    void erase(const t_tscalar& pkey);
+
+    t_tscalar value() const;
+
+    t_uindex size() const;
+
+private:
+    struct t_row {
+        bool m_has_order;
+        std::int64_t m_order;
+        t_tscalar m_value;
+        double m_weight;
+        bool m_has_weight;
+    };
+
+    typedef std::pair<std::int64_t, t_tscalar> t_order_entry;
+
+    // Orders entries by their order value, then primary key, and also
+    // compares them to bare order values for range lookups.
+    struct t_order_less {
+        typedef void is_transparent;
+
+        bool operator()(const t_order_entry& a, const t_order_entry& b) const;
+        bool operator()(const t_order_entry& a, std::int64_t b) const;
+        bool operator()(std::int64_t a, const t_order_entry& b) const;
+    };
+
+    void enter(const t_row& row);
+    void leave(const t_row& row);
+    void move_window();
+
+    t_aggtype m_agg;
+    std::int64_t m_width;
+    std::int64_t m_cutoff;
+    tsl::hopscotch_map<t_tscalar, t_row> m_rows;
+    std::set<t_order_entry, t_order_less> m_order;
+
+    t_uindex m_count;
+    double m_sum;
+    double m_weighted_sum;
+    double m_weight;
+    std::multiset<t_tscalar> m_values;
+};
+
+} // end namespace perspective
@@ -16,11 +16,15 @@
 #include "perspective/exports.h"
 #include "perspective/raw_types.h"
 #include "perspective/schema.h"
+#include "perspective/stage_trace.h"
+#include "perspective/memory_usage.h"
 #include "perspective/view.h"
 #include "perspective/view_config.h"
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <tsl/hopscotch_set.h>
+#include <optional>
 #include <utility>
 #include <perspective/table.h>
 #include <string>
@@ -222,6 +226,16 @@ namespace server {
         [[nodiscard]]
         virtual std::shared_ptr<std::string> get_row_delta_as_arrow() const = 0;
 
+        [[nodiscard]]
+        virtual std::shared_ptr<std::string> get_row_delta_as_arrow(
+            t_uindex start_row,
+            t_uindex end_row,
+            t_uindex start_col,
+            t_uindex end_col
+        ) const = 0;
+
+        virtual void clear_deltas() = 0;
+
         virtual void set_deltas_enabled(bool enabled_state) = 0;
         [[nodiscard]]
         virtual bool get_deltas_enabled() const = 0;
@@ -231,6 +245,12 @@ namespace server {
         virtual t_index expand(std::int32_t row_idx) = 0;
 
         virtual void set_depth(std::int32_t depth) = 0;
+
+        [[nodiscard]]
+        virtual t_stage_trace& get_trace() const = 0;
+
+        [[nodiscard]]
+        virtual t_ctx_memory_usage get_memory_usage() const = 0;
     };
 
     template <typename CTX_T>
@@ -401,10 +421,32 @@ namespace server {
         [[nodiscard]]
         std::shared_ptr<std::string>
         get_row_delta_as_arrow() const override {
+            t_stage_timer timer(get_trace(), TRACE_STAGE_DELTA_SERIALIZE);
             auto delta = m_view->get_row_delta();
+            timer.set_rows(delta->num_rows());
+            return m_view->data_slice_to_arrow(delta, false, false);
+        }
+
+        [[nodiscard]]
+        std::shared_ptr<std::string>
+        get_row_delta_as_arrow(
+            t_uindex start_row,
+            t_uindex end_row,
+            t_uindex start_col,
+            t_uindex end_col
+        ) const override {
+            t_stage_timer timer(get_trace(), TRACE_STAGE_DELTA_SERIALIZE);
+            auto delta =
+                m_view->get_row_delta(start_row, end_row, start_col, end_col);
+            timer.set_rows(delta->num_rows());
             return m_view->data_slice_to_arrow(delta, false, false);
         }
 
+        void
+        clear_deltas() override {
+            m_view->clear_deltas();
+        }
+
         void
         set_deltas_enabled(bool enabled_state) override {
             m_view->get_context()->set_deltas_enabled(enabled_state);
@@ -435,6 +477,18 @@ namespace server {
             m_view->set_depth(depth, num_pivots);
         }
 
+        [[nodiscard]]
+        t_stage_trace&
+        get_trace() const override {
+            return m_view->get_context()->get_trace();
+        }
+
+        [[nodiscard]]
+        t_ctx_memory_usage
+        get_memory_usage() const override {
+            return m_view->get_context()->get_memory_usage();
+        }
+
     private:
         std::shared_ptr<View<CTX_T>> m_view;
     };
@@ -459,6 +513,32 @@ namespace server {
     struct Subscription {
         uint32_t id;
         uint32_t client_id;
+
+        // When set, row deltas for this subscription only include rows
+        // inside this window of a pivoted view.
+        std::optional<proto::ViewPort> viewport;
+
+        // When non-zero, updates without a delta are sent at most once per
+        // interval, and the ones that arrive sooner are coalesced into the
+        // next update sent by `poll`.
+        std::uint32_t min_interval_ms = 0;
+        std::chrono::steady_clock::time_point last_sent;
+        std::optional<std::uint32_t> pending_port_id;
+    };
+
+    /**
+     * @brief How often `poll` processes a table's pending updates. Pending
+     * rows are conflated by primary key while the table waits.
+     */
+    struct TableSchedule {
+        std::chrono::milliseconds min_interval{0};
+
+        // Process before `min_interval` has elapsed once this many rows are
+        // pending after conflation, or never if 0.
+        t_uindex max_batch_size = 0;
+
+        std::chrono::steady_clock::time_point last_processed;
+        t_uindex conflated_size = 0;
     };
 
     /**
@@ -517,7 +597,50 @@ namespace server {
 
         void mark_table_dirty(const t_id& id);
         void mark_table_clean(const t_id& id);
-        void mark_all_tables_clean();
+
+        // Update scheduling
+        void set_table_schedule(const t_id& id, TableSchedule schedule);
+
+        /**
+         * @brief Whether a dirty table's schedule defers processing it past
+         * `now`, conflating its pending rows if so.
+         */
+        bool
+        defer_table(const t_id& id, std::chrono::steady_clock::time_point now);
+
+        /**
+         * @brief Whether an update for the subscription should be held
+         * rather than sent at `now`. Held updates are returned by
+         * `take_due_view_on_update_subs` once the interval has elapsed.
+         */
+        bool hold_view_on_update_sub(
+            const t_id& view_id,
+            const Subscription& sub,
+            std::uint32_t port_id,
+            std::chrono::steady_clock::time_point now
+        );
+
+        std::vector<std::pair<t_id, Subscription>>
+        take_due_view_on_update_subs(std::chrono::steady_clock::time_point now
+        );
+
+        // Idle views
+
+        /**
+         * @brief Record a read of the view at `now`, returning whether the
+         * view was suspended and must be resumed before it is read.
+         */
+        bool touch_view(
+            const t_id& view_id, std::chrono::steady_clock::time_point now
+        );
+
+        /**
+         * @brief Mark the views that have not been read for longer than the
+         * idle timeout, and have no `on_update` subscriptions, as suspended,
+         * returning their view and table ids.
+         */
+        std::vector<std::pair<t_id, t_id>>
+        suspend_idle_views(std::chrono::steady_clock::time_point now);
 
         std::vector<std::pair<std::shared_ptr<Table>, const std::string>>
         get_dirty_tables();
@@ -541,6 +664,11 @@ namespace server {
             m_table_on_delete_subs;
 
         tsl::hopscotch_set<t_id> m_dirty_tables;
+        tsl::hopscotch_map<t_id, TableSchedule> m_table_schedules;
+
+        tsl::hopscotch_map<t_id, std::chrono::steady_clock::time_point>
+            m_view_last_access;
+        tsl::hopscotch_set<t_id> m_suspended_views;
 
 #ifdef PSP_PARALLEL_FOR
         std::shared_mutex m_write_lock;
@@ -570,6 +698,12 @@ namespace server {
             std::vector<ProtoServerResp<ProtoServer::Response>>& proto_resp
         );
 
+        /**
+         * @brief Record a read of the view `req` targets, rebuilding the
+         * view's context if it was suspended while idle.
+         */
+        void resume_view(const Request& req);
+
         std::vector<ProtoServerResp<Response>>
         _handle_request(std::uint32_t client_id, const Request& req);
 
@@ -0,0 +1,91 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief Whether `agg` is computed from a per-node sketch that is merged up
+ * the tree, i.e. an approximate distinct count or percentile.
+ */
+PERSPECTIVE_EXPORT bool is_sketch_aggtype(t_aggtype agg);
+
+/**
+ * @brief A HyperLogLog sketch of the distinct `t_tscalar`s added to it,
+ * with `2 ^ DEFAULT_HLL_PRECISION` registers (a standard error of about
+ * 1.6%). Sketches of disjoint or overlapping sets merge into a sketch of
+ * their union.
+ *
+ * Small sets keep their exact 64-bit hashes instead of registers, so they
+ * are counted exactly and use memory in proportion to their size.
+ */
+class PERSPECTIVE_EXPORT t_hyperloglog {
+public:
+    t_hyperloglog();
+
+    void add(const t_tscalar& value);
+
+    void merge(const t_hyperloglog& other);
+
+    std::uint64_t estimate() const;
+
+private:
+    void add_hash(std::uint64_t hash);
+    void compact();
+    void to_dense();
+
+    std::vector<std::uint64_t> m_hashes;
+    std::vector<std::uint8_t> m_registers;
+};
+
+/**
+ * @brief A merging t-digest of the numeric values added to it, which
+ * estimates any quantile of them with an error that is smallest at the
+ * extremes. Values are clustered into at most about
+ * `DEFAULT_TDIGEST_COMPRESSION` centroids, and the digests of two sets of
+ * values merge into a digest of both. Nulls and NaNs are skipped.
+ */
+class PERSPECTIVE_EXPORT t_tdigest {
+public:
+    t_tdigest();
+
+    void add(const t_tscalar& value);
+
+    void merge(const t_tdigest& other);
+
+    /**
+     * @brief Returns the estimated value at quantile `q` of [0, 1], or a
+     * null scalar if no values were added.
+     */
+    t_tscalar quantile(double q) const;
+
+private:
+    void compress();
+
+    // Pairs of (mean, weight), sorted by mean once compressed.
+    std::vector<std::pair<double, double>> m_centroids;
+    t_uindex m_num_merged;
+    double m_min;
+    double m_max;
+};
+
+} // end namespace perspective
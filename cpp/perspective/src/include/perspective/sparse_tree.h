@@ -31,6 +31,11 @@ SUPPRESS_WARNINGS_VC(4503)
 #include <perspective/sym_table.h>
 #include <perspective/data_table.h>
 #include <perspective/dense_tree.h>
+#include <perspective/order_statistic.h>
+#include <perspective/rolling_window.h>
+#include <perspective/sketch.h>
+#include <tsl/hopscotch_map.h>
+#include <tsl/hopscotch_set.h>
 #include <vector>
 #include <algorithm>
 #include <deque>
@@ -75,6 +80,17 @@ struct t_build_strand_table_metadata {
     t_uindex m_pivsize;
 };
 
+/**
+ * @brief A row applied to a leaf of the tree by the last update. A negative
+ * strand count means the row left the leaf; otherwise it is in the leaf
+ * with its current value.
+ */
+struct t_order_stat_event {
+    t_uindex m_lfidx;
+    t_tscalar m_pkey;
+    std::int8_t m_strand_count;
+};
+
 typedef multi_index_container<
     t_stnode,
     indexed_by<
@@ -155,6 +171,21 @@ struct t_tree_unify_rec {
 
 typedef std::vector<t_tree_unify_rec> t_tree_unify_rec_vec;
 
+/**
+ * @brief The changes to a `t_stree`'s shape made by its last notify: the
+ * strands that dropped to zero rows, the nodes that still have rows, the
+ * updated leaves in sort order, and every node whose aggregates were
+ * recomputed. Kept on the tree so that every `t_traversal` over it -
+ * including those of contexts sharing the tree - can be brought up to date
+ * without re-notifying the tree.
+ */
+struct PERSPECTIVE_EXPORT t_stree_shape_delta {
+    std::vector<t_uindex> m_zero_strands;
+    std::set<t_uindex> m_non_zero_ids;
+    std::vector<t_uindex> m_leaves;
+    std::vector<t_uindex> m_updated_ids;
+};
+
 class PERSPECTIVE_EXPORT t_stree {
 public:
     typedef const t_stree* t_cptr;
@@ -237,14 +268,31 @@ public:
 
     void update_shape_from_static(const t_dtree_ctx& ctx);
 
+    /**
+     * @brief Recompute the aggregates of the nodes touched by the last
+     * update, except for the aggregates named in `unchanged_aggregates`,
+     * whose inputs were not changed by the update.
+     */
     void update_aggs_from_static(
         const t_dtree_ctx& ctx,
         const t_gstate& gstate,
-        const t_data_table& expression_master_table
+        const t_data_table& expression_master_table,
+        const tsl::hopscotch_set<std::string>& unchanged_aggregates
     );
 
+    /**
+     * @brief The nodes created or updated by the last
+     * `update_shape_from_static`, whose aggregates and sort values may have
+     * changed.
+     */
+    std::vector<t_uindex> updated_ids() const;
+
     t_uindex size() const;
 
+    // Estimated bytes held by the tree's node indices, aggregate table and
+    // retained deltas.
+    t_uindex nbytes() const;
+
     t_uindex get_num_children(t_uindex idx) const;
     void get_child_nodes(t_uindex idx, t_tnodevec& nodes) const;
     std::vector<t_uindex> zero_strands() const;
@@ -312,7 +360,6 @@ public:
 
     t_tscalar get_aggregate(t_index idx, t_index aggnum) const;
 
-    t_tscalar get_aggregate_median(std::vector<t_tscalar>& values) const;
 
     void get_child_indices(t_index idx, std::vector<t_index>& out_data) const;
 
@@ -345,6 +392,9 @@ public:
     bool has_deltas() const;
     void set_has_deltas(bool v);
 
+    const t_stree_shape_delta& get_shape_delta() const;
+    void set_shape_delta(t_stree_shape_delta shape_delta);
+
     std::vector<t_uindex> get_descendents(t_uindex nidx) const;
 
     t_uindex get_num_leaves(t_uindex depth) const;
@@ -375,6 +425,71 @@ protected:
 
     bool is_leaf(t_uindex nidx) const;
 
+    /**
+     * @brief Recompute the sketch aggregate in column `aggidx` for node
+     * `nidx`. Leaves are sketched from their rows, and other nodes merge
+     * the sketches of their children, so nodes must be updated after all of
+     * their updated children.
+     */
+    void update_sketch_aggregate(
+        t_uindex nidx,
+        t_uindex aggidx,
+        t_uindex dst_ridx,
+        t_agg_update_info& info,
+        const t_gstate& gstate,
+        const t_data_table& expression_master_table
+    );
+
+    template <typename SKETCH_T>
+    SKETCH_T build_sketch(
+        t_uindex nidx,
+        const tsl::hopscotch_map<t_uindex, SKETCH_T>& sketches,
+        const std::string& colname,
+        const t_gstate& gstate,
+        const t_data_table& expression_master_table
+    ) const;
+
+    /**
+     * @brief Returns the new value of the percentile aggregate in column
+     * `aggidx` for node `nidx`, updating the node's `t_order_statistic` with
+     * only the rows the last update applied to the node. A node without one
+     * yet has it built from all of its rows.
+     */
+    t_tscalar update_order_statistic(
+        t_uindex nidx,
+        t_uindex aggidx,
+        const t_aggspec& spec,
+        const t_gstate& gstate,
+        const t_data_table& expression_master_table
+    );
+
+    /**
+     * @brief Returns the new value of the rolling aggregate in column
+     * `aggidx` for node `nidx`, updating the node's `t_rolling_window` with
+     * only the rows the last update applied to the node. A node without one
+     * yet, or any node if `rebuild` is set, has it built from all of its
+     * rows.
+     */
+    t_tscalar update_rolling_window(
+        t_uindex nidx,
+        t_uindex aggidx,
+        const t_aggspec& spec,
+        bool rebuild,
+        const t_gstate& gstate,
+        const t_data_table& expression_master_table
+    );
+
+    /**
+     * @brief Split the rows the last update applied to node `nidx` into
+     * those still in the node and those that left it. Returns false if the
+     * update did not touch the node.
+     */
+    bool get_node_row_changes(
+        t_uindex nidx,
+        std::vector<t_tscalar>& pkeys,
+        std::vector<t_tscalar>& removed
+    ) const;
+
     t_build_strand_table_metadata build_strand_table_metadata(
         const t_data_table& flattened,
         const std::vector<t_aggspec>& aggspecs,
@@ -467,6 +582,31 @@ private:
     t_symtable m_symtable;
     bool m_has_delta;
     std::string m_grand_agg_str;
+    t_stree_shape_delta m_shape_delta;
+
+    // Whether percentile aggregates are kept in `t_order_statistic`s, which
+    // are indexed by aggregate column, then keyed by node.
+    bool m_has_order_stats;
+    std::vector<tsl::hopscotch_map<t_uindex, t_order_statistic>>
+        m_order_stats;
+
+    // Per-node sketches for approximate aggregates, indexed by aggregate
+    // column, then keyed by node.
+    std::vector<tsl::hopscotch_map<t_uindex, t_hyperloglog>>
+        m_distinct_sketches;
+    std::vector<tsl::hopscotch_map<t_uindex, t_tdigest>> m_quantile_sketches;
+
+    // Per-node state for rolling window aggregates, indexed by aggregate
+    // column, then keyed by node.
+    bool m_has_rolling_windows;
+    std::vector<tsl::hopscotch_map<t_uindex, t_rolling_window>>
+        m_rolling_windows;
+
+    // The rows applied to each leaf by the last update, and the indices of
+    // those under each node.
+    std::vector<t_order_stat_event> m_order_stat_events;
+    tsl::hopscotch_map<t_uindex, std::vector<t_uindex>>
+        m_order_stat_node_events;
 };
 
 } // end namespace perspective
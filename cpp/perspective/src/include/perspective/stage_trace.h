@@ -0,0 +1,145 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief The stages of the update pipeline which are timed by
+ * `t_stage_trace`. Table-level stages are recorded on the `t_gnode`, and
+ * per-view stages (`TRACE_STAGE_CONTEXT_NOTIFY`,
+ * `TRACE_STAGE_DELTA_SERIALIZE`) on the context.
+ */
+enum t_trace_stage {
+    TRACE_STAGE_FLATTEN,
+    TRACE_STAGE_PKEY_LOOKUP,
+    TRACE_STAGE_PROCESS_COLUMNS,
+    TRACE_STAGE_UPDATE_MASTER,
+    TRACE_STAGE_COMPUTE_EXPRESSIONS,
+    TRACE_STAGE_CONTEXT_NOTIFY,
+    TRACE_STAGE_DELTA_SERIALIZE,
+    TRACE_STAGE_LAST
+};
+
+PERSPECTIVE_EXPORT const char* trace_stage_to_str(t_trace_stage stage);
+
+/**
+ * @brief A single timed execution of a pipeline stage. `m_start_ns` is
+ * nanoseconds since the unix epoch, so records from different traces can be
+ * lined up against each other.
+ */
+struct PERSPECTIVE_EXPORT t_trace_record {
+    t_trace_stage m_stage;
+    std::uint64_t m_seq;
+    std::int64_t m_start_ns;
+    std::int64_t m_duration_ns;
+    t_uindex m_rows;
+};
+
+/**
+ * @brief Cumulative counters for a single stage, which unlike the ring of
+ * records are never overwritten.
+ */
+struct PERSPECTIVE_EXPORT t_trace_stage_stats {
+    t_trace_stage_stats();
+
+    std::uint64_t m_count;
+    std::int64_t m_total_ns;
+    std::int64_t m_max_ns;
+    std::uint64_t m_rows;
+};
+
+/**
+ * @brief A fixed-capacity ring buffer of `t_trace_record`s plus per-stage
+ * counters. Recording a stage costs two clock reads and a short uncontended
+ * critical section, so traces are always on unless `PSP_DISABLE_STAGE_TRACE`
+ * is set.
+ */
+class PERSPECTIVE_EXPORT t_stage_trace {
+public:
+    PSP_NON_COPYABLE(t_stage_trace);
+
+    explicit t_stage_trace(t_uindex capacity = DEFAULT_TRACE_CAPACITY);
+
+    static bool enabled();
+
+    /**
+     * @brief Monotonic clock reading in nanoseconds, used to time stages.
+     */
+    static std::int64_t now_ns();
+
+    void record(
+        t_trace_stage stage,
+        std::int64_t start_ns,
+        std::int64_t end_ns,
+        t_uindex rows
+    );
+
+    /**
+     * @brief Returns the buffered records, oldest first.
+     */
+    std::vector<t_trace_record> get_records() const;
+
+    /**
+     * @brief Returns the counters for each stage, indexed by `t_trace_stage`.
+     */
+    std::vector<t_trace_stage_stats> get_stats() const;
+
+    /**
+     * @brief The number of records which have been overwritten since the
+     * trace was created or last cleared.
+     */
+    std::uint64_t get_num_dropped() const;
+
+    void clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<t_trace_record> m_records;
+    std::uint64_t m_next_seq;
+    t_trace_stage_stats m_stats[TRACE_STAGE_LAST];
+};
+
+/**
+ * @brief Times the enclosing scope as a single `t_trace_stage`, recording
+ * into the trace on destruction or on an explicit `stop()`, whichever comes
+ * first.
+ */
+class PERSPECTIVE_EXPORT t_stage_timer {
+public:
+    PSP_NON_COPYABLE(t_stage_timer);
+
+    t_stage_timer(t_stage_trace& trace, t_trace_stage stage, t_uindex rows = 0);
+    ~t_stage_timer();
+
+    void set_rows(t_uindex rows);
+    void stop();
+
+private:
+    t_stage_trace& m_trace;
+    t_trace_stage m_stage;
+    t_uindex m_rows;
+    std::int64_t m_start_ns;
+    bool m_stopped;
+};
+
+} // end namespace perspective
@@ -146,12 +146,24 @@ public:
     void shrink(t_uindex capacity);
     void copy(t_lstore& out) const;
     void load(const std::string& fname);
-    void save(const std::string& fname);
+    void save(const std::string& fname) const;
     void warmup() const;
 
     t_uindex size() const;
     t_uindex capacity() const;
 
+    // Bytes allocated for this store, including unused capacity.
+    t_uindex nbytes() const;
+
+    // Bytes of this store currently resident in memory. Stores that are not
+    // backed by a file mapping are always fully resident.
+    t_uindex resident_nbytes() const;
+
+    // Hint how the store will be accessed next. Only file backed stores act
+    // on this - `ACCESS_ADVICE_DONTNEED` writes back and drops their pages,
+    // which are paged in again from the file on the next access.
+    void advise(t_access_advice advice) const;
+
     template <typename T>
     void push_back(T value);
     void push_back(const void* ptr, t_uindex len);
@@ -222,6 +234,11 @@ public:
         return m_init;
     }
 
+    t_backing_store
+    get_backing_store() const {
+        return m_backing_store;
+    }
+
     bool
     empty() const {
         return size() == 0;
@@ -383,6 +400,32 @@ t_lstore::raw_fill(DATA_T v) {
     std::fill(biter, eiter, v);
 }
 
+/**
+ * @brief Where a `Table` keeps the columns of its master table. Disk backed
+ * tables map each column store from a file in `m_dirname`, and page out
+ * columns that were not recently updated once more than
+ * `m_resident_budget` bytes of them are resident. In memory tables may
+ * instead compress numeric columns that have been neither written nor read
+ * for `m_compress_after_updates` updates. String columns named in
+ * `m_indexed_columns` keep an inverted index for equality filters - see
+ * `t_column::set_indexed`.
+ */
+struct PERSPECTIVE_EXPORT t_storage_options {
+    t_storage_options();
+    t_storage_options(std::string dirname, t_uindex resident_budget);
+
+    t_backing_store m_backing_store;
+    std::string m_dirname;
+
+    // In bytes; 0 leaves paging entirely to the OS.
+    t_uindex m_resident_budget;
+
+    // In updates; 0 never compresses.
+    t_uindex m_compress_after_updates;
+
+    std::vector<std::string> m_indexed_columns;
+};
+
 struct PERSPECTIVE_EXPORT t_column_recipe {
     t_column_recipe();
     t_dtype m_dtype;
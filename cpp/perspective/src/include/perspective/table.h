@@ -52,7 +52,8 @@ public:
         std::vector<std::string> column_names,
         std::vector<t_dtype> data_types,
         std::uint32_t limit,
-        std::string index
+        std::string index,
+        t_storage_options storage = t_storage_options()
     );
 
     /**
@@ -194,40 +195,80 @@ public:
     void remove_cols(const std::string_view& data);
     void remove_rows(const std::string_view& data);
 
+    /**
+     * @brief Keep only the rows whose `column` value is within `ttl` of the
+     * newest value in that column, e.g. "the last 15 minutes by `ts`". Rows
+     * that an update moves out of the window are removed right after it is
+     * processed, through the same path as `remove_rows`. An empty `column`
+     * turns retention off.
+     *
+     * @param column a `DTYPE_TIME`, `DTYPE_INT64` or `DTYPE_INT32` column.
+     * @param ttl the window size, in the units of `column` (milliseconds
+     * for `DTYPE_TIME`).
+     */
+    void set_retention(const std::string& column, std::int64_t ttl);
+
     void update_arrow(const std::string_view& data, std::uint32_t port_id);
     void update_csv(const std::string_view& data, std::uint32_t port_id);
     void update_rows(const std::string_view& data, std::uint32_t port_id);
     void update_cols(const std::string_view& data, std::uint32_t port_id);
     // void update_cols(const std::string_view& data) const;
 
+    /**
+     * @brief Write this table's schema, index, limit and committed rows to
+     * the directory `dirname`, for `from_snapshot` to restore without
+     * re-parsing or re-interning any data.
+     *
+     * @param dirname
+     */
+    void save_snapshot(const std::string& dirname) const;
+
     static std::shared_ptr<Table> from_csv(
         const std::string& index,
         const std::string_view& data,
-        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()
+        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max(),
+        const t_storage_options& storage = t_storage_options()
     );
 
     static std::shared_ptr<Table> from_cols(
         const std::string& index,
         const std::string_view& data,
-        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()
+        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max(),
+        const t_storage_options& storage = t_storage_options()
     );
 
     static std::shared_ptr<Table> from_rows(
         const std::string& index,
         const std::string_view& data,
-        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()
+        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max(),
+        const t_storage_options& storage = t_storage_options()
     );
 
     static std::shared_ptr<Table> from_schema(
         const std::string& index,
         const t_schema& schema,
-        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()
+        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max(),
+        const t_storage_options& storage = t_storage_options()
     );
 
     static std::shared_ptr<Table> from_arrow(
         const std::string& index,
         const std::string_view& data,
-        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max()
+        std::uint32_t limit = std::numeric_limits<std::uint32_t>::max(),
+        const t_storage_options& storage = t_storage_options()
+    );
+
+    /**
+     * @brief Create a `Table` from a snapshot written by `save_snapshot`,
+     * copying the saved column stores back in and rebuilding the primary key
+     * index from them. Throws if the snapshot is missing or corrupt.
+     *
+     * @param dirname
+     * @param storage where the restored table keeps its columns.
+     */
+    static std::shared_ptr<Table> from_snapshot(
+        const std::string& dirname,
+        const t_storage_options& storage = t_storage_options()
     );
 
     static std::shared_ptr<Table> make_table(
@@ -284,6 +325,12 @@ private:
      *
      */
     const std::string m_index;
+
+    /**
+     * @brief Where the master table keeps its columns - in memory, or in
+     * file backed mappings for tables larger than memory.
+     */
+    const t_storage_options m_storage;
     bool m_gnode_set;
 };
 
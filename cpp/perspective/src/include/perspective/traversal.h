@@ -22,8 +22,11 @@
 #include <perspective/sparse_tree_node.h>
 #include <perspective/sparse_tree.h>
 #include <perspective/arg_sort.h>
+#include <perspective/env_vars.h>
+#include <tsl/hopscotch_set.h>
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <queue>
 
 SUPPRESS_WARNINGS_VC(4503)
@@ -62,6 +65,8 @@ public:
 
     t_uindex size() const;
 
+    t_uindex nbytes() const;
+
     t_depth get_depth(t_index idx) const;
 
     t_index get_traversal_index(t_index idx);
@@ -94,6 +99,27 @@ public:
         t_ctx2* ctx2 = nullptr
     );
 
+    /**
+     * @brief Restore `sortby` order after the tree nodes in `updated_ids`
+     * changed, by moving only those nodes among their siblings. Falls back
+     * to a full `sort_by` if the traversal was not sorted before the nodes
+     * changed, or if most of it has changed.
+     */
+    template <typename SRC_T>
+    void sort_updated(
+        const t_config& config,
+        const std::vector<t_sortspec>& sortby,
+        const SRC_T& src,
+        const std::vector<t_uindex>& updated_ids,
+        t_ctx2* ctx2 = nullptr
+    );
+
+    /**
+     * @brief Force the next `sort_updated` to sort the whole traversal, e.g.
+     * because the sort keys of nodes outside the tree's updates changed.
+     */
+    void invalidate_sort();
+
     void get_child_indices(
         t_index nidx, std::vector<std::pair<t_index, t_index>>& out_data
     ) const;
@@ -135,6 +161,10 @@ public:
 private:
     std::shared_ptr<const t_stree> m_tree;
     std::shared_ptr<std::vector<t_tvnode>> m_nodes;
+
+    // Whether the children of every expanded node are in the order of the
+    // last `sort_by`, apart from nodes the tree has updated since.
+    bool m_sorted;
 };
 
 /**
@@ -258,6 +288,155 @@ t_traversal::sort_by(
     }
 
     std::swap(*m_nodes, new_nodes);
+    m_sorted = true;
+}
+
+/**
+ * @brief Incremental sort implementation for `t_ctx1` and `t_ctx2` contexts.
+ * The siblings of an updated node that were not updated are still sorted, so
+ * each updated node is placed by binary search among them, and only the span
+ * of the traversal between the first and last moved sibling is rewritten.
+ *
+ * @tparam SRC_T
+ * @param config
+ * @param sortby
+ * @param src
+ * @param updated_ids
+ * @param ctx2
+ */
+template <typename SRC_T>
+void
+t_traversal::sort_updated(
+    const t_config& config,
+    const std::vector<t_sortspec>& sortby,
+    const SRC_T& src,
+    const std::vector<t_uindex>& updated_ids,
+    t_ctx2* ctx2
+) {
+    if (!m_sorted || t_env::disable_incremental_sort()
+        || updated_ids.size() * DEFAULT_INCREMENTAL_SORT_FACTOR
+            > m_nodes->size()) {
+        sort_by(config, sortby, src, ctx2);
+        return;
+    }
+
+    tsl::hopscotch_set<t_index> updated(updated_ids.begin(), updated_ids.end());
+
+    // Parents of the updated nodes in the traversal as (depth, tvidx), so
+    // that the deepest are sorted first - sorting a node's children moves
+    // its descendants, but never a node at the same depth or above.
+    std::vector<std::pair<t_uindex, t_index>> parents;
+    tsl::hopscotch_set<t_index> seen;
+
+    for (t_index idx = 1, loop_end = m_nodes->size(); idx < loop_end; ++idx) {
+        const t_tvnode& node = (*m_nodes)[idx];
+        if (updated.find(node.m_tnid) == updated.end()) {
+            continue;
+        }
+
+        t_index pidx = idx - node.m_rel_pidx;
+        if (seen.insert(pidx).second) {
+            parents.emplace_back((*m_nodes)[pidx].m_depth, pidx);
+        }
+    }
+
+    std::sort(parents.begin(), parents.end(), std::greater<>());
+
+    std::vector<t_index> sortby_agg_indices(sortby.size());
+    for (t_uindex idx = 0, loop_end = sortby.size(); idx < loop_end; ++idx) {
+        sortby_agg_indices[idx] = sortby[idx].m_agg_index;
+    }
+
+    t_multisorter sorter(get_sort_orders(sortby));
+    std::vector<t_tscalar> aggregates(sortby.size());
+
+    // Ties are broken by the previous sibling order, as in `sort_by`.
+    auto get_elem = [&](t_index ptidx, t_uindex order) {
+        src.get_aggregates_for_sorting(
+            ptidx, sortby_agg_indices, aggregates, ctx2
+        );
+        return t_mselem(aggregates, order);
+    };
+
+    for (const auto& parent : parents) {
+        t_index p_tvidx = parent.second;
+        std::vector<std::pair<t_index, t_index>> h_children;
+        get_child_indices(p_tvidx, h_children);
+        t_uindex nchild = h_children.size();
+
+        std::vector<t_uindex> kept;
+        std::vector<t_mselem> moved;
+        for (t_uindex cidx = 0; cidx < nchild; ++cidx) {
+            if (updated.find(h_children[cidx].second) == updated.end()) {
+                kept.push_back(cidx);
+            } else {
+                moved.push_back(get_elem(h_children[cidx].second, cidx));
+            }
+        }
+
+        std::sort(moved.begin(), moved.end(), sorter);
+
+        // New sibling order, as indices into `h_children`.
+        std::vector<t_uindex> order;
+        order.reserve(nchild);
+        auto kept_iter = kept.begin();
+
+        for (const auto& elem : moved) {
+            auto pos = std::partition_point(
+                kept_iter,
+                kept.end(),
+                [&](t_uindex cidx) {
+                    return !sorter(
+                        elem, get_elem(h_children[cidx].second, cidx)
+                    );
+                }
+            );
+
+            order.insert(order.end(), kept_iter, pos);
+            order.push_back(elem.m_order);
+            kept_iter = pos;
+        }
+
+        order.insert(order.end(), kept_iter, kept.end());
+
+        t_uindex lo = 0;
+        while (lo < nchild && order[lo] == lo) {
+            ++lo;
+        }
+
+        if (lo == nchild) {
+            continue;
+        }
+
+        t_uindex hi = nchild;
+        while (order[hi - 1] == hi - 1) {
+            --hi;
+        }
+
+        // Children are contiguous blocks of themselves and their descendants,
+        // so the moved siblings span `[bidx, eidx)`.
+        t_index bidx = h_children[lo].first;
+        t_index eidx = hi == nchild
+            ? p_tvidx + (*m_nodes)[p_tvidx].m_ndesc + 1
+            : h_children[hi].first;
+
+        std::vector<t_tvnode> span;
+        span.reserve(eidx - bidx);
+
+        for (t_uindex idx = lo; idx < hi; ++idx) {
+            t_index c_tvidx = h_children[order[idx]].first;
+            t_index c_eidx = c_tvidx + (*m_nodes)[c_tvidx].m_ndesc + 1;
+            t_index c_ntvidx = bidx + span.size();
+            span.insert(
+                span.end(),
+                m_nodes->begin() + c_tvidx,
+                m_nodes->begin() + c_eidx
+            );
+            span[c_ntvidx - bidx].m_rel_pidx = c_ntvidx - p_tvidx;
+        }
+
+        std::copy(span.begin(), span.end(), m_nodes->begin() + bidx);
+    }
 }
 
 } // end namespace perspective
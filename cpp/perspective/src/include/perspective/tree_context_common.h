@@ -15,6 +15,7 @@
 #include <perspective/exports.h>
 #include <perspective/config.h>
 #include <perspective/gnode_state.h>
+#include <perspective/process_state.h>
 #include <perspective/traversal.h>
 
 namespace perspective {
@@ -29,7 +30,20 @@ PERSPECTIVE_EXPORT void notify_sparse_tree_common(
     const std::vector<std::pair<std::string, std::string>>& tree_sortby,
     const std::vector<t_sortspec>& ctx_sortby,
     const t_gstate& gstate,
-    const t_data_table& expression_master_table
+    const t_data_table& expression_master_table,
+    const tsl::hopscotch_set<std::string>& unchanged_aggregates
+);
+
+/**
+ * @brief Bring `traversal` up to date with the shape changes recorded by the
+ * last notify of `tree`. Called by `notify_sparse_tree` for the notifying
+ * context's own traversal, and directly by contexts that share `tree` with
+ * another context and so do not notify it themselves.
+ */
+PERSPECTIVE_EXPORT void notify_traversal(
+    const std::shared_ptr<t_stree>& tree,
+    const std::shared_ptr<t_traversal>& traversal,
+    const std::vector<t_sortspec>& ctx_sortby
 );
 
 PERSPECTIVE_EXPORT void notify_sparse_tree(
@@ -63,6 +77,13 @@ PERSPECTIVE_EXPORT void notify_sparse_tree(
     const t_data_table& expression_master_table
 );
 
+/**
+ * @brief Returns the transitional columns read by `notify_sparse_tree` for
+ * the trees of a pivoted context with `config`.
+ */
+PERSPECTIVE_EXPORT t_transitional_needs
+tree_transitional_needs(const t_config& config);
+
 template <typename CONTEXT_T>
 void
 ctx_expand_path(
@@ -147,6 +147,7 @@ public:
         bool has_row_path,
         bool leaves_only,
         bool is_formatted,
+        std::shared_ptr<t_data_slice<CTX_T>> slice,
         rapidjson::Writer<rapidjson::StringBuffer>& writer
     ) const;
 
@@ -205,6 +206,29 @@ public:
         t_uindex end_col
     ) const;
 
+    /**
+     * @brief Returns the same slice as `get_data`, snapshotted so that it
+     * can be serialized without reading the context. The pool's read lock
+     * is held only while the snapshot is taken, so updates are not blocked
+     * for the duration of the serialization.
+     *
+     * @param start_row
+     * @param end_row
+     * @param start_col
+     * @param end_col
+     * @param with_row_paths whether row paths and depths are read
+     * @param with_pkeys whether primary keys are read
+     * @return std::shared_ptr<t_data_slice<CTX_T>>
+     */
+    std::shared_ptr<t_data_slice<CTX_T>> get_snapshot(
+        t_uindex start_row,
+        t_uindex end_row,
+        t_uindex start_col,
+        t_uindex end_col,
+        bool with_row_paths,
+        bool with_pkeys
+    ) const;
+
     std::string to_rows(
         t_uindex start_row,
         t_uindex end_row,
@@ -356,6 +380,27 @@ public:
      */
     std::shared_ptr<t_data_slice<CTX_T>> get_row_delta() const;
 
+    /**
+     * @brief Returns a data slice of the changed rows that fall inside the
+     * given window. Pivoted contexts read their deltas without clearing them
+     * so that several windows can be served from one update, and the caller
+     * must `clear_deltas()` afterwards; flat contexts ignore the window.
+     *
+     * @param start_row
+     * @param end_row
+     * @param start_col
+     * @param end_col
+     * @return std::shared_ptr<t_data_slice<CTX_T>>
+     */
+    std::shared_ptr<t_data_slice<CTX_T>> get_row_delta(
+        t_uindex start_row,
+        t_uindex end_row,
+        t_uindex start_col,
+        t_uindex end_col
+    ) const;
+
+    void clear_deltas() const;
+
     // Getters
     std::shared_ptr<CTX_T> get_context() const;
     std::vector<std::string> get_row_pivots() const;
@@ -412,6 +457,30 @@ private:
 
     void _find_hidden_sort(const std::vector<t_sortspec>& sort);
 
+    /**
+     * @brief Translates a window over this view's rows and columns into the
+     * row and column indices of the underlying `t_ctx2`, accounting for the
+     * row offset of column-only views and the header columns generated for
+     * sorted views. For sorted views, `column_indices` is filled with the
+     * context column of each column in the window.
+     *
+     * @param start_row
+     * @param end_row
+     * @param start_col
+     * @param end_col
+     * @param column_indices
+     */
+    void _get_context_window(
+        t_uindex& start_row,
+        t_uindex& end_row,
+        t_uindex& start_col,
+        t_uindex& end_col,
+        std::vector<t_uindex>& column_indices
+    ) const;
+
+    std::shared_ptr<t_data_slice<CTX_T>>
+    row_delta_to_data_slice(const t_rowdelta& delta) const;
+
     std::shared_ptr<Table> m_table;
     std::shared_ptr<CTX_T> m_ctx;
     std::string m_name;
@@ -22,12 +22,14 @@ use nanoid::*;
 use prost::Message;
 use serde::{Deserialize, Serialize};
 use tracing_unwrap::{OptionExt, ResultExt};
+use ts_rs::TS;
 
 use crate::proto::request::ClientReq;
 use crate::proto::response::ClientResp;
 use crate::proto::{
     self, ColumnType, GetFeaturesReq, GetFeaturesResp, GetHostedTablesReq, GetHostedTablesResp,
-    HostedTable, MakeTableReq, Request, Response, ServerSystemInfoReq,
+    HostedTable, LoadSnapshotReq, MakeTableReq, Request, Response, ServerProfileReq,
+    ServerProfileResp, ServerSystemInfoReq,
 };
 use crate::table::{Table, TableInitOptions, TableOptions};
 use crate::table_data::{TableData, UpdateData};
@@ -37,16 +39,94 @@ use crate::view::ViewWindow;
 #[derive(Clone, Debug, Serialize, Deserialize)]
 pub struct SystemInfo {
     pub heap_size: f64,
+
+    /// Bytes held by each hosted [`Table`] and its [`crate::View`]s, as
+    /// accounted by the engine's own data structures.
+    pub tables: Vec<TableMemory>,
+}
+
+/// Bytes held by a hosted [`Table`], see [`SystemInfo::tables`].
+#[derive(Clone, Debug, Serialize, Deserialize)]
+pub struct TableMemory {
+    pub table_id: String,
+    pub column_bytes: u64,
+    pub vocab_bytes: u64,
+    pub mapping_bytes: u64,
+    pub expression_vocab_bytes: u64,
+    pub port_bytes: u64,
+
+    /// The table's own bytes plus those of all of its `views`.
+    pub total_bytes: u64,
+    pub views: Vec<ViewMemory>,
+}
+
+/// Bytes held by a hosted [`crate::View`], see [`TableMemory::views`].
+#[derive(Clone, Debug, Serialize, Deserialize)]
+pub struct ViewMemory {
+    pub view_id: String,
+    pub tree_bytes: u64,
+    pub traversal_bytes: u64,
+    pub expression_bytes: u64,
+    pub delta_bytes: u64,
+    pub total_bytes: u64,
 }
 
 impl From<proto::ServerSystemInfoResp> for SystemInfo {
     fn from(value: proto::ServerSystemInfoResp) -> Self {
         SystemInfo {
             heap_size: value.heap_size,
+            tables: value.tables.into_iter().map(|x| x.into()).collect(),
+        }
+    }
+}
+
+impl From<proto::server_system_info_resp::TableMemory> for TableMemory {
+    fn from(value: proto::server_system_info_resp::TableMemory) -> Self {
+        TableMemory {
+            table_id: value.table_id,
+            column_bytes: value.column_bytes,
+            vocab_bytes: value.vocab_bytes,
+            mapping_bytes: value.mapping_bytes,
+            expression_vocab_bytes: value.expression_vocab_bytes,
+            port_bytes: value.port_bytes,
+            total_bytes: value.total_bytes,
+            views: value.views.into_iter().map(|x| x.into()).collect(),
         }
     }
 }
 
+impl From<proto::server_system_info_resp::ViewMemory> for ViewMemory {
+    fn from(value: proto::server_system_info_resp::ViewMemory) -> Self {
+        ViewMemory {
+            view_id: value.view_id,
+            tree_bytes: value.tree_bytes,
+            traversal_bytes: value.traversal_bytes,
+            expression_bytes: value.expression_bytes,
+            delta_bytes: value.delta_bytes,
+            total_bytes: value.total_bytes,
+        }
+    }
+}
+
+/// Options for [`Client::server_profile`].
+#[derive(Clone, Debug, Default, Serialize, Deserialize, TS)]
+pub struct ServerProfileOptions {
+    /// Include each table's and view's buffered per-update records, not just
+    /// the per-stage counters.
+    #[serde(default)]
+    #[ts(optional)]
+    pub include_records: Option<bool>,
+
+    /// Clear every trace after it is read.
+    #[serde(default)]
+    #[ts(optional)]
+    pub reset: Option<bool>,
+}
+
+/// Per-stage update timings of every table and view hosted by the `Server`
+/// this `Client` connects to, see [`Client::server_profile`].
+pub type ServerProfile = ServerProfileResp;
+
 /// Metadata about what features are supported by the `Server` this `Client`
 /// is connected to.
 pub type Features = Arc<GetFeaturesResp>;
@@ -278,6 +358,8 @@ impl Client {
             let on_update_token = view
                 .on_update(callback, crate::view::OnUpdateOptions {
                     mode: Some(crate::view::OnUpdateMode::Row),
+                    viewport: None,
+                    min_interval_ms: None,
                 })
                 .await?;
 
@@ -301,6 +383,9 @@ impl Client {
             client_req: Some(ClientReq::MakeTableReq(MakeTableReq {
                 data: Some(input.into()),
                 options: Some(options.clone().try_into()?),
+                update_policy: options.update_policy.clone().map(|x| x.into()),
+                retention: options.retention.clone().map(|x| x.into()),
+                storage: options.storage.clone().map(|x| x.into()),
             })),
         };
 
@@ -333,6 +418,9 @@ impl Client {
             let options = TableOptions {
                 index: info.index,
                 limit: info.limit,
+                retention: None,
+                update_policy: None,
+                storage: None,
             };
 
             let client = self.clone();
@@ -342,6 +430,27 @@ impl Client {
         }
     }
 
+    #[doc = include_str!("../../docs/client/load_snapshot.md")]
+    pub async fn load_snapshot(
+        &self,
+        snapshot: String,
+        name: Option<String>,
+    ) -> ClientResult<Table> {
+        let entity_id = name.unwrap_or_else(|| nanoid!());
+        let msg = Request {
+            msg_id: self.gen_id(),
+            entity_id: entity_id.clone(),
+            client_req: Some(ClientReq::LoadSnapshotReq(LoadSnapshotReq {
+                name: snapshot,
+            })),
+        };
+
+        match self.oneshot(&msg).await? {
+            ClientResp::LoadSnapshotResp(_) => self.open_table(entity_id).await,
+            resp => Err(resp.into()),
+        }
+    }
+
     #[doc = include_str!("../../docs/client/get_hosted_table_names.md")]
     pub async fn get_hosted_table_names(&self) -> ClientResult<Vec<String>> {
         let msg = Request {
@@ -371,4 +480,24 @@ impl Client {
             resp => Err(resp.into()),
         }
     }
+
+    #[doc = include_str!("../../docs/client/server_profile.md")]
+    pub async fn server_profile(
+        &self,
+        options: ServerProfileOptions,
+    ) -> ClientResult<ServerProfile> {
+        let msg = Request {
+            msg_id: self.gen_id(),
+            entity_id: "".to_string(),
+            client_req: Some(ClientReq::ServerProfileReq(ServerProfileReq {
+                include_records: options.include_records.unwrap_or_default(),
+                reset: options.reset.unwrap_or_default(),
+            })),
+        };
+
+        match self.oneshot(&msg).await? {
+            ClientResp::ServerProfileResp(resp) => Ok(resp),
+            resp => Err(resp.into()),
+        }
+    }
 }
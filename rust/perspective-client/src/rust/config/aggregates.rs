@@ -16,8 +16,8 @@ use std::str::FromStr;
 use serde::{Deserialize, Serialize};
 use ts_rs::TS;
 
-use crate::proto;
 use crate::proto::view_config;
+use crate::{proto, ClientError};
 
 #[derive(Clone, Copy, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
 #[serde()]
@@ -52,6 +52,30 @@ pub enum SingleAggregate {
     #[serde(rename = "median")]
     Median,
 
+    #[serde(rename = "p25")]
+    P25,
+
+    #[serde(rename = "p75")]
+    P75,
+
+    #[serde(rename = "p90")]
+    P90,
+
+    #[serde(rename = "p99")]
+    P99,
+
+    #[serde(rename = "approx distinct count")]
+    ApproxDistinctCount,
+
+    #[serde(rename = "approx median")]
+    ApproxMedian,
+
+    #[serde(rename = "approx p90")]
+    ApproxP90,
+
+    #[serde(rename = "approx p99")]
+    ApproxP99,
+
     #[serde(rename = "first by index")]
     FirstByIndex,
 
@@ -117,6 +141,14 @@ impl Display for SingleAggregate {
             Self::Unique => "unique",
             Self::Dominant => "dominant",
             Self::Median => "median",
+            Self::P25 => "p25",
+            Self::P75 => "p75",
+            Self::P90 => "p90",
+            Self::P99 => "p99",
+            Self::ApproxDistinctCount => "approx distinct count",
+            Self::ApproxMedian => "approx median",
+            Self::ApproxP90 => "approx p90",
+            Self::ApproxP99 => "approx p99",
             Self::First => "first",
             Self::FirstByIndex => "first by index",
             Self::LastByIndex => "last by index",
@@ -155,6 +187,14 @@ impl FromStr for SingleAggregate {
             "unique" => Ok(Self::Unique),
             "dominant" => Ok(Self::Dominant),
             "median" => Ok(Self::Median),
+            "p25" => Ok(Self::P25),
+            "p75" => Ok(Self::P75),
+            "p90" => Ok(Self::P90),
+            "p99" => Ok(Self::P99),
+            "approx distinct count" => Ok(Self::ApproxDistinctCount),
+            "approx median" => Ok(Self::ApproxMedian),
+            "approx p90" => Ok(Self::ApproxP90),
+            "approx p99" => Ok(Self::ApproxP99),
             "first by index" => Ok(Self::FirstByIndex),
             "first" => Ok(Self::First),
             "last by index" => Ok(Self::LastByIndex),
@@ -192,11 +232,82 @@ impl Display for MultiAggregate {
     }
 }
 
+/// Aggregates over the rows of a group whose order column is within a
+/// window of the group's newest row, written `[agg, order column, window]`.
+/// The window is in the units of the order column, i.e. milliseconds for
+/// datetimes.
+#[derive(Clone, Copy, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
+#[serde()]
+pub enum RollingAggregate {
+    #[serde(rename = "rolling sum")]
+    Sum,
+
+    #[serde(rename = "rolling count")]
+    Count,
+
+    #[serde(rename = "rolling mean")]
+    Mean,
+
+    #[serde(rename = "rolling min")]
+    Min,
+
+    #[serde(rename = "rolling max")]
+    Max,
+}
+
+impl Display for RollingAggregate {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        let term = match self {
+            Self::Sum => "rolling sum",
+            Self::Count => "rolling count",
+            Self::Mean => "rolling mean",
+            Self::Min => "rolling min",
+            Self::Max => "rolling max",
+        };
+
+        write!(f, "{}", term)
+    }
+}
+
+impl FromStr for RollingAggregate {
+    type Err = String;
+
+    fn from_str(value: &str) -> Result<Self, String> {
+        match value {
+            "rolling sum" => Ok(Self::Sum),
+            "rolling count" => Ok(Self::Count),
+            "rolling mean" => Ok(Self::Mean),
+            "rolling min" => Ok(Self::Min),
+            "rolling max" => Ok(Self::Max),
+            x => Err(format!("Unknown rolling aggregate `{}`", x)),
+        }
+    }
+}
+
+/// The rolling counterpart of `MultiAggregate`, written
+/// `[agg, order column, window, weight column]`.
+#[derive(Clone, Copy, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
+#[serde()]
+pub enum RollingMultiAggregate {
+    #[serde(rename = "rolling weighted mean")]
+    WeightedMean,
+}
+
+impl Display for RollingMultiAggregate {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        match self {
+            RollingMultiAggregate::WeightedMean => write!(f, "rolling weighted mean"),
+        }
+    }
+}
+
 #[derive(Clone, Debug, Deserialize, Eq, Ord, PartialEq, PartialOrd, Serialize, TS)]
 #[serde(untagged)]
 pub enum Aggregate {
     SingleAggregate(SingleAggregate),
     MultiAggregate(MultiAggregate, String),
+    RollingAggregate(RollingAggregate, String, i64),
+    RollingMultiAggregate(RollingMultiAggregate, String, i64, String),
 }
 
 impl From<&'static str> for Aggregate {
@@ -212,6 +323,16 @@ impl Display for Aggregate {
             Self::MultiAggregate(MultiAggregate::WeightedMean, x) => {
                 write!(fmt, "weighted mean by {}", x)?
             },
+            Self::RollingAggregate(x, order, window) => {
+                write!(fmt, "{} by {} over {}", x, order, window)?
+            },
+            Self::RollingMultiAggregate(RollingMultiAggregate::WeightedMean, order, window, x) => {
+                write!(
+                    fmt,
+                    "rolling weighted mean by {} over {} weighted by {}",
+                    order, window, x
+                )?
+            },
         };
         Ok(())
     }
@@ -224,6 +345,23 @@ impl FromStr for Aggregate {
         Ok(
             if let Some(stripped) = input.strip_prefix("weighted mean by ") {
                 Self::MultiAggregate(MultiAggregate::WeightedMean, stripped.to_owned())
+            } else if let Some(stripped) = input.strip_prefix("rolling weighted mean by ") {
+                let (rest, weight) = stripped
+                    .rsplit_once(" weighted by ")
+                    .ok_or_else(|| format!("Unknown aggregate `{}`", input))?;
+                let (order, window) = parse_rolling_window(input, rest)?;
+                Self::RollingMultiAggregate(
+                    RollingMultiAggregate::WeightedMean,
+                    order,
+                    window,
+                    weight.to_owned(),
+                )
+            } else if let Some((agg, rest)) = input
+                .split_once(" by ")
+                .filter(|(agg, _)| agg.starts_with("rolling "))
+            {
+                let (order, window) = parse_rolling_window(input, rest)?;
+                Self::RollingAggregate(RollingAggregate::from_str(agg)?, order, window)
             } else {
                 Self::SingleAggregate(SingleAggregate::from_str(input)?)
             },
@@ -231,8 +369,16 @@ impl FromStr for Aggregate {
     }
 }
 
+/// Parses the `"{order} over {window}"` suffix of a rolling aggregate.
+fn parse_rolling_window(input: &str, rest: &str) -> Result<(String, i64), String> {
+    rest.rsplit_once(" over ")
+        .and_then(|(order, window)| Some((order.to_owned(), window.parse().ok()?)))
+        .ok_or_else(|| format!("Unknown aggregate `{}`", input))
+}
+
 const STRING_AGGREGATES: &[SingleAggregate] = &[
     SingleAggregate::Any,
+    SingleAggregate::ApproxDistinctCount,
     SingleAggregate::Count,
     SingleAggregate::DistinctCount,
     SingleAggregate::Dominant,
@@ -247,6 +393,10 @@ const STRING_AGGREGATES: &[SingleAggregate] = &[
 const NUMBER_AGGREGATES: &[SingleAggregate] = &[
     SingleAggregate::AbsSum,
     SingleAggregate::Any,
+    SingleAggregate::ApproxDistinctCount,
+    SingleAggregate::ApproxMedian,
+    SingleAggregate::ApproxP90,
+    SingleAggregate::ApproxP99,
     SingleAggregate::Avg,
     SingleAggregate::Count,
     SingleAggregate::DistinctCount,
@@ -262,6 +412,10 @@ const NUMBER_AGGREGATES: &[SingleAggregate] = &[
     SingleAggregate::Last,
     SingleAggregate::Mean,
     SingleAggregate::Median,
+    SingleAggregate::P25,
+    SingleAggregate::P75,
+    SingleAggregate::P90,
+    SingleAggregate::P99,
     SingleAggregate::PctSumParent,
     SingleAggregate::PctSumGrandTotal,
     SingleAggregate::StdDev,
@@ -304,15 +458,52 @@ impl From<Aggregate> for view_config::AggList {
             aggregations: match value {
                 Aggregate::SingleAggregate(x) => vec![format!("{}", x)],
                 Aggregate::MultiAggregate(x, y) => vec![format!("{}", x), format!("{}", y)],
+                Aggregate::RollingAggregate(x, order, window) => {
+                    vec![format!("{}", x), order, format!("{}", window)]
+                },
+                Aggregate::RollingMultiAggregate(x, order, window, weight) => {
+                    vec![format!("{}", x), order, format!("{}", window), weight]
+                },
             },
         }
     }
 }
 
-impl From<view_config::AggList> for Aggregate {
-    fn from(value: view_config::AggList) -> Self {
-        Aggregate::SingleAggregate(
-            SingleAggregate::from_str(value.aggregations.first().unwrap()).unwrap(),
-        )
+impl TryFrom<view_config::AggList> for Aggregate {
+    type Error = ClientError;
+
+    fn try_from(value: view_config::AggList) -> Result<Self, Self::Error> {
+        let parse_window = |window: &String| {
+            window
+                .parse()
+                .map_err(|_| ClientError::Internal(format!("Invalid window `{}`", window)))
+        };
+
+        match value.aggregations.as_slice() {
+            [name] => Ok(Aggregate::SingleAggregate(
+                SingleAggregate::from_str(name).map_err(ClientError::Internal)?,
+            )),
+            [name, weight] if name == "weighted mean" => Ok(Aggregate::MultiAggregate(
+                MultiAggregate::WeightedMean,
+                weight.clone(),
+            )),
+            [name, order, window] => Ok(Aggregate::RollingAggregate(
+                RollingAggregate::from_str(name).map_err(ClientError::Internal)?,
+                order.clone(),
+                parse_window(window)?,
+            )),
+            [name, order, window, weight] if name == "rolling weighted mean" => {
+                Ok(Aggregate::RollingMultiAggregate(
+                    RollingMultiAggregate::WeightedMean,
+                    order.clone(),
+                    parse_window(window)?,
+                    weight.clone(),
+                ))
+            },
+            x => Err(ClientError::Internal(format!(
+                "Unknown aggregate `{:?}`",
+                x
+            ))),
+        }
     }
 }
@@ -19,8 +19,8 @@ use super::aggregates::*;
 use super::expressions::*;
 use super::filters::*;
 use super::sort::*;
-use crate::proto;
 use crate::proto::columns_update;
+use crate::{proto, ClientError};
 
 #[derive(Clone, Debug, Deserialize, Default, PartialEq, Serialize)]
 #[serde(deny_unknown_fields)]
@@ -182,9 +182,11 @@ impl From<ViewConfig> for ViewConfigUpdate {
     }
 }
 
-impl From<proto::ViewConfig> for ViewConfig {
-    fn from(value: proto::ViewConfig) -> Self {
-        ViewConfig {
+impl TryFrom<proto::ViewConfig> for ViewConfig {
+    type Error = ClientError;
+
+    fn try_from(value: proto::ViewConfig) -> Result<Self, Self::Error> {
+        Ok(ViewConfig {
             group_by: value.group_by,
             split_by: value.split_by,
             columns: match value.columns.unwrap().opt_columns {
@@ -204,10 +206,10 @@ impl From<proto::ViewConfig> for ViewConfig {
             aggregates: value
                 .aggregates
                 .into_iter()
-                .map(|(x, y)| (x, y.into()))
-                .collect(),
+                .map(|(x, y)| Ok((x, y.try_into()?)))
+                .collect::<Result<_, ClientError>>()?,
             group_by_depth: value.group_by_depth,
-        }
+        })
     }
 }
 
@@ -26,9 +26,15 @@ pub mod config;
 pub mod proto;
 pub mod utils;
 
-pub use crate::client::{Client, ClientHandler, Features, SystemInfo};
+pub use crate::client::{
+    Client, ClientHandler, Features, ServerProfile, ServerProfileOptions, SystemInfo, TableMemory,
+    ViewMemory,
+};
 pub use crate::session::{ProxySession, Session};
-pub use crate::table::{Schema, Table, TableInitOptions, UpdateOptions, ValidateExpressionsData};
+pub use crate::table::{
+    Schema, Table, TableInitOptions, TableRetention, TableStorage, TableUpdatePolicy,
+    UpdateOptions, ValidateExpressionsData,
+};
 pub use crate::table_data::{TableData, UpdateData};
 pub use crate::view::{OnUpdateMode, OnUpdateOptions, View, ViewWindow};
 
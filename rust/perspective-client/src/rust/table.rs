@@ -55,6 +55,114 @@ pub struct TableInitOptions {
     #[serde(default)]
     #[ts(optional)]
     pub limit: Option<u32>,
+
+    /// This [`Table`] should remove rows whose `retention.column` value is
+    /// more than `retention.ttl` older than the newest value in that column,
+    /// after each [`Table::update`] is applied. Requires `index`.
+    #[serde(default)]
+    #[ts(optional)]
+    pub retention: Option<TableRetention>,
+
+    /// This [`Table`] should process [`Table::update`] calls at most once per
+    /// `update_policy.min_interval_ms`, conflating the updates sent in
+    /// between by `index` so the latest value wins.
+    #[serde(default)]
+    #[ts(optional)]
+    pub update_policy: Option<TableUpdatePolicy>,
+
+    /// Where this [`Table`] keeps its columns, in memory by default.
+    #[serde(default)]
+    #[ts(optional)]
+    pub storage: Option<TableStorage>,
+}
+
+/// A time window a [`Table`] keeps rows for, see
+/// [`TableInitOptions::retention`].
+#[derive(Clone, Debug, Serialize, Deserialize, TS)]
+pub struct TableRetention {
+    /// A `datetime` or `integer` column.
+    pub column: String,
+
+    /// The window size, in the units of `column` (milliseconds for a
+    /// `datetime`).
+    #[ts(type = "number")]
+    pub ttl: i64,
+}
+
+impl From<TableRetention> for make_table_req::Retention {
+    fn from(value: TableRetention) -> Self {
+        make_table_req::Retention {
+            column: value.column,
+            ttl: value.ttl,
+        }
+    }
+}
+
+/// How often a [`Table`] processes updates, see
+/// [`TableInitOptions::update_policy`].
+#[derive(Clone, Debug, Default, Serialize, Deserialize, TS)]
+pub struct TableUpdatePolicy {
+    #[serde(default)]
+    #[ts(optional)]
+    pub min_interval_ms: Option<u32>,
+
+    /// Process before `min_interval_ms` has elapsed once this many rows are
+    /// pending after conflation.
+    #[serde(default)]
+    #[ts(optional)]
+    pub max_batch_size: Option<u32>,
+}
+
+impl From<TableUpdatePolicy> for make_table_req::UpdatePolicy {
+    fn from(value: TableUpdatePolicy) -> Self {
+        make_table_req::UpdatePolicy {
+            min_interval_ms: value.min_interval_ms,
+            max_batch_size: value.max_batch_size,
+        }
+    }
+}
+
+/// Where a [`Table`] keeps its columns, see [`TableInitOptions::storage`].
+#[derive(Clone, Debug, Default, Serialize, Deserialize, TS)]
+pub struct TableStorage {
+    /// Map each column from a file in a directory of this name in the
+    /// server's storage directory, rather than keeping it in memory. The
+    /// directory is removed when the [`Table`] is deleted. Requires a server
+    /// with a filesystem.
+    #[serde(default)]
+    #[ts(optional)]
+    pub disk: Option<String>,
+
+    /// With `disk`, page out the least recently updated columns once more
+    /// than this many bytes of them are resident.
+    #[serde(default)]
+    #[ts(optional, type = "number")]
+    pub resident_budget: Option<u64>,
+
+    /// Without `disk`, compress numeric columns which no update has written
+    /// and nothing has read for this many updates, to save memory. They are
+    /// decompressed again when next accessed.
+    #[serde(default)]
+    #[ts(optional)]
+    pub compress_after_updates: Option<u32>,
+
+    /// `string` columns to keep an inverted index of, which speeds up `==`,
+    /// `!=`, `in`, `not in` and `is null` filters on them at the cost of
+    /// memory and update time. Other columns are ignored.
+    #[serde(default)]
+    #[ts(optional)]
+    pub indexed_columns: Option<Vec<String>>,
+}
+
+impl From<TableStorage> for make_table_req::Storage {
+    fn from(value: TableStorage) -> Self {
+        make_table_req::Storage {
+            disk: value.disk,
+            resident_budget: value.resident_budget.unwrap_or_default(),
+            compress_after_updates: value.compress_after_updates.unwrap_or_default(),
+            indexed_columns: value.indexed_columns.unwrap_or_default(),
+        }
+    }
 }
 
 impl TableInitOptions {
@@ -72,6 +180,7 @@ impl TryFrom<TableOptions> for MakeTableOptions {
                 TableOptions {
                     index: Some(_),
                     limit: Some(_),
+                    ..
                 } => Err(ClientError::BadTableOptions)?,
                 TableOptions {
                     index: Some(index), ..
@@ -89,6 +198,9 @@ impl TryFrom<TableOptions> for MakeTableOptions {
 pub(crate) struct TableOptions {
     pub index: Option<String>,
     pub limit: Option<u32>,
+    pub retention: Option<TableRetention>,
+    pub update_policy: Option<TableUpdatePolicy>,
+    pub storage: Option<TableStorage>,
 }
 
 impl From<TableInitOptions> for TableOptions {
@@ -96,6 +208,9 @@ impl From<TableInitOptions> for TableOptions {
         TableOptions {
             index: value.index,
             limit: value.limit,
+            retention: value.retention,
+            update_policy: value.update_policy,
+            storage: value.storage,
         }
     }
 }
@@ -220,6 +335,18 @@ impl Table {
         }
     }
 
+    #[doc = include_str!("../../docs/table/save_snapshot.md")]
+    pub async fn save_snapshot(&self, name: String) -> ClientResult<()> {
+        let msg = self.client_message(ClientReq::TableSaveSnapshotReq(TableSaveSnapshotReq {
+            name,
+        }));
+
+        match self.client.oneshot(&msg).await? {
+            ClientResp::TableSaveSnapshotResp(_) => Ok(()),
+            resp => Err(resp.into()),
+        }
+    }
+
     #[doc = include_str!("../../docs/table/make_port.md")]
     pub async fn make_port(&self) -> ClientResult<i32> {
         let msg = self.client_message(ClientReq::TableMakePortReq(TableMakePortReq {}));
@@ -40,6 +40,9 @@ impl std::fmt::Display for Request {
                 client_req:
                     Some(ClientReq::MakeTableReq(MakeTableReq {
                         ref options,
+                        ref update_policy,
+                        ref retention,
+                        ref storage,
                         data:
                             Some(MakeTableData {
                                 data: Some(ref data),
@@ -49,6 +52,9 @@ impl std::fmt::Display for Request {
             } => Request {
                 client_req: Some(ClientReq::MakeTableReq(MakeTableReq {
                     options: options.clone(),
+                    update_policy: update_policy.clone(),
+                    retention: retention.clone(),
+                    storage: storage.clone(),
                     data: Some(MakeTableData {
                         data: Some(replace(data.clone())),
                     }),
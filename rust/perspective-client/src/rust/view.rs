@@ -32,6 +32,15 @@ pub use crate::utils::*;
 #[derive(Default, Debug, Deserialize, TS)]
 pub struct OnUpdateOptions {
     pub mode: Option<OnUpdateMode>,
+
+    /// Only report changed rows of a pivoted view inside this window.
+    pub viewport: Option<ViewWindow>,
+
+    /// Call back at most once per interval, with the latest update. Ignored
+    /// in `"row"` mode.
+    #[serde(default)]
+    #[ts(optional)]
+    pub min_interval_ms: Option<u32>,
 }
 
 #[derive(Default, Debug, Deserialize, TS)]
@@ -164,7 +173,7 @@ impl View {
         match self.client.oneshot(&msg).await? {
             ClientResp::ViewGetConfigResp(ViewGetConfigResp {
                 config: Some(config),
-            }) => Ok(config.into()),
+            }) => config.try_into(),
             resp => Err(resp.into()),
         }
     }
@@ -300,6 +309,8 @@ impl View {
 
         let msg = self.client_message(ClientReq::ViewOnUpdateReq(ViewOnUpdateReq {
             mode: options.mode.map(|OnUpdateMode::Row| Mode::Row as i32),
+            viewport: options.viewport.map(|x| x.into()),
+            min_interval_ms: options.min_interval_ms,
         }));
 
         self.client.subscribe(&msg, Box::new(callback)).await?;
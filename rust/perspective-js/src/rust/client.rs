@@ -13,7 +13,7 @@
 use js_sys::{Function, Uint8Array};
 #[cfg(doc)]
 use perspective_client::SystemInfo;
-use perspective_client::{TableData, TableInitOptions};
+use perspective_client::{ServerProfileOptions, TableData, TableInitOptions};
 use wasm_bindgen::prelude::*;
 
 pub use crate::table::*;
@@ -100,6 +100,12 @@ impl Client {
         Ok(Table(self.client.open_table(entity_id).await?))
     }
 
+    #[doc = inherit_docs!("client/load_snapshot.md")]
+    #[wasm_bindgen]
+    pub async fn load_snapshot(&self, snapshot: String, name: Option<String>) -> ApiResult<Table> {
+        Ok(Table(self.client.load_snapshot(snapshot, name).await?))
+    }
+
     #[doc = inherit_docs!("client/get_hosted_table_names.md")]
     #[wasm_bindgen]
     pub async fn get_hosted_table_names(&self) -> ApiResult<JsValue> {
@@ -114,4 +120,15 @@ impl Client {
         let info = self.client.system_info().await?;
         Ok(JsValue::from_serde_ext(&info)?)
     }
+
+    #[doc = inherit_docs!("client/server_profile.md")]
+    #[wasm_bindgen]
+    pub async fn server_profile(&self, options: Option<JsValue>) -> ApiResult<JsValue> {
+        let options = options
+            .into_serde_ext::<Option<ServerProfileOptions>>()?
+            .unwrap_or_default();
+
+        let profile = self.client.server_profile(options).await?;
+        Ok(JsValue::from_serde_ext(&profile)?)
+    }
 }
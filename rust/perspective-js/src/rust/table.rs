@@ -211,6 +211,12 @@ impl Table {
         Ok(JsValue::from_serde_ext(&columns)?)
     }
 
+    #[doc = inherit_docs!("table/save_snapshot.md")]
+    #[wasm_bindgen]
+    pub async fn save_snapshot(&self, name: String) -> ApiResult<()> {
+        Ok(self.0.save_snapshot(name).await?)
+    }
+
     #[doc = inherit_docs!("table/make_port.md")]
     #[wasm_bindgen]
     pub async fn make_port(&self) -> ApiResult<i32> {
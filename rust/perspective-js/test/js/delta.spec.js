@@ -1695,5 +1695,134 @@ function it_old_behavior(name, capture) {
                 }
             );
         });
+
+        test.describe("2-sided row delta, viewport", function () {
+            const viewport_data = {
+                k: ["a", "b", "c", "d"],
+                g: ["x", "x", "y", "y"],
+                v: [1, 2, 3, 4],
+            };
+
+            async function without_row_path(view, options) {
+                const json = await view.to_json(options);
+                return json.map((d) => {
+                    delete d["__ROW_PATH__"];
+                    return d;
+                });
+            }
+
+            it_old_behavior(
+                "returns changed rows inside the viewport, split by only",
+                async function (done) {
+                    let table = await perspective.table(viewport_data, {
+                        index: "k",
+                    });
+                    let view = await table.view({
+                        split_by: ["k"],
+                        columns: ["v"],
+                    });
+                    view.on_update(
+                        async function (updated) {
+                            const expected = await without_row_path(view, {
+                                start_row: 1,
+                                end_row: 2,
+                            });
+
+                            expect(expected.length).toEqual(1);
+                            expect(expected[0]["b|v"]).toEqual(20);
+                            await match_delta(
+                                perspective,
+                                updated.delta,
+                                expected
+                            );
+                            view.delete();
+                            table.delete();
+                            done();
+                        },
+                        { mode: "row", viewport: { start_row: 1, end_row: 2 } }
+                    );
+                    table.update({ k: ["b"], v: [20] });
+                }
+            );
+
+            it_old_behavior(
+                "returns nothing when the viewport excludes changed rows, split by only",
+                async function (done) {
+                    let table = await perspective.table(viewport_data, {
+                        index: "k",
+                    });
+                    let view = await table.view({
+                        split_by: ["k"],
+                        columns: ["v"],
+                    });
+                    view.on_update(
+                        async function (updated) {
+                            await match_delta(perspective, updated.delta, []);
+                            view.delete();
+                            table.delete();
+                            done();
+                        },
+                        { mode: "row", viewport: { start_row: 2, end_row: 4 } }
+                    );
+                    table.update({ k: ["b"], v: [20] });
+                }
+            );
+
+            it_old_behavior(
+                "returns changed rows inside the column viewport, sorted",
+                async function (done) {
+                    let table = await perspective.table(viewport_data, {
+                        index: "k",
+                    });
+                    let view = await table.view({
+                        group_by: ["g"],
+                        split_by: ["k"],
+                        columns: ["v"],
+                        sort: [["v", "desc"]],
+                    });
+                    view.on_update(
+                        async function (updated) {
+                            const json = await without_row_path(view);
+                            expect(json[1]["d|v"]).toEqual(40);
+                            await match_delta(
+                                perspective,
+                                updated.delta,
+                                json.slice(0, 2)
+                            );
+                            view.delete();
+                            table.delete();
+                            done();
+                        },
+                        { mode: "row", viewport: { start_col: 2, end_col: 4 } }
+                    );
+                    table.update({ k: ["d"], v: [40] });
+                }
+            );
+
+            it_old_behavior(
+                "returns nothing when the column viewport excludes changed cells, sorted",
+                async function (done) {
+                    let table = await perspective.table(viewport_data, {
+                        index: "k",
+                    });
+                    let view = await table.view({
+                        group_by: ["g"],
+                        split_by: ["k"],
+                        columns: ["v"],
+                        sort: [["v", "desc"]],
+                    });
+                    view.on_update(
+                        async function (updated) {
+                            await match_delta(perspective, updated.delta, []);
+                            view.delete();
+                            table.delete();
+                            done();
+                        },
+                        { mode: "row", viewport: { start_col: 0, end_col: 1 } }
+                    );
+                    table.update({ k: ["d"], v: [40] });
+                }
+            );
+        });
     });
 })(perspective);
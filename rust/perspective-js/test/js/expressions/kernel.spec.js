@@ -0,0 +1,118 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "../perspective_client";
+
+/**
+ * Numeric pipelines are evaluated by a vectorized kernel rather than ExprTk.
+ * Wrapping an expression in a variable assignment keeps it out of the kernel,
+ * so each expression is compared against its interpreted twin.
+ */
+const EXPRESSIONS = [
+    '"a" + "b"',
+    '"a" - "b" * 2',
+    '"a" / "b"',
+    '"a" % "b"',
+    '-"a"',
+    '"a" > "b"',
+    '"a" == "b"',
+    '"a" != "b"',
+    '"a" > 1 and "b" < 3',
+    '"a" > 1 or "b" < 3',
+    'if ("a" > "b", "a", "b")',
+    'if ("a" > 1 and "b" > 1, "a" + "b", 0)',
+    'if ("a", 1, 2)',
+    'if ("a" - "b", 1, 2)',
+    'if ("i" > 1, 1, 2)',
+    '"i" * "a"',
+];
+
+function interpreted(expression) {
+    return `var r := ${expression}; r`;
+}
+
+async function compare_to_interpreter(data) {
+    const table = await perspective.table({
+        a: "float",
+        b: "float",
+        i: "integer",
+    });
+
+    await table.update(data);
+    const expressions = {};
+    for (const expression of EXPRESSIONS) {
+        expressions[expression] = expression;
+        expressions[interpreted(expression)] = interpreted(expression);
+    }
+
+    const view = await table.view({ expressions });
+    const schema = await view.expression_schema();
+    const results = await view.to_columns();
+    for (const expression of EXPRESSIONS) {
+        expect(schema[expression]).toEqual(schema[interpreted(expression)]);
+        expect(results[expression]).toEqual(results[interpreted(expression)]);
+    }
+
+    view.delete();
+    table.delete();
+}
+
+((perspective) => {
+    test.describe("Expression kernel", function () {
+        test("matches the interpreter", async function () {
+            await compare_to_interpreter({
+                a: [1.5, 2, 3, 0, -4.25, 10],
+                b: [2, 2, 0.5, 0, 3, -1],
+                i: [1, 2, 3, 4, 5, 6],
+            });
+        });
+
+        test("matches the interpreter with nulls", async function () {
+            await compare_to_interpreter({
+                a: [1.5, null, 3, 0, null, 10],
+                b: [null, 2, 0.5, 0, null, -1],
+                i: [1, 2, null, 4, 5, null],
+            });
+        });
+
+        test("matches the interpreter after updates", async function () {
+            const table = await perspective.table(
+                {
+                    k: [1, 2, 3, 4],
+                    a: [1.5, 2, 3, 0],
+                    b: [2, 2, 0.5, 0],
+                },
+                { index: "k" }
+            );
+
+            const expression = 'if ("a" > "b", "a" / "b", "b" - "a")';
+            const view = await table.view({
+                expressions: {
+                    kernel: expression,
+                    interpreted: interpreted(expression),
+                },
+            });
+
+            await table.update({
+                k: [2, 4, 5],
+                a: [null, 4, 1],
+                b: [1, 0, null],
+            });
+
+            const results = await view.to_columns();
+            expect(results.kernel).toEqual(results.interpreted);
+            view.delete();
+            table.delete();
+        });
+    });
+})(perspective);
@@ -2515,4 +2515,83 @@ const random_string = (
             await table.delete();
         });
     });
+
+    test.describe("Repeated vocab values", () => {
+        const EXPRESSIONS = {
+            upper: 'upper("s")',
+            length: 'length("s")',
+            prefix: 'substring("s", 0, 2)',
+        };
+
+        const expected = (s) => ({
+            upper: s === null ? null : s.toUpperCase(),
+            length: s === null ? null : s.length,
+            prefix: s === null ? null : s.substring(0, 2),
+        });
+
+        const check = async (view) => {
+            const result = await view.to_columns();
+            for (let i = 0; i < result.s.length; i++) {
+                const row = expected(result.s[i]);
+                for (const name of Object.keys(EXPRESSIONS)) {
+                    expect(result[name][i]).toEqual(row[name]);
+                }
+            }
+
+            return result;
+        };
+
+        test("match a per-row evaluation across updates", async () => {
+            const values = ["alpha", "beta", "gamma", null];
+            const table = await perspective.table(
+                {
+                    id: [...Array(200).keys()],
+                    s: [...Array(200).keys()].map((i) => values[i % 4]),
+                },
+                { index: "id" }
+            );
+
+            const view = await table.view({ expressions: EXPRESSIONS });
+            await check(view);
+
+            // Rows moved between existing entries, onto new entries, and to
+            // and from null, plus appended rows repeating every entry.
+            await table.update({
+                id: [0, 1, 3, 7, 8, 9],
+                s: ["beta", "delta", "alpha", "delta", null, "epsilon"],
+            });
+
+            await table.update({
+                id: [...Array(50).keys()].map((i) => 200 + i),
+                s: [...Array(50).keys()].map((i) =>
+                    i % 5 === 0 ? "zeta" : values[i % 4]
+                ),
+            });
+
+            await table.update({ id: [2, 200], s: ["zeta", "gamma"] });
+
+            const result = await check(view);
+            expect(result.s.length).toEqual(250);
+            expect(result.s.slice(0, 4)).toEqual([
+                "beta",
+                "delta",
+                "zeta",
+                "alpha",
+            ]);
+            expect(result.upper.slice(0, 4)).toEqual([
+                "BETA",
+                "DELTA",
+                "ZETA",
+                "ALPHA",
+            ]);
+
+            // A view created after the updates computes every row at once.
+            const fresh = await table.view({ expressions: EXPRESSIONS });
+            expect(await check(fresh)).toEqual(result);
+
+            await fresh.delete();
+            await view.delete();
+            await table.delete();
+        });
+    });
 })(perspective);
@@ -0,0 +1,117 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+const data = {
+    id: [1, 2, 3, 4, 5, 6, 7, 8],
+    g: ["a", "a", "a", "b", "b", "b", "b", "b"],
+    x: [1.5, 4.5, 2.5, 10.5, 30.5, 20.5, 40.5, 50.5],
+};
+
+const PERCENTILES = ["median", "p25", "p75", "p90", "p99"];
+
+async function percentiles(table) {
+    const results = {};
+    for (const agg of PERCENTILES) {
+        const view = await table.view({
+            group_by: ["g"],
+            columns: ["x"],
+            aggregates: { x: agg },
+        });
+
+        results[agg] = (await view.to_columns()).x;
+        await view.delete();
+    }
+
+    return results;
+}
+
+((perspective) => {
+    test.describe("Percentile aggregates", function () {
+        test("pick the value at rank floor(p * n / 100)", async function () {
+            const table = await perspective.table(data, { index: "id" });
+
+            // An exact rank on a float column averages it with the value
+            // before it, as the 8-row total does for all but p90 and p99.
+            expect(await percentiles(table)).toEqual({
+                median: [15.5, 2.5, 30.5],
+                p25: [3.5, 1.5, 20.5],
+                p75: [35.5, 4.5, 40.5],
+                p90: [50.5, 4.5, 50.5],
+                p99: [50.5, 4.5, 50.5],
+            });
+
+            await table.delete();
+        });
+
+        test("views kept up to date match views built after the updates", async function () {
+            const table = await perspective.table(data, { index: "id" });
+            const views = {};
+            for (const agg of PERCENTILES) {
+                views[agg] = await table.view({
+                    group_by: ["g"],
+                    columns: ["x"],
+                    aggregates: { x: agg },
+                });
+
+                await views[agg].to_columns();
+            }
+
+            // Update values in place, move rows between groups, add a
+            // group and remove rows, so that every node's ranks shift.
+            await table.update({ id: [2, 5], x: [0.5, 60.5] });
+            await table.update({ id: [4, 6], g: ["a", "c"] });
+            await table.update({ id: [9, 10], g: ["c", "c"], x: [7.5, 8.5] });
+            await table.remove([1, 8]);
+
+            const flat = await table.view();
+            const fresh = await perspective.table(await flat.to_columns(), {
+                index: "id",
+            });
+
+            await flat.delete();
+
+            const expected = await percentiles(fresh);
+            for (const agg of PERCENTILES) {
+                expect((await views[agg].to_columns()).x).toEqual(
+                    expected[agg]
+                );
+
+                await views[agg].delete();
+            }
+
+            await fresh.delete();
+            await table.delete();
+        });
+
+        test("median of an integer column", async function () {
+            const table = await perspective.table(
+                { id: [1, 2, 3, 4], x: [4, 1, 3, 2] },
+                { index: "id" }
+            );
+
+            const view = await table.view({
+                group_by: ["id"],
+                columns: ["x"],
+                aggregates: { x: "median" },
+            });
+
+            expect((await view.to_columns()).x).toEqual([3, 4, 1, 3, 2]);
+            await table.update({ id: [5], x: [5] });
+            expect((await view.to_columns()).x).toEqual([3, 4, 1, 3, 2, 5]);
+            await view.delete();
+            await table.delete();
+        });
+    });
+})(perspective);
@@ -488,3 +488,54 @@ test.describe("Removes", () => {
         }
     }
 });
+
+test.describe("Removes with expressions", () => {
+    test("Expression columns are aligned after removes", async () => {
+        const table = await perspective.table(SCHEMA, { index: "int" });
+        table.update({
+            str: ["a", "b", "c", "d", "e", "f"],
+            int: [1, 2, 3, 4, 5, 6],
+            float: [0.5, 1, 1.5, 2, 2.5, 3],
+        });
+
+        const flat = await table.view({
+            expressions: { doubled: '"float" * 2', upper: 'upper("str")' },
+        });
+
+        const pivoted = await table.view({
+            group_by: ["int"],
+            columns: ["doubled"],
+            aggregates: { doubled: "sum" },
+            expressions: { doubled: '"float" * 2' },
+        });
+
+        await table.remove([2, 4]);
+        await table.update({
+            str: ["g", "h", "e"],
+            int: [7, 8, 5],
+            float: [3.5, 4, 10],
+        });
+
+        const flat_data = await flat.to_columns();
+        expect(flat_data.doubled).toEqual(flat_data.float.map((x) => x * 2));
+        expect(flat_data.upper).toEqual(
+            flat_data.str.map((x) => x.toUpperCase())
+        );
+
+        const pivoted_data = await pivoted.to_columns();
+        expect(pivoted_data.__ROW_PATH__).toEqual([
+            [],
+            [1],
+            [3],
+            [5],
+            [6],
+            [7],
+            [8],
+        ]);
+
+        expect(pivoted_data.doubled).toEqual([45, 1, 3, 20, 6, 7, 8]);
+        await pivoted.delete();
+        await flat.delete();
+        await table.delete();
+    });
+});
@@ -0,0 +1,125 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+const schema = {
+    id: "integer",
+    ts: "datetime",
+    x: "integer",
+};
+
+const options = {
+    index: "id",
+    retention: { column: "ts", ttl: 1000 },
+};
+
+((perspective) => {
+    test.describe("Retention", function () {
+        test("updates evict rows older than the window", async function () {
+            const table = await perspective.table(schema, options);
+            const view = await table.view();
+            await table.update({
+                id: [1, 2, 3],
+                ts: [0, 500, 1500],
+                x: [10, 20, 30],
+            });
+
+            expect(await view.to_columns()).toEqual({
+                id: [2, 3],
+                ts: [500, 1500],
+                x: [20, 30],
+            });
+
+            await table.update({ id: [4], ts: [2000], x: [40] });
+            expect(await view.to_columns()).toEqual({
+                id: [3, 4],
+                ts: [1500, 2000],
+                x: [30, 40],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("pivoted views see evicted rows as removes", async function () {
+            const table = await perspective.table(schema, options);
+            const view = await table.view({
+                group_by: ["id"],
+                columns: ["x"],
+            });
+
+            await table.update({
+                id: [1, 2, 3],
+                ts: [0, 500, 1500],
+                x: [10, 20, 30],
+            });
+
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], [2], [3]],
+                x: [50, 20, 30],
+            });
+
+            await table.update({ id: [4], ts: [2000], x: [40] });
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], [3], [4]],
+                x: [70, 30, 40],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("integer columns are evicted by value", async function () {
+            const table = await perspective.table(
+                { id: "integer", seq: "integer" },
+                { index: "id", retention: { column: "seq", ttl: 10 } }
+            );
+
+            const view = await table.view();
+            await table.update({ id: [1, 2, 3], seq: [1, 5, 20] });
+            expect(await view.to_columns()).toEqual({
+                id: [3],
+                seq: [20],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("an update refreshing an expired row keeps it", async function () {
+            const table = await perspective.table(schema, options);
+            const view = await table.view();
+            await table.update({ id: [1, 2], ts: [0, 500], x: [10, 20] });
+
+            // Row 1 is expired by the window this update moves to, but the
+            // update refreshes its timestamp, so only its `ts` changes.
+            await table.update({ id: [1], ts: [2000] });
+            expect(await view.to_columns()).toEqual({
+                id: [1],
+                ts: [2000],
+                x: [10],
+            });
+
+            await table.update({ id: [3], ts: [3500], x: [30] });
+            expect(await view.to_columns()).toEqual({
+                id: [3],
+                ts: [3500],
+                x: [30],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+    });
+})(perspective);
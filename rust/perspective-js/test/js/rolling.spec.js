@@ -0,0 +1,108 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+const data = {
+    id: [1, 2, 3, 4, 5, 6],
+    t: [1, 2, 3, 4, 5, 6],
+    g: ["a", "a", "a", "b", "b", "b"],
+    x: [1, 2, 3, 4, 5, 6],
+    w: [1, 1, 2, 1, 1, 1],
+};
+
+((perspective) => {
+    test.describe("Rolling aggregates", function () {
+        test("rolling sum follows updates", async function () {
+            const table = await perspective.table(data, { index: "id" });
+            const view = await table.view({
+                group_by: ["g"],
+                columns: ["x"],
+                aggregates: { x: ["rolling sum", "t", 2] },
+            });
+
+            // Each group sums the rows whose `t` is within 2 of its newest.
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], ["a"], ["b"]],
+                x: [11, 5, 11],
+            });
+
+            await table.update({ id: [7], t: [7], g: ["a"], x: [10] });
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], ["a"], ["b"]],
+                x: [16, 10, 11],
+            });
+
+            await table.update({ id: [6], x: [0] });
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], ["a"], ["b"]],
+                x: [10, 10, 5],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("rolling weighted mean", async function () {
+            const table = await perspective.table(data, { index: "id" });
+            const view = await table.view({
+                group_by: ["g"],
+                columns: ["x"],
+                aggregates: { x: ["rolling weighted mean", "t", 2, "w"] },
+            });
+
+            expect(await view.to_columns()).toEqual({
+                __ROW_PATH__: [[], ["a"], ["b"]],
+                x: [5.5, 8 / 3, 5.5],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("get_config returns rolling aggregates", async function () {
+            const table = await perspective.table(data, { index: "id" });
+            const aggregates = {
+                x: ["rolling sum", "t", 2],
+                w: ["rolling weighted mean", "t", 2, "x"],
+            };
+
+            const view = await table.view({
+                group_by: ["g"],
+                columns: ["x", "w"],
+                aggregates,
+            });
+
+            expect((await view.get_config()).aggregates).toEqual(aggregates);
+            await view.delete();
+            await table.delete();
+        });
+
+        test("unknown rolling aggregates are rejected", async function () {
+            const table = await perspective.table(data, { index: "id" });
+            let threw = false;
+            try {
+                await table.view({
+                    group_by: ["g"],
+                    columns: ["x"],
+                    aggregates: { x: ["rolling median", "t", 2] },
+                });
+            } catch (e) {
+                threw = true;
+            }
+
+            expect(threw).toBeTruthy();
+            await table.delete();
+        });
+    });
+})(perspective);
@@ -0,0 +1,90 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+function stages(trace) {
+    return Object.fromEntries(trace.stages.map((s) => [s.stage, s]));
+}
+
+((perspective) => {
+    test.describe("server_profile", function () {
+        test("reports the stages of each table and view", async function () {
+            const table = await perspective.table(
+                { id: [1, 2, 3], x: ["a", "b", "a"] },
+                { index: "id", name: "server_profile_stages" }
+            );
+
+            const view = await table.view({ group_by: ["x"] });
+            view.on_update(() => {}, { mode: "row" });
+            await table.update({ id: [4], x: ["c"] });
+            await table.update({ id: [1, 5], x: ["b", "c"] });
+            await table.size();
+
+            const { tables } = await perspective.server_profile();
+            const profile = tables.find(
+                (t) => t.table_id === "server_profile_stages"
+            );
+
+            // Pending updates may be processed together, so counts are
+            // compared to each other rather than to the number of calls.
+            const table_stages = stages(profile.trace);
+            const processed = table_stages.flatten.count;
+            expect(processed).toBeGreaterThan(1);
+            expect(table_stages.pkey_lookup.count).toEqual(processed);
+            expect(table_stages.update_master.count).toEqual(processed);
+            expect(table_stages.process_columns.count).toEqual(processed - 1);
+            expect(table_stages.flatten.rows).toEqual(6);
+            expect(profile.trace.records).toEqual([]);
+
+            // The view is notified of every update after the first.
+            expect(profile.views.length).toEqual(1);
+            const view_stages = stages(profile.views[0].trace);
+            expect(view_stages.context_notify.count).toEqual(processed - 1);
+            expect(view_stages.delta_serialize.count).toEqual(processed - 1);
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("include_records and reset", async function () {
+            const table = await perspective.table(
+                { x: [1, 2, 3] },
+                { name: "server_profile_reset" }
+            );
+
+            await table.update({ x: [4] });
+            await table.size();
+
+            const find = ({ tables }) =>
+                tables.find((t) => t.table_id === "server_profile_reset");
+
+            const profile = find(
+                await perspective.server_profile({
+                    include_records: true,
+                    reset: true,
+                })
+            );
+
+            const flattens = profile.trace.records.filter(
+                (r) => r.stage === "flatten"
+            );
+
+            expect(flattens.map((r) => r.rows)).toEqual([3, 1]);
+            const cleared = find(await perspective.server_profile());
+            expect(cleared.trace.stages).toEqual([]);
+            expect(cleared.trace.records).toEqual([]);
+            await table.delete();
+        });
+    });
+})(perspective);
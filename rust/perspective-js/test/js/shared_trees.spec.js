@@ -0,0 +1,134 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+/**
+ * Pivoted views with identical configs share their sparse trees, so views
+ * whose configs differ in any way must never see each other's aggregates.
+ */
+const data = {
+    k: [1, 2, 3, 4],
+    g: ["a", "a", "b", "b"],
+    bid: [1, 2, 3, 4],
+    qty: [10, 20, 30, null],
+    px: [100.00015, 100.00005, 100.00025, 99],
+};
+
+async function sum_by_group(table, config) {
+    const view = await table.view({
+        group_by: ["g"],
+        aggregates: { x: "sum", bid: "sum" },
+        ...config,
+    });
+
+    return view;
+}
+
+((perspective) => {
+    test.describe("Shared sparse trees", function () {
+        test("views with different expressions under one alias", async function () {
+            const table = await perspective.table(data, { index: "k" });
+            const bid = await sum_by_group(table, {
+                columns: ["x"],
+                expressions: { x: '"bid" * 2' },
+            });
+
+            const qty = await sum_by_group(table, {
+                columns: ["x"],
+                expressions: { x: '"qty" * 2' },
+            });
+
+            expect((await bid.to_columns()).x).toEqual([20, 6, 14]);
+            expect((await qty.to_columns()).x).toEqual([120, 60, 60]);
+
+            await table.update({ k: [1, 4], bid: [5, 6], qty: [1, 2] });
+            expect((await bid.to_columns()).x).toEqual([32, 14, 18]);
+            expect((await qty.to_columns()).x).toEqual([106, 42, 64]);
+
+            await qty.delete();
+            await bid.delete();
+            await table.delete();
+        });
+
+        test("views with nearly equal float filters", async function () {
+            const table = await perspective.table(data, { index: "k" });
+            const low = await sum_by_group(table, {
+                columns: ["bid"],
+                filter: [["px", ">", 100.0001]],
+            });
+
+            const high = await sum_by_group(table, {
+                columns: ["bid"],
+                filter: [["px", ">", 100.0002]],
+            });
+
+            expect((await low.to_columns()).bid).toEqual([4, 1, 3]);
+            expect((await high.to_columns()).bid).toEqual([3, 3]);
+
+            await table.update({ k: [4], px: [100.00012] });
+            expect((await low.to_columns()).bid).toEqual([8, 1, 7]);
+            expect((await high.to_columns()).bid).toEqual([3, 3]);
+
+            await high.delete();
+            await low.delete();
+            await table.delete();
+        });
+
+        test("views with is null and is not null filters", async function () {
+            const table = await perspective.table(data, { index: "k" });
+            const nulls = await sum_by_group(table, {
+                columns: ["bid"],
+                filter: [["qty", "is null"]],
+            });
+
+            const not_nulls = await sum_by_group(table, {
+                columns: ["bid"],
+                filter: [["qty", "is not null"]],
+            });
+
+            expect((await nulls.to_columns()).bid).toEqual([4, 4]);
+            expect((await not_nulls.to_columns()).bid).toEqual([6, 3, 3]);
+
+            await table.update({ k: [1], qty: [null] });
+            expect((await nulls.to_columns()).bid).toEqual([5, 1, 4]);
+            expect((await not_nulls.to_columns()).bid).toEqual([5, 2, 3]);
+
+            await not_nulls.delete();
+            await nulls.delete();
+            await table.delete();
+        });
+
+        test("views with identical configs", async function () {
+            const table = await perspective.table(data, { index: "k" });
+            const config = {
+                columns: ["x"],
+                expressions: { x: '"bid" * 2' },
+            };
+
+            const first = await sum_by_group(table, config);
+            const second = await sum_by_group(table, config);
+            await table.update({ k: [5], g: ["c"], bid: [10] });
+            expect(await first.to_columns()).toEqual(
+                await second.to_columns()
+            );
+
+            await first.delete();
+            await table.update({ k: [6], g: ["c"], bid: [1] });
+            expect((await second.to_columns()).x).toEqual([42, 6, 14, 22]);
+
+            await second.delete();
+            await table.delete();
+        });
+    });
+})(perspective);
@@ -0,0 +1,127 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+function make_data(n) {
+    const data = { id: [], g: [], x: [], y: [] };
+    for (let i = 0; i < n; i++) {
+        data.id.push(i);
+        data.g.push(`g${i % 4}`);
+        data.x.push(i);
+        data.y.push(i % 10);
+    }
+
+    return data;
+}
+
+/**
+ * t-digest estimates interpolate between centroids, so they are compared to
+ * the exact value within a fraction of the value range.
+ */
+function expect_near(actual, expected, tolerance) {
+    expect(actual.length).toEqual(expected.length);
+    for (let i = 0; i < actual.length; i++) {
+        expect(Math.abs(actual[i] - expected[i])).toBeLessThan(tolerance);
+    }
+}
+
+async function aggregate(table, column, agg) {
+    const view = await table.view({
+        group_by: ["g"],
+        columns: [column],
+        aggregates: { [column]: agg },
+    });
+
+    const result = (await view.to_columns())[column];
+    await view.delete();
+    return result;
+}
+
+((perspective) => {
+    test.describe("Sketch aggregates", function () {
+        test("approx distinct count is exact for small groups", async function () {
+            const table = await perspective.table(make_data(1000), {
+                index: "id",
+            });
+
+            const view = await table.view({
+                group_by: ["g"],
+                columns: ["y"],
+                aggregates: { y: "approx distinct count" },
+            });
+
+            // Each group only sees `y` values of one parity.
+            expect((await view.to_columns()).y).toEqual([10, 5, 5, 5, 5]);
+
+            await table.update({ id: [0, 1], y: [100, 101] });
+            expect((await view.to_columns()).y).toEqual([12, 6, 6, 5, 5]);
+            expect(await aggregate(table, "y", "distinct count")).toEqual([
+                12, 6, 6, 5, 5,
+            ]);
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("approx percentiles estimate the exact percentiles", async function () {
+            const table = await perspective.table(make_data(1000), {
+                index: "id",
+            });
+
+            const views = {};
+            for (const agg of ["approx median", "approx p90", "approx p99"]) {
+                views[agg] = await table.view({
+                    group_by: ["g"],
+                    columns: ["x"],
+                    aggregates: { x: agg },
+                });
+            }
+
+            const check = async () => {
+                const pairs = [
+                    ["approx median", "median"],
+                    ["approx p90", "p90"],
+                    ["approx p99", "p99"],
+                ];
+
+                for (const [approx, exact] of pairs) {
+                    expect_near(
+                        (await views[approx].to_columns()).x,
+                        await aggregate(table, "x", exact),
+                        15
+                    );
+                }
+            };
+
+            await check();
+
+            // Shift half of the rows up, so the root's merged sketch must
+            // follow the updated leaves.
+            const update = { id: [], x: [] };
+            for (let i = 0; i < 500; i++) {
+                update.id.push(i);
+                update.x.push(i + 1000);
+            }
+
+            await table.update(update);
+            await check();
+
+            for (const view of Object.values(views)) {
+                await view.delete();
+            }
+
+            await table.delete();
+        });
+    });
+})(perspective);
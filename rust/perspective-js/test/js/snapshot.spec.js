@@ -0,0 +1,47 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+// The WebAssembly server has no filesystem, so snapshots are only restored
+// by native servers; see the Python `test_snapshot.py` for round trips.
+((perspective) => {
+    test.describe("Snapshots", function () {
+        test("save_snapshot needs a native server", async function () {
+            const table = await perspective.table({ x: [1, 2, 3] });
+            await expect(table.save_snapshot("snapshot_spec")).rejects.toThrow(
+                /needs a server with a filesystem/
+            );
+
+            expect(await table.size()).toEqual(3);
+            await table.delete();
+        });
+
+        test("load_snapshot needs a native server", async function () {
+            await expect(
+                perspective.load_snapshot("snapshot_spec")
+            ).rejects.toThrow(/needs a server with a filesystem/);
+        });
+
+        test("invalid snapshot names are rejected", async function () {
+            const table = await perspective.table({ x: [1, 2, 3] });
+            for (const name of ["", "..", "../x", "a/b", ".hidden"]) {
+                await expect(table.save_snapshot(name)).rejects.toThrow(
+                    /Invalid storage name/
+                );
+            }
+
+            await table.delete();
+        });
+    });
+})(perspective);
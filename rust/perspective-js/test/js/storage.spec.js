@@ -0,0 +1,236 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+// The WebAssembly server has no filesystem, so disk backed tables are only
+// built by native servers; see the Python `test_storage.py`.
+((perspective) => {
+    test.describe("Storage", function () {
+        test("disk storage needs a native server", async function () {
+            await expect(
+                perspective.table(
+                    { x: [1, 2, 3] },
+                    { storage: { disk: "storage_spec" } }
+                )
+            ).rejects.toThrow(/needs a server with a filesystem/);
+        });
+
+        test("invalid storage names are rejected", async function () {
+            for (const disk of ["", "..", "../x", "a/b", ".hidden"]) {
+                await expect(
+                    perspective.table({ x: [1, 2, 3] }, { storage: { disk } })
+                ).rejects.toThrow(/Invalid storage name/);
+            }
+        });
+
+        test("empty storage keeps the table in memory", async function () {
+            const table = await perspective.table(
+                { x: [1, 2, 3] },
+                { storage: {} }
+            );
+
+            const view = await table.view();
+            expect(await view.to_columns()).toEqual({ x: [1, 2, 3] });
+            await view.delete();
+            await table.delete();
+        });
+    });
+
+    test.describe("Compressed columns", function () {
+        const data = {
+            id: Array.from({ length: 5000 }, (_, i) => i),
+            a: Array.from({ length: 5000 }, (_, i) => i % 10),
+            b: Array.from({ length: 5000 }, (_, i) =>
+                i % 7 === 0 ? null : 1.5
+            ),
+            s: Array.from({ length: 5000 }, (_, i) => "abc"[i % 3]),
+        };
+
+        const config = {
+            group_by: ["s"],
+            columns: ["a", "b"],
+            sort: [["b", "desc"]],
+        };
+
+        // Applies the same updates to a compressing and a plain table and
+        // returns both tables' views of each step.
+        async function compare(steps) {
+            const results = [];
+            for (const storage of [{ compress_after_updates: 2 }, {}]) {
+                const table = await perspective.table(data, {
+                    index: "id",
+                    storage,
+                });
+
+                const outputs = [];
+                for (const step of steps) {
+                    await step(table);
+                    const flat = await table.view();
+                    const pivoted = await table.view(config);
+                    outputs.push(await flat.to_columns());
+                    outputs.push(await pivoted.to_columns());
+                    await pivoted.delete();
+                    await flat.delete();
+                }
+
+                results.push(outputs);
+                await table.delete();
+            }
+
+            return results;
+        }
+
+        // Writes only `s`, so `a` and `b` are idle from the second update.
+        async function touch_s(table) {
+            for (let i = 0; i < 3; i++) {
+                await table.update({ id: [i], s: ["z"] });
+            }
+        }
+
+        test("idle columns read back unchanged", async function () {
+            const [compressed, plain] = await compare([touch_s]);
+            expect(compressed).toEqual(plain);
+        });
+
+        test("idle columns can still be updated", async function () {
+            const [compressed, plain] = await compare([
+                touch_s,
+                async (table) => {
+                    await table.update({
+                        id: [1, 4999, 6000],
+                        a: [100, null, 7],
+                    });
+                },
+                touch_s,
+                async (table) => {
+                    await table.remove([2, 3, 10]);
+                },
+                touch_s,
+                async (table) => {
+                    await table.update({ id: [20], b: [2.5] });
+                },
+            ]);
+
+            expect(compressed).toEqual(plain);
+        });
+
+        test("columns a view reads stay consistent", async function () {
+            const results = [];
+            for (const storage of [{ compress_after_updates: 1 }, {}]) {
+                const table = await perspective.table(data, {
+                    index: "id",
+                    storage,
+                });
+
+                const view = await table.view(config);
+                await touch_s(table);
+                await touch_s(table);
+                results.push(await view.to_columns());
+                await view.delete();
+                await table.delete();
+            }
+
+            expect(results[0]).toEqual(results[1]);
+        });
+    });
+
+    test.describe("Indexed columns", function () {
+        // More rows than one 4096 row chunk, so some chunks hold no match.
+        const data = {
+            id: Array.from({ length: 6000 }, (_, i) => i),
+            x: Array.from({ length: 6000 }, (_, i) => i % 100),
+            y: Array.from({ length: 6000 }, (_, i) =>
+                i % 13 === 0 ? null : i < 4096 ? `a${i % 20}` : `b${i % 5}`
+            ),
+        };
+
+        const filters = [
+            [["y", "==", "a3"]],
+            [["y", "==", "b1"]],
+            [["y", "==", "missing"]],
+            [["y", "!=", "a3"]],
+            [["y", "in", ["a1", "b2", "new"]]],
+            [["y", "not in", ["a1", "b2"]]],
+            [["y", "is null"]],
+            [
+                ["y", "in", ["a4", "b4"]],
+                ["x", ">", 50],
+            ],
+        ];
+
+        // The view output of every filter, flat and grouped, for a table
+        // with and without an index on `y`, after each step.
+        async function compare(steps) {
+            const results = [];
+            for (const storage of [{ indexed_columns: ["y"] }, {}]) {
+                const table = await perspective.table(data, {
+                    index: "id",
+                    storage,
+                });
+
+                const outputs = [];
+                for (const step of [async () => {}, ...steps]) {
+                    await step(table);
+                    for (const filter of filters) {
+                        const flat = await table.view({ filter });
+                        const grouped = await table.view({
+                            filter,
+                            group_by: ["y"],
+                            columns: ["x"],
+                        });
+
+                        outputs.push(await flat.to_columns());
+                        outputs.push(await grouped.to_columns());
+                        await grouped.delete();
+                        await flat.delete();
+                    }
+                }
+
+                results.push(outputs);
+                await table.delete();
+            }
+
+            return results;
+        }
+
+        test("filters match an unindexed table", async function () {
+            const [indexed, plain] = await compare([]);
+            expect(indexed).toEqual(plain);
+            expect(indexed[0].id.length).toBeGreaterThan(0);
+        });
+
+        test("filters match after updates and removes", async function () {
+            const [indexed, plain] = await compare([
+                async (table) => {
+                    await table.update({
+                        id: [0, 3, 5000, 5001, 7000, 7001],
+                        y: ["a3", null, "a3", "new", "b1", null],
+                    });
+                },
+                async (table) => {
+                    await table.remove([3, 23, 4100, 5000, 7001]);
+                },
+                async (table) => {
+                    await table.update({
+                        id: [23, 4100, 8000],
+                        x: [99, 99, 99],
+                        y: ["b2", "a1", "a3"],
+                    });
+                },
+            ]);
+
+            expect(indexed).toEqual(plain);
+        });
+    });
+})(perspective);
@@ -0,0 +1,73 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+function rows(start, end) {
+    const ids = Array.from({ length: end - start }, (_, i) => start + i);
+    return { id: ids, x: ids.map((i) => `x${i}`), y: ids.map((i) => i * 1.5) };
+}
+
+async function memory(name) {
+    const { tables } = await perspective.system_info();
+    return tables.find((t) => t.table_id === name);
+}
+
+((perspective) => {
+    test.describe("system_info", function () {
+        test("table memory grows with the table", async function () {
+            const table = await perspective.table(rows(0, 100), {
+                index: "id",
+                name: "system_info_growth",
+            });
+
+            const before = await memory("system_info_growth");
+            await table.update(rows(100, 20000));
+            await table.size();
+            const after = await memory("system_info_growth");
+
+            expect(after.column_bytes).toBeGreaterThan(before.column_bytes);
+            expect(after.vocab_bytes).toBeGreaterThan(before.vocab_bytes);
+            expect(after.mapping_bytes).toBeGreaterThan(before.mapping_bytes);
+            expect(after.total_bytes).toBeGreaterThan(before.total_bytes);
+            expect(after.views).toEqual([]);
+            await table.delete();
+        });
+
+        test("view memory is counted in its table's total", async function () {
+            const table = await perspective.table(rows(0, 5000), {
+                index: "id",
+                name: "system_info_views",
+            });
+
+            const view = await table.view({ group_by: ["x"] });
+            const { views, ...usage } = await memory("system_info_views");
+            expect(views.length).toEqual(1);
+            expect(views[0].tree_bytes).toBeGreaterThan(0);
+            expect(views[0].total_bytes).toBeGreaterThanOrEqual(
+                views[0].tree_bytes
+            );
+
+            const own =
+                usage.column_bytes +
+                usage.vocab_bytes +
+                usage.mapping_bytes +
+                usage.expression_vocab_bytes +
+                usage.port_bytes;
+
+            expect(usage.total_bytes).toEqual(own + views[0].total_bytes);
+            await view.delete();
+            await table.delete();
+        });
+    });
+})(perspective);
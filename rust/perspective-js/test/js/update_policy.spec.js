@@ -0,0 +1,147 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+function sleep(ms) {
+    return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+((perspective) => {
+    test.describe("Update policy", function () {
+        test("pending updates are processed as one batch", async function () {
+            const table = await perspective.table(
+                { id: "integer", x: "integer" },
+                { index: "id", update_policy: { min_interval_ms: 60000 } }
+            );
+
+            const view = await table.view();
+            let count = 0;
+            await view.on_update(() => count++);
+
+            await table.update({ id: [1, 2], x: [1, 2] });
+            await view.num_rows();
+            await sleep(50);
+            expect(count).toEqual(1);
+
+            // Polls inside the interval leave the table dirty.
+            await table.update({ id: [1], x: [10] });
+            await table.update({ id: [1], x: [100] });
+            await sleep(100);
+            expect(count).toEqual(1);
+
+            // A read processes the pending updates as one batch, latest
+            // value wins.
+            expect(await view.to_columns()).toEqual({
+                id: [1, 2],
+                x: [100, 2],
+            });
+
+            await sleep(50);
+            expect(count).toEqual(2);
+            await view.delete();
+            await table.delete();
+        });
+
+        test("max_batch_size processes before the interval", async function () {
+            const table = await perspective.table(
+                { id: "integer", x: "integer" },
+                {
+                    index: "id",
+                    update_policy: {
+                        min_interval_ms: 60000,
+                        max_batch_size: 3,
+                    },
+                }
+            );
+
+            const view = await table.view();
+            let count = 0;
+            await view.on_update(() => count++);
+            await table.update({ id: [1], x: [1] });
+            await view.num_rows();
+            await sleep(50);
+            expect(count).toEqual(1);
+
+            // Conflated to two pending rows, below the batch size.
+            await table.update({ id: [2], x: [2] });
+            await table.update({ id: [2], x: [20] });
+            await table.update({ id: [3], x: [3] });
+            await sleep(100);
+            expect(count).toEqual(1);
+
+            await table.update({ id: [4], x: [4] });
+            await sleep(100);
+            expect(count).toEqual(2);
+            expect(await view.to_columns()).toEqual({
+                id: [1, 2, 3, 4],
+                x: [1, 20, 3, 4],
+            });
+
+            await view.delete();
+            await table.delete();
+        });
+    });
+
+    test.describe("Throttled on_update", function () {
+        test("updates inside the interval are coalesced", async function () {
+            const table = await perspective.table({ x: "integer" });
+            const view = await table.view();
+            const ports = [];
+            await view.on_update(({ port_id }) => ports.push(port_id), {
+                min_interval_ms: 200,
+            });
+
+            await table.update({ x: [1] });
+            await view.num_rows();
+            await sleep(50);
+            expect(ports.length).toEqual(1);
+
+            await table.update({ x: [2] });
+            await view.num_rows();
+            await table.update({ x: [3] });
+            await view.num_rows();
+            await sleep(50);
+            expect(ports.length).toEqual(1);
+
+            // The held update is sent by the first poll after the interval.
+            await sleep(200);
+            await table.size();
+            await sleep(50);
+            expect(ports).toEqual([0, 0]);
+
+            await view.delete();
+            await table.delete();
+        });
+
+        test("row mode is not throttled", async function () {
+            const table = await perspective.table({ x: "integer" });
+            const view = await table.view();
+            let count = 0;
+            await view.on_update(() => count++, {
+                mode: "row",
+                min_interval_ms: 60000,
+            });
+
+            for (let i = 0; i < 3; i++) {
+                await table.update({ x: [i] });
+                await view.num_rows();
+            }
+
+            await sleep(50);
+            expect(count).toEqual(3);
+            await view.delete();
+            await table.delete();
+        });
+    });
+})(perspective);
@@ -3372,4 +3372,64 @@ async function match_delta(perspective, delta, expected) {
             await tbl.delete();
         });
     });
+
+    test.describe("Recycled update tables", function () {
+        test("string columns are correct across many updates", async function () {
+            const table = await perspective.table(
+                { id: "integer", name: "string", group: "string" },
+                { index: "id" }
+            );
+
+            const flat = await table.view();
+            const pivoted = await table.view({
+                group_by: ["group"],
+                columns: ["id"],
+                aggregates: { id: "count" },
+            });
+
+            const expected = new Map();
+            for (let round = 0; round < 50; round++) {
+                const update = { id: [], name: [], group: [] };
+                for (let i = 0; i < 20; i++) {
+                    const id = (round * 7 + i) % 100;
+                    const name = `name-${round}-${i}`;
+                    const group = `group-${id % 3}`;
+                    update.id.push(id);
+                    update.name.push(name);
+                    update.group.push(group);
+                    expected.set(id, { id, name, group });
+                }
+
+                await table.update(update);
+            }
+
+            // A partial update must not pick up strings from an earlier
+            // update through a stale vocabulary.
+            await table.update([{ id: 0, name: "renamed" }]);
+            expected.get(0).name = "renamed";
+
+            const ids = Array.from(expected.keys()).sort((a, b) => a - b);
+            expect(await flat.to_json()).toEqual(
+                ids.map((id) => expected.get(id))
+            );
+
+            const counts = await pivoted.to_columns();
+            expect(counts.__ROW_PATH__).toEqual([
+                [],
+                ["group-0"],
+                ["group-1"],
+                ["group-2"],
+            ]);
+
+            const total = [0, 0, 0];
+            for (const id of ids) {
+                total[id % 3]++;
+            }
+
+            expect(counts.id).toEqual([ids.length, ...total]);
+            await pivoted.delete();
+            await flat.delete();
+            await table.delete();
+        });
+    });
 })(perspective);
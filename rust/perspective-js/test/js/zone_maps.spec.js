@@ -0,0 +1,131 @@
+// ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+// ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+// ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+// ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+// ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+// ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+// ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+// ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+// ┃ This file is part of the Perspective library, distributed under the terms ┃
+// ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+// ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+import { test, expect } from "@finos/perspective-test";
+import perspective from "./perspective_client";
+
+// `x` rises with the row over more than two 4096 row chunks, so range
+// filters skip whole chunks. Expected results come from filtering a copy of
+// the rows here, i.e. a scan that skips nothing.
+const N = 10000;
+
+function x(i) {
+    return i % 11 === 0 ? null : i;
+}
+
+function expected(rows, pred) {
+    const ids = [];
+    for (const [id, value] of rows) {
+        if (value !== null && pred(value)) {
+            ids.push(id);
+        }
+    }
+
+    return ids.sort((a, b) => a - b);
+}
+
+async function filtered(table, filter) {
+    const view = await table.view({ filter, columns: ["id"] });
+    const { id } = await view.to_columns();
+    await view.delete();
+    return id.sort((a, b) => a - b);
+}
+
+async function bounds(table) {
+    const view = await table.view({ columns: ["x", "id"] });
+    const range = await view.get_min_max("x");
+    await view.delete();
+    return range;
+}
+
+((perspective) => {
+    test.describe("Zone maps", function () {
+        test("range filters and bounds match a full scan", async function () {
+            const rows = new Map();
+            for (let i = 0; i < N; i++) {
+                rows.set(i, x(i));
+            }
+
+            const table = await perspective.table(
+                {
+                    id: Array.from(rows.keys()),
+                    x: Array.from(rows.values()),
+                },
+                { index: "id" }
+            );
+
+            async function update(ids, xs) {
+                await table.update({ id: ids, x: xs });
+                ids.forEach((id, i) => rows.set(id, xs[i]));
+            }
+
+            async function remove(ids) {
+                await table.remove(ids);
+                ids.forEach((id) => rows.delete(id));
+            }
+
+            async function check() {
+                const terms = [
+                    [[["x", ">", 9000]], (v) => v > 9000],
+                    [[["x", "<", 100]], (v) => v < 100],
+                    [
+                        [
+                            ["x", ">=", 4096],
+                            ["x", "<=", 4200],
+                        ],
+                        (v) => v >= 4096 && v <= 4200,
+                    ],
+                    [[["x", "==", 8191]], (v) => v === 8191],
+                ];
+
+                for (const [filter, pred] of terms) {
+                    expect(await filtered(table, filter)).toEqual(
+                        expected(rows, pred)
+                    );
+                }
+
+                const nulls = await filtered(table, [["x", "is null"]]);
+                expect(nulls.length).toEqual(
+                    Array.from(rows.values()).filter((v) => v === null).length
+                );
+            }
+
+            await check();
+            expect(await bounds(table)).toEqual([1, 9998]);
+
+            // Appends to the last chunk.
+            await update(
+                Array.from({ length: 100 }, (_, i) => N + i),
+                Array.from({ length: 100 }, (_, i) =>
+                    i === 99 ? null : 20 + i
+                )
+            );
+
+            await check();
+
+            // In-place updates move rows into and out of other chunks' ranges.
+            await update([5, 6, 9998, 4100], [9500, 9500, 1, null]);
+            await check();
+            expect(await bounds(table)).toEqual([1, 9997]);
+
+            // Removing the largest values shrinks the bounds.
+            await remove([5, 6, 9995, 9996, 9997]);
+            await check();
+            expect(await bounds(table)).toEqual([1, 9994]);
+
+            await update([N + 200], [-5]);
+            await check();
+            expect(await bounds(table)).toEqual([-5, 9994]);
+            await table.delete();
+        });
+    });
+})(perspective);
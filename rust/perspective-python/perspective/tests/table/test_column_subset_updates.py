@@ -0,0 +1,107 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Views over a table whose updates each write only some of its columns,
+# including the group by, split by and sort columns, printing every view
+# after every update as JSON.
+SCRIPT = """
+import json
+import perspective
+
+client = perspective.Server().new_local_client()
+ids = range(500)
+table = client.table(
+    {
+        "id": list(ids),
+        "g": ["g%d" % (i % 7) for i in ids],
+        "c": ["c%d" % (i % 3) for i in ids],
+        "x": [float(i % 11) for i in ids],
+        "y": [i for i in ids],
+        "s": ["s%d" % (i % 13) for i in ids],
+    },
+    index="id",
+)
+
+configs = [
+    {"sort": [["x", "desc"]], "columns": ["x", "y", "s"]},
+    {
+        "group_by": ["g"],
+        "sort": [["x", "desc"]],
+        "columns": ["x", "y", "s"],
+        "aggregates": {"x": "sum", "y": "avg", "s": "last"},
+    },
+    {
+        "group_by": ["g", "s"],
+        "split_by": ["c"],
+        "sort": [["y", "asc"]],
+        "columns": ["x", "y"],
+        "aggregates": {"x": "max", "y": "count"},
+    },
+    {
+        "group_by": ["c"],
+        "columns": ["x", "s"],
+        "aggregates": {"x": "sum", "s": "distinct count"},
+        "filter": [["y", "<", 400]],
+    },
+]
+
+views = [table.view(**config) for config in configs]
+outputs = []
+
+updates = [
+    {"id": [1, 2, 3], "x": [100.0, None, -5.0]},
+    {"id": [4, 5], "y": [1000, -1]},
+    {"id": [6, 7], "s": ["s99", None]},
+    {"id": [8, 9], "g": ["g9", "g0"]},
+    {"id": [10, 11], "c": ["c9", "c0"], "x": [3.0, 4.0]},
+    {"id": [600, 601], "x": [50.0, 60.0]},
+    {"id": [600], "g": ["g1"], "c": ["c1"], "s": ["s1"]},
+    {"id": [12, 13], "y": [1, 2], "s": ["s0", "s0"]},
+]
+
+for update in updates:
+    table.update(update)
+    outputs.append([json.loads(v.to_columns_string()) for v in views])
+
+table.remove([1, 600])
+table.update({"id": [1], "y": [7]})
+outputs.append([json.loads(v.to_columns_string()) for v in views])
+print(json.dumps(outputs))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestColumnSubsetUpdates(object):
+    def test_partial_updates_match_full_column_updates(self):
+        subset = run()
+        assert subset == run(PSP_DISABLE_COLUMN_SUBSET_UPDATES="1")
+
+        # A partial update leaves the other columns of the row untouched.
+        flat = subset[0][0]
+        row = flat["y"].index(1)
+        assert flat["x"][row] == 100.0
+        assert flat["s"][row] == "s1"
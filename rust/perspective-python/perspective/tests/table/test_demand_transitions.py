@@ -0,0 +1,116 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Views that each read a different subset of the transitional tables -
+# filtered flat views, grouped and split views with row deltas, and
+# expressions over the updated rows - printing every view and every delta
+# after every update as JSON.
+SCRIPT = """
+import json
+import pyarrow as pa
+import perspective
+
+client = perspective.Server().new_local_client()
+ids = range(300)
+table = client.table(
+    {
+        "id": list(ids),
+        "g": ["g%d" % (i % 5) for i in ids],
+        "c": ["c%d" % (i % 3) for i in ids],
+        "x": [float(i % 17) for i in ids],
+        "y": [i for i in ids],
+    },
+    index="id",
+)
+
+expressions = {
+    "x2": '"x" * 2',
+    "label": "concat(\\"g\\", '-', \\"c\\")",
+    "band": 'bucket("y", 50)',
+}
+
+configs = [
+    {},
+    {"filter": [["x", ">", 10]], "columns": ["x", "y"]},
+    {"filter": [["g", "==", "g1"]], "sort": [["y", "desc"]]},
+    {"group_by": ["g"], "columns": ["x", "y"]},
+    {"group_by": ["g"], "split_by": ["c"], "columns": ["x"]},
+    {
+        "expressions": expressions,
+        "columns": ["x2", "label", "y"],
+        "filter": [["x2", ">=", 20]],
+    },
+    {
+        "expressions": expressions,
+        "group_by": ["band"],
+        "split_by": ["label"],
+        "columns": ["x2"],
+    },
+]
+
+views = [table.view(**config) for config in configs]
+deltas = [[] for _ in views]
+
+
+def recorder(idx):
+    def on_update(port_id, delta):
+        rows = pa.ipc.open_stream(delta).read_all().to_pydict()
+        deltas[idx].append(rows)
+
+    return on_update
+
+
+for idx, view in enumerate(views):
+    view.on_update(recorder(idx), mode="row")
+
+outputs = []
+updates = [
+    {"id": [1, 2], "x": [16.0, 0.0]},
+    {"id": [3, 4], "g": ["g1", "g9"]},
+    {"id": [5], "c": ["c2"], "y": [1000]},
+    {"id": [400, 401], "g": ["g1", "g2"], "x": [12.0, 1.0], "y": [7, 8]},
+    {"id": [6, 7], "x": [None, 11.0]},
+]
+
+for update in updates:
+    table.update(update)
+    outputs.append([json.loads(v.to_columns_string()) for v in views])
+
+table.remove([1, 3, 400])
+outputs.append([json.loads(v.to_columns_string()) for v in views])
+print(json.dumps([outputs, deltas], default=str))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestDemandTransitions(object):
+    def test_views_and_deltas_match_with_every_transition(self):
+        outputs, deltas = run()
+        assert [outputs, deltas] == run(PSP_DISABLE_DEMAND_TRANSITIONS="1")
+
+        # Rows moved into the `x > 10` filter by an update are in its delta.
+        assert 16.0 in deltas[1][0]["x"]
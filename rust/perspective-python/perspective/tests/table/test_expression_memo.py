@@ -0,0 +1,88 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Evaluates string expressions over a column of a few repeated values, then
+# moves rows between existing values, onto new values and to and from null,
+# reading both a long-lived view and one created after the updates.
+SCRIPT = """
+import json
+import perspective
+
+VALUES = ["alpha", "beta", "gamma", None]
+EXPRESSIONS = {
+    "upper": 'upper("s")',
+    "length": 'length("s")',
+    "prefix": 'substring("s", 0, 2)',
+    "match": 'match("s", \\'^[ab]\\')',
+}
+
+client = perspective.Server().new_local_client()
+table = client.table(
+    {"id": list(range(200)), "s": [VALUES[i % 4] for i in range(200)]},
+    index="id",
+)
+
+view = table.view(expressions=EXPRESSIONS)
+outputs = [json.loads(view.to_columns_string())]
+table.update(
+    {
+        "id": [0, 1, 3, 7, 8, 9],
+        "s": ["beta", "delta", "alpha", "delta", None, "epsilon"],
+    }
+)
+outputs.append(json.loads(view.to_columns_string()))
+table.update(
+    {
+        "id": list(range(200, 250)),
+        "s": ["zeta" if i % 5 == 0 else VALUES[i % 4] for i in range(50)],
+    }
+)
+table.update({"id": [2, 200], "s": ["zeta", "gamma"]})
+outputs.append(json.loads(view.to_columns_string()))
+fresh = table.view(expressions=EXPRESSIONS)
+outputs.append(json.loads(fresh.to_columns_string()))
+print(json.dumps(outputs))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestExpressionMemo(object):
+    def test_memoized_strings_match_per_row_evaluation(self):
+        memoized = run()
+        assert memoized == run(PSP_DISABLE_EXPRESSION_DICTIONARY_EVAL="1")
+
+        for output in memoized:
+            for i, s in enumerate(output["s"]):
+                assert output["upper"][i] == (None if s is None else s.upper())
+                assert output["length"][i] == (None if s is None else len(s))
+                assert output["prefix"][i] == (None if s is None else s[:2])
+
+        assert memoized[-2] == memoized[-1]
+        assert memoized[-1]["s"][:4] == ["beta", "delta", "zeta", "alpha"]
+        assert memoized[-1]["upper"][200] == "GAMMA"
+        assert len(memoized[-1]["s"]) == 250
@@ -0,0 +1,105 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Sorted views of a table with hundreds of groups, each update touching a
+# few rows so they are re-sorted incrementally, moving groups and leaves
+# past their siblings. Prints every view after every update as JSON.
+SCRIPT = """
+import json
+import perspective
+
+client = perspective.Server().new_local_client()
+ids = range(2000)
+table = client.table(
+    {
+        "id": list(ids),
+        "g": ["g%03d" % (i % 100) for i in ids],
+        "h": ["h%d" % (i % 5) for i in ids],
+        "c": ["c%d" % (i % 3) for i in ids],
+        "x": [float(i % 37) for i in ids],
+        "y": list(ids),
+    },
+    index="id",
+)
+
+configs = [
+    {"sort": [["x", "desc"]], "columns": ["x", "y"]},
+    {"group_by": ["g"], "sort": [["x", "desc"]], "columns": ["x", "y"]},
+    {
+        "group_by": ["g", "h"],
+        "sort": [["x", "asc"], ["y", "desc"]],
+        "columns": ["x", "y"],
+    },
+    {
+        "group_by": ["g"],
+        "split_by": ["c"],
+        "sort": [["x", "desc"]],
+        "columns": ["x", "y"],
+    },
+    {
+        "group_by": ["g", "h"],
+        "split_by": ["c"],
+        "sort": [["x", "col desc"], ["y", "asc"]],
+        "columns": ["x", "y"],
+    },
+]
+
+views = [table.view(**config) for config in configs]
+outputs = []
+
+updates = [
+    {"id": [5], "x": [1000.0]},
+    {"id": [17], "x": [-1000.0]},
+    {"id": [2000], "g": ["g050"], "h": ["h1"], "c": ["c2"], "x": [500.0]},
+    {"id": [6], "x": [1000.0]},
+    {"id": [5, 6], "x": [0.0, 0.0]},
+    {"id": [42], "c": ["c9"], "x": [2000.0]},
+    {"id": [1999], "y": [-1]},
+]
+
+for update in updates:
+    table.update(update)
+    outputs.append([json.loads(v.to_columns_string()) for v in views])
+
+for removed in ([17], [2000, 42]):
+    table.remove(removed)
+    outputs.append([json.loads(v.to_columns_string()) for v in views])
+
+print(json.dumps(outputs))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestIncrementalSort(object):
+    def test_updated_rows_sort_like_a_full_sort(self):
+        incremental = run()
+        assert incremental == run(PSP_DISABLE_INCREMENTAL_SORT="1")
+
+        # The group of the row set to 1000 moves to the top of the
+        # descending group sort, after the total.
+        assert incremental[0][1]["__ROW_PATH__"][1] == ["g005"]
+        assert incremental[1][1]["__ROW_PATH__"][-1] == ["g017"]
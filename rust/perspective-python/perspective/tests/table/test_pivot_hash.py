@@ -0,0 +1,86 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Pivots `date` and `datetime` columns, with nulls, across updates and
+# removes, printing every view as JSON.
+SCRIPT = """
+import json
+import perspective
+
+client = perspective.Server().new_local_client()
+table = client.table(
+    {"id": "integer", "d": "date", "t": "datetime", "x": "float"}, index="id"
+)
+
+
+def rows(ids):
+    return {
+        "id": list(ids),
+        "d": [None if i % 5 == 0 else "2024-01-%02d" % (1 + i % 7) for i in ids],
+        "t": [
+            None if i % 6 == 0 else "2024-01-01 %02d:30:00" % (i % 4)
+            for i in ids
+        ],
+        "x": [i * 0.5 for i in ids],
+    }
+
+
+configs = [
+    {"group_by": ["d"], "columns": ["x", "id"]},
+    {"group_by": ["t"], "columns": ["x"], "sort": [["x", "desc"]]},
+    {"group_by": ["t", "d"], "columns": ["x"]},
+    {"group_by": ["d"], "split_by": ["t"], "columns": ["x"]},
+]
+
+views = [table.view(**config) for config in configs]
+outputs = []
+
+
+def check():
+    for view in views:
+        outputs.append(json.loads(view.to_columns_string()))
+
+
+table.update(rows(range(1000)))
+check()
+table.update(rows(range(900, 1100)))
+table.update({"id": [1, 2, 3], "d": ["2023-12-31", None, "2024-01-02"]})
+check()
+table.remove(list(range(0, 1100, 3)))
+check()
+print(json.dumps(outputs))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestPivotHash(object):
+    def test_date_and_datetime_pivots_match_the_sorted_kernel(self):
+        hashed = run()
+        assert hashed == run(PSP_DISABLE_PIVOT_HASH_KERNEL="1")
+
+        # One row per date plus the total and the null group.
+        assert len(hashed[0]["__ROW_PATH__"]) == 1 + 7 + 1
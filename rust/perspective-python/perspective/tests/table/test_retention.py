@@ -0,0 +1,93 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+from datetime import datetime, timedelta
+
+import perspective as psp
+
+EPOCH = datetime(2024, 1, 1)
+
+
+def ts(ms):
+    return EPOCH + timedelta(milliseconds=ms)
+
+
+class TestRetention(object):
+    def test_retention_evicts_after_update(self):
+        client = psp.Server().new_local_client()
+        table = client.table(
+            {"id": "integer", "ts": "datetime", "x": "integer"},
+            index="id",
+            retention={"column": "ts", "ttl": 1000},
+        )
+
+        view = table.view()
+        table.update({"id": [1, 2], "ts": [ts(0), ts(500)], "x": [10, 20]})
+        table.update({"id": [3], "ts": [ts(1800)], "x": [30]})
+        assert view.to_columns()["id"] == [2, 3]
+
+    def test_retention_keeps_rows_refreshed_by_queued_updates(self):
+        # Polls are held back, so both updates below are queued on the port
+        # before the table processes either of them.
+        polls = []
+        client = psp.Server().new_local_client(
+            loop_callback=lambda fn, *args: polls.append(fn)
+        )
+
+        table = client.table(
+            {"id": "integer", "ts": "datetime", "x": "integer"},
+            index="id",
+            retention={"column": "ts", "ttl": 1000},
+        )
+
+        view = table.view()
+        table.update({"id": [1, 2], "ts": [ts(0), ts(500)], "x": [10, 20]})
+        assert view.to_columns()["id"] == [1, 2]
+
+        # Row 1 is refreshed by the first update and would be expired by the
+        # second, as measured against the table before either is applied.
+        table.update({"id": [1], "ts": [ts(2000)]})
+        table.update({"id": [3], "ts": [ts(2500)], "x": [30]})
+        columns = view.to_columns()
+        assert columns["id"] == [1, 3]
+        assert columns["x"] == [10, 30]
+
+        for poll in polls:
+            poll()
+
+        assert view.to_columns()["id"] == [1, 3]
+
+    def test_retention_keeps_rows_refreshed_on_other_ports(self):
+        polls = []
+        client = psp.Server().new_local_client(
+            loop_callback=lambda fn, *args: polls.append(fn)
+        )
+
+        table = client.table(
+            {"id": "integer", "ts": "datetime", "x": "integer"},
+            index="id",
+            retention={"column": "ts", "ttl": 1000},
+        )
+
+        port = table.make_port()
+        view = table.view()
+        table.update({"id": [1, 2], "ts": [ts(0), ts(500)], "x": [10, 20]})
+        assert view.to_columns()["id"] == [1, 2]
+
+        # Port 0 is processed before `port`, so the removal its update
+        # queues must leave the row `port` is about to refresh.
+        table.update({"id": [1], "ts": [ts(2000)]}, port_id=port)
+        table.update({"id": [3], "ts": [ts(2500)], "x": [30]})
+        columns = view.to_columns()
+        assert columns["id"] == [1, 3]
+        assert columns["x"] == [10, 30]
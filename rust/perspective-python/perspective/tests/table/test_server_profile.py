@@ -0,0 +1,65 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import perspective as psp
+
+
+def stages(trace):
+    return {s["stage"]: s for s in trace["stages"]}
+
+
+def table_profile(profile, name):
+    return next(t for t in profile["tables"] if t["table_id"] == name)
+
+
+class TestServerProfile(object):
+    def test_server_profile_reports_table_and_view_stages(self):
+        client = psp.Server().new_local_client()
+        table = client.table({"id": [1, 2, 3], "x": ["a", "b", "a"]}, index="id")
+        view = table.view(group_by=["x"])
+        view.on_update(lambda *args: None, mode="row")
+        table.update({"id": [4], "x": ["c"]})
+        table.update({"id": [1, 5], "x": ["b", "c"]})
+
+        profile = table_profile(client.server_profile(), table.get_name())
+        table_stages = stages(profile["trace"])
+        for stage in ("flatten", "pkey_lookup", "update_master"):
+            assert table_stages[stage]["count"] == 3
+
+        assert table_stages["process_columns"]["count"] == 2
+        assert table_stages["flatten"]["rows"] == 6
+        assert all(s["total_ns"] >= s["max_ns"] for s in table_stages.values())
+        assert profile["trace"]["records"] == []
+
+        assert len(profile["views"]) == 1
+        view_stages = stages(profile["views"][0]["trace"])
+        assert view_stages["context_notify"]["count"] == 2
+        assert view_stages["delta_serialize"]["count"] == 2
+
+    def test_server_profile_records_and_reset(self):
+        client = psp.Server().new_local_client()
+        table = client.table({"x": [1, 2, 3]})
+        table.update({"x": [4]})
+
+        profile = table_profile(
+            client.server_profile(include_records=True, reset=True),
+            table.get_name(),
+        )
+
+        records = profile["trace"]["records"]
+        assert [r["rows"] for r in records if r["stage"] == "flatten"] == [3, 1]
+        assert [r["seq"] for r in records] == sorted(r["seq"] for r in records)
+
+        cleared = table_profile(client.server_profile(), table.get_name())
+        assert cleared["trace"]["stages"] == []
+        assert cleared["trace"]["records"] == []
@@ -0,0 +1,150 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+import uuid
+
+from pytest import raises
+
+import perspective as psp
+from perspective import PerspectiveError
+
+DATA = {
+    "id": list(range(100)),
+    "x": [i * 1.5 for i in range(100)],
+    "y": ["abcde"[i % 5] for i in range(100)],
+    "z": [i % 3 == 0 for i in range(100)],
+}
+
+
+def restored(client):
+    table = client.table(DATA, index="id")
+    table.update({"id": [3, 200], "x": [None, 7.0], "y": ["q", None]})
+    table.remove([10, 11, 12])
+    name = "test_snapshot_" + uuid.uuid4().hex
+    table.save_snapshot(name)
+    return table, client.load_snapshot(name)
+
+
+class TestSnapshot(object):
+    def test_snapshot_round_trip(self):
+        client = psp.Server().new_local_client()
+        table, copy = restored(client)
+        assert copy.get_index() == "id"
+        assert copy.schema() == table.schema()
+        assert copy.size() == table.size()
+        assert copy.view().to_columns() == table.view().to_columns()
+
+    def test_snapshot_views_after_restore(self):
+        client = psp.Server().new_local_client()
+        table, copy = restored(client)
+        config = {
+            "group_by": ["y"],
+            "split_by": ["z"],
+            "columns": ["x", "id"],
+            "sort": [["x", "desc"]],
+        }
+
+        view = table.view(**config)
+        copy_view = copy.view(**config)
+        assert copy_view.to_columns() == view.to_columns()
+
+        # Removed rows' slots are reused by later inserts, and existing
+        # keys still update in place.
+        for t in (table, copy):
+            t.update(
+                {"id": [1, 300, 301], "x": [-1.0, 2.0, 3.0], "y": ["a", "b", "c"]}
+            )
+            t.remove([4])
+
+        assert copy.size() == table.size()
+        assert copy_view.to_columns() == view.to_columns()
+        assert copy.view().to_columns() == table.view().to_columns()
+
+    def test_snapshot_rejects_names_outside_storage(self):
+        client = psp.Server().new_local_client()
+        table = client.table(DATA, index="id")
+        for name in ["", "..", "../x", "a/b", ".hidden"]:
+            with raises(PerspectiveError):
+                table.save_snapshot(name)
+
+    def test_snapshot_missing(self):
+        client = psp.Server().new_local_client()
+        with raises(PerspectiveError):
+            client.load_snapshot("test_snapshot_" + uuid.uuid4().hex)
+
+    def test_snapshot_corrupt(self, tmp_path):
+        # The storage directory is read once per process, so the snapshot
+        # is saved and corrupted in a child interpreter that uses `tmp_path`.
+        script = """
+        import json
+        import os
+        import perspective
+
+        client = perspective.Server().new_local_client()
+        table = client.table(
+            {"id": [1, 2, 3], "y": ["a", "b", "c"]}, index="id"
+        )
+
+        dirname = os.path.join(os.environ["PSP_STORAGE_DIR"], "snap")
+
+        def attempt(corrupt):
+            table.save_snapshot("snap")
+            corrupt()
+            try:
+                client.load_snapshot("snap")
+                return "loaded"
+            except perspective.PerspectiveError:
+                return "error"
+
+        def rewrite(fname, edit):
+            path = os.path.join(dirname, fname)
+            with open(path) as f:
+                text = f.read()
+            with open(path, "w") as f:
+                f.write(edit(text))
+
+        def replace(fname, old, new):
+            return lambda: rewrite(fname, lambda t: t.replace(old, new))
+
+        def truncate(fname):
+            with open(os.path.join(dirname, fname), "r+b") as f:
+                f.truncate(4)
+
+        results = [
+            attempt(lambda: None),
+            attempt(replace("manifest", "rows 3", "rows 300")),
+            attempt(replace("manifest", "free 0", "free 1 9")),
+            attempt(replace("manifest", "psp_snapshot 1", "psp_snapshot 9")),
+            attempt(lambda: rewrite("manifest", lambda t: t[: len(t) // 2])),
+            attempt(replace("table", '"y" 19', '"y" 99')),
+            attempt(lambda: truncate("column_0.data")),
+            attempt(lambda: os.remove(os.path.join(dirname, "manifest"))),
+        ]
+
+        print(json.dumps(results))
+        print(json.dumps(table.view().to_columns()))
+        """
+
+        env = dict(os.environ, PSP_STORAGE_DIR=str(tmp_path))
+        output = subprocess.check_output(
+            [sys.executable, "-c", textwrap.dedent(script)], env=env
+        )
+
+        lines = output.decode().strip().splitlines()
+        assert json.loads(lines[0]) == ["loaded"] + ["error"] * 7
+        assert json.loads(lines[1]) == {"id": [1, 2, 3], "y": ["a", "b", "c"]}
@@ -0,0 +1,166 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+from pytest import raises
+
+import perspective as psp
+from perspective import PerspectiveError
+
+
+class TestStorage(object):
+    def test_disk_storage_matches_memory(self, tmp_path):
+        # The storage directory is read once per process, so the disk backed
+        # table is built in a child interpreter that uses `tmp_path`.
+        script = """
+        import json
+        import os
+        import perspective
+
+        client = perspective.Server().new_local_client()
+        data = {
+            "id": list(range(5000)),
+            "x": [i * 1.5 for i in range(5000)],
+            "y": ["abcde"[i % 5] for i in range(5000)],
+        }
+
+        # A small budget so columns are paged out between updates.
+        storage = {"disk": "disk_table", "resident_budget": 4096}
+        disk = client.table(data, index="id", storage=storage)
+        memory = client.table(data, index="id")
+        for t in (disk, memory):
+            t.update({"id": [3, 9000], "x": [None, 7.0], "y": ["q", None]})
+            t.remove(list(range(100, 200)))
+            t.update({"id": list(range(150, 250)), "x": [2.0] * 100})
+
+        config = {"group_by": ["y"], "columns": ["x", "id"]}
+        results = []
+        for t in (disk, memory):
+            flat, pivoted = t.view(), t.view(**config)
+            results.append([t.size(), flat.to_columns(), pivoted.to_columns()])
+            flat.delete()
+            pivoted.delete()
+
+        dirname = os.path.join(os.environ["PSP_STORAGE_DIR"], "disk_table")
+        files = len(os.listdir(dirname))
+        disk.delete()
+        print(json.dumps(results[0] == results[1]))
+        print(json.dumps([files > 0, os.path.exists(dirname)]))
+        """
+
+        env = dict(os.environ, PSP_STORAGE_DIR=str(tmp_path))
+        output = subprocess.check_output(
+            [sys.executable, "-c", textwrap.dedent(script)], env=env
+        )
+
+        lines = output.decode().strip().splitlines()
+        assert json.loads(lines[0]) is True
+        assert json.loads(lines[1]) == [True, False]
+
+    def test_disk_storage_rejects_names_outside_storage(self):
+        client = psp.Server().new_local_client()
+        for name in ["", "..", "../x", "a/b", ".hidden"]:
+            with raises(PerspectiveError):
+                client.table({"x": [1]}, storage={"disk": name})
+
+    def test_memory_storage_by_default(self):
+        client = psp.Server().new_local_client()
+        table = client.table({"x": [1, 2, 3]}, storage={})
+        assert table.view().to_columns() == {"x": [1, 2, 3]}
+
+    def test_compressed_columns_match_memory(self):
+        client = psp.Server().new_local_client()
+        data = {
+            "id": list(range(5000)),
+            "a": [i % 10 for i in range(5000)],
+            "b": [None if i % 7 == 0 else 1.5 for i in range(5000)],
+            "s": ["abc"[i % 3] for i in range(5000)],
+        }
+
+        config = {"group_by": ["s"], "columns": ["a", "b"], "sort": [["b", "desc"]]}
+        compressed = client.table(
+            data, index="id", storage={"compress_after_updates": 2}
+        )
+        plain = client.table(data, index="id")
+
+        def check():
+            for kwargs in ({}, config):
+                left, right = compressed.view(**kwargs), plain.view(**kwargs)
+                assert left.to_columns() == right.to_columns()
+                left.delete()
+                right.delete()
+
+        # Only `s` is written, so `a` and `b` go idle and are compressed.
+        def touch_s():
+            for i in range(3):
+                for t in (compressed, plain):
+                    t.update({"id": [i], "s": ["z"]})
+
+        touch_s()
+        check()
+        for t in (compressed, plain):
+            t.update({"id": [1, 4999, 6000], "a": [100, None, 7]})
+        check()
+        touch_s()
+        for t in (compressed, plain):
+            t.remove([2, 3, 10])
+        check()
+        touch_s()
+        for t in (compressed, plain):
+            t.update({"id": [20], "b": [2.5]})
+        check()
+
+    def test_indexed_columns_match_memory(self):
+        client = psp.Server().new_local_client()
+        data = {
+            "id": list(range(6000)),
+            "x": [i % 100 for i in range(6000)],
+            "y": [
+                None
+                if i % 13 == 0
+                else "a%d" % (i % 20)
+                if i < 4096
+                else "b%d" % (i % 5)
+                for i in range(6000)
+            ],
+        }
+
+        indexed = client.table(data, index="id", storage={"indexed_columns": ["y"]})
+        plain = client.table(data, index="id")
+        filters = [
+            [["y", "==", "a3"]],
+            [["y", "!=", "b1"]],
+            [["y", "in", ["a1", "b2", "new"]]],
+            [["y", "not in", ["a1", "b2"]]],
+            [["y", "is null"]],
+        ]
+
+        def check():
+            for f in filters:
+                left, right = indexed.view(filter=f), plain.view(filter=f)
+                assert left.to_columns() == right.to_columns()
+                left.delete()
+                right.delete()
+
+        check()
+        for t in (indexed, plain):
+            t.update({"id": [0, 3, 5000, 7000], "y": ["a3", None, "new", "b1"]})
+        check()
+        for t in (indexed, plain):
+            t.remove([3, 23, 4100, 5000])
+        check()
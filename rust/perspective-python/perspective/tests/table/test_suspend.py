@@ -0,0 +1,104 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# The idle timeout is read once per process, so these tests run their
+# views in a child interpreter with a timeout short enough that every view
+# is suspended by the poll that follows the next table request.
+SCRIPT_PRELUDE = """
+import json
+import time
+import perspective
+
+server = perspective.Server()
+client = server.new_local_client()
+table = client.table(
+    {
+        "x": [1, 2, 3, 4],
+        "y": ["a", "a", "b", "b"],
+        "z": ["c", "d", "c", "d"],
+    }
+)
+
+def suspend(view):
+    time.sleep(0.05)
+    table.size()
+"""
+
+
+def run_suspended(script):
+    env = dict(os.environ, PSP_VIEW_IDLE_TIMEOUT_MS="1")
+    output = subprocess.check_output(
+        [sys.executable, "-c", SCRIPT_PRELUDE + textwrap.dedent(script)],
+        env=env,
+    )
+    return output.decode().strip().splitlines()
+
+
+class TestSuspend(object):
+    def test_resumed_view_keeps_collapsed_rows(self):
+        lines = run_suspended(
+            """
+            view = table.view(group_by=["y", "z"])
+            view.collapse(1)
+            before = view.to_columns()
+            suspend(view)
+            print(json.dumps(before))
+            print(json.dumps(view.to_columns()))
+            """
+        )
+
+        assert lines[0] == lines[1]
+        assert len(json.loads(lines[1])["x"]) == 5
+
+    def test_resumed_view_keeps_expanded_rows(self):
+        lines = run_suspended(
+            """
+            view = table.view(group_by=["y", "z"])
+            view.collapse(1)
+            view.collapse(2)
+            view.expand(2)
+            before = view.to_columns()
+            suspend(view)
+            print(json.dumps(before))
+            print(json.dumps(view.to_columns()))
+            """
+        )
+
+        assert lines[0] == lines[1]
+        assert len(json.loads(lines[1])["x"]) == 5
+
+    def test_resumed_two_sided_view_keeps_collapsed_rows(self):
+        lines = run_suspended(
+            """
+            view = table.view(group_by=["y", "x"], split_by=["z"])
+            view.collapse(1)
+            suspend(view)
+            table.update({"x": [5], "y": ["a"], "z": ["c"]})
+            suspend(view)
+            print(json.dumps(view.to_columns()))
+            """
+        )
+
+        assert json.loads(lines[0])["__ROW_PATH__"] == [
+            [],
+            ["a"],
+            ["b"],
+            ["b", 3],
+            ["b", 4],
+        ]
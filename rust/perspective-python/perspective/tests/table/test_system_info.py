@@ -0,0 +1,63 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import perspective as psp
+
+
+def rows(start, end):
+    ids = list(range(start, end))
+    return {"id": ids, "x": ["x%d" % i for i in ids], "y": [i * 1.5 for i in ids]}
+
+
+def memory(client, name):
+    info = client.system_info()
+    assert info["heap_size"] > 0
+    return next(t for t in info["tables"] if t["table_id"] == name)
+
+
+class TestSystemInfo(object):
+    def test_table_memory_grows_with_the_table(self):
+        client = psp.Server().new_local_client()
+        table = client.table(rows(0, 100), index="id")
+        before = memory(client, table.get_name())
+        table.update(rows(100, 20000))
+        after = memory(client, table.get_name())
+
+        for field in ("column_bytes", "vocab_bytes", "mapping_bytes", "total_bytes"):
+            assert after[field] > before[field]
+
+        assert after["views"] == []
+
+    def test_view_memory_is_counted_in_its_tables_total(self):
+        client = psp.Server().new_local_client()
+        table = client.table(rows(0, 5000), index="id")
+        view = table.view(group_by=["x"])
+        usage = memory(client, table.get_name())
+
+        assert len(usage["views"]) == 1
+        view_usage = usage["views"][0]
+        assert view_usage["tree_bytes"] > 0
+        own = sum(
+            usage[field]
+            for field in (
+                "column_bytes",
+                "vocab_bytes",
+                "mapping_bytes",
+                "expression_vocab_bytes",
+                "port_bytes",
+            )
+        )
+
+        assert usage["total_bytes"] == own + view_usage["total_bytes"]
+        view.delete()
+        assert memory(client, table.get_name())["views"] == []
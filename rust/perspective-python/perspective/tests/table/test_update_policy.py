@@ -0,0 +1,78 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import time
+
+import perspective as psp
+
+
+class TestUpdatePolicy(object):
+    def test_update_policy_batches_pending_updates(self):
+        client = psp.Server().new_local_client()
+        table = client.table(
+            {"id": "integer", "x": "integer"},
+            index="id",
+            update_policy={"min_interval_ms": 60000},
+        )
+
+        view = table.view()
+        ports = []
+        view.on_update(lambda port_id: ports.append(port_id))
+        table.update({"id": [1, 2], "x": [1, 2]})
+        assert len(ports) == 1
+
+        # Polls inside the interval leave these pending.
+        table.update({"id": [1], "x": [10]})
+        table.update({"id": [1], "x": [100]})
+        assert len(ports) == 1
+
+        assert view.to_columns() == {"id": [1, 2], "x": [100, 2]}
+        assert len(ports) == 2
+
+    def test_update_policy_max_batch_size(self):
+        client = psp.Server().new_local_client()
+        table = client.table(
+            {"id": "integer", "x": "integer"},
+            index="id",
+            update_policy={"min_interval_ms": 60000, "max_batch_size": 2},
+        )
+
+        view = table.view()
+        ports = []
+        view.on_update(lambda port_id: ports.append(port_id))
+        table.update({"id": [1], "x": [1]})
+        table.update({"id": [2], "x": [2]})
+        assert len(ports) == 1
+
+        table.update({"id": [3], "x": [3]})
+        assert len(ports) == 2
+        assert view.to_columns() == {"id": [1, 2, 3], "x": [1, 2, 3]}
+
+    def test_on_update_min_interval(self):
+        client = psp.Server().new_local_client()
+        table = client.table({"x": "integer"})
+        view = table.view()
+        ports = []
+        view.on_update(lambda port_id: ports.append(port_id), min_interval_ms=200)
+        table.update({"x": [1]})
+        assert ports == [0]
+
+        table.update({"x": [2]})
+        table.update({"x": [3]})
+        assert ports == [0]
+
+        # The held update is sent, once, by the first poll after the
+        # interval.
+        time.sleep(0.3)
+        table.size()
+        assert ports == [0, 0]
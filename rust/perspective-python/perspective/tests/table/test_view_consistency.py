@@ -0,0 +1,77 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import threading
+
+import perspective as psp
+
+ROWS = 500
+
+
+class TestViewConsistency(object):
+    def test_serialize_while_updating(self):
+        # Two clients of one server, so reads and updates run on separate
+        # threads and serialization can overlap an update being processed.
+        server = psp.Server()
+        writer = server.new_local_client()
+        reader = server.new_local_client()
+        writer.table(
+            {
+                "id": list(range(ROWS)),
+                "g": [i % 5 for i in range(ROWS)],
+                "x": [0] * ROWS,
+                "y": [0] * ROWS,
+            },
+            index="id",
+            name="consistency",
+        )
+
+        table = reader.open_table("consistency")
+        flat = table.view()
+        pivoted = table.view(group_by=["g"], columns=["x", "y"])
+        done = threading.Event()
+        errors = []
+
+        def update():
+            try:
+                writer_table = writer.open_table("consistency")
+                for i in range(1, 50):
+                    writer_table.update(
+                        {
+                            "id": list(range(ROWS)),
+                            "x": [i] * ROWS,
+                            "y": [i] * ROWS,
+                        }
+                    )
+            except Exception as e:
+                errors.append(e)
+            finally:
+                done.set()
+
+        thread = threading.Thread(target=update)
+        thread.start()
+        while not done.is_set():
+            # Every update writes `x` and `y` together, so a slice taken
+            # from a single state always has them equal.
+            cols = flat.to_columns()
+            assert len(cols["id"]) == ROWS
+            assert cols["x"] == cols["y"]
+            assert len(set(cols["x"])) == 1
+
+            pcols = pivoted.to_columns()
+            assert len(pcols["__ROW_PATH__"]) == 6
+            assert pcols["x"] == pcols["y"]
+
+        thread.join()
+        assert errors == []
+        assert flat.to_columns()["x"] == [49] * ROWS
@@ -0,0 +1,105 @@
+#  ┏━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┓
+#  ┃ ██████ ██████ ██████       █      █      █      █      █ █▄  ▀███ █       ┃
+#  ┃ ▄▄▄▄▄█ █▄▄▄▄▄ ▄▄▄▄▄█  ▀▀▀▀▀█▀▀▀▀▀ █ ▀▀▀▀▀█ ████████▌▐███ ███▄  ▀█ █ ▀▀▀▀▀ ┃
+#  ┃ █▀▀▀▀▀ █▀▀▀▀▀ █▀██▀▀ ▄▄▄▄▄ █ ▄▄▄▄▄█ ▄▄▄▄▄█ ████████▌▐███ █████▄   █ ▄▄▄▄▄ ┃
+#  ┃ █      ██████ █  ▀█▄       █ ██████      █      ███▌▐███ ███████▄ █       ┃
+#  ┣━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┫
+#  ┃ Copyright (c) 2017, the Perspective Authors.                              ┃
+#  ┃ ╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌╌ ┃
+#  ┃ This file is part of the Perspective library, distributed under the terms ┃
+#  ┃ of the [Apache License 2.0](https://www.apache.org/licenses/LICENSE-2.0). ┃
+#  ┗━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━┛
+
+
+import json
+import os
+import subprocess
+import sys
+import textwrap
+
+# Builds a table of more than two 4096 row chunks whose `x` rises with the
+# row, so range filters skip whole chunks, then filters it and reads its
+# bounds after appends, in-place updates and removes. Null and NaN rows are
+# mixed in, as neither bounds a chunk.
+SCRIPT = """
+import json
+import pyarrow as pa
+import perspective
+
+N = 10000
+client = perspective.Server().new_local_client()
+
+
+def arrow(ids, xs):
+    return pa.table(
+        {"id": pa.array(ids, pa.int64()), "x": pa.array(xs, pa.float64())}
+    )
+
+
+def x(i):
+    return None if i % 11 == 0 else float("nan") if i % 17 == 0 else float(i)
+
+
+table = client.table(arrow(range(N), [x(i) for i in range(N)]), index="id")
+filters = [
+    [["x", ">", 9000]],
+    [["x", "<", 100]],
+    [["x", ">=", 4096], ["x", "<=", 4200]],
+    [["x", "==", 8191]],
+    [["x", "is null"]],
+    [["x", "is not null"], ["x", "<", 50]],
+]
+
+outputs = []
+
+
+def check():
+    for f in filters:
+        view = table.view(filter=f, columns=["id"])
+        outputs.append(view.to_columns())
+        view.delete()
+
+    for kwargs in ({}, {"columns": ["x", "id"]}):
+        view = table.view(**kwargs)
+        outputs.append([float(v) for v in view.get_min_max("x")])
+        view.delete()
+
+
+check()
+table.update(arrow(range(N, N + 100), [20.0 + i for i in range(99)] + [float("nan")]))
+check()
+table.update(arrow([5, 6, 9999, 9990, 4100], [9500.0, 9500.0, 1.0, float("nan"), None]))
+check()
+table.remove([5, 6] + list(range(9995, 10000)))
+check()
+table.update(arrow([N + 200], [-5.0]))
+check()
+print(json.dumps(outputs))
+"""
+
+
+def run(**env):
+    output = subprocess.check_output(
+        [sys.executable, "-c", textwrap.dedent(SCRIPT)],
+        env=dict(os.environ, **env),
+    )
+
+    return json.loads(output.decode().strip().splitlines()[-1])
+
+
+class TestZoneMaps(object):
+    def test_pruned_filters_and_bounds_match_a_full_scan(self):
+        pruned = run()
+        assert pruned == run(PSP_DISABLE_ZONE_MAPS="1")
+
+        # Each `check()` appends 8 outputs; the bounds follow the filters.
+        bounds = [pruned[i * 8 + 6 : i * 8 + 8] for i in range(5)]
+        assert bounds[0] == [[1.0, 9998.0]] * 2
+        assert bounds[2] == [[1.0, 9998.0]] * 2
+        assert bounds[3] == [[1.0, 9994.0]] * 2
+        assert bounds[4] == [[-5.0, 9994.0]] * 2
+
+        # Rows moved into and out of the last chunk's range by updates.
+        assert 5 not in pruned[8 * 0]["id"]
+        assert 5 in pruned[8 * 2]["id"]
+        assert 5 not in pruned[8 * 3]["id"]
@@ -94,7 +94,7 @@ impl Client {
     }
 
     #[doc = crate::inherit_docs!("client/table.md")]
-    #[pyo3(signature = (input, limit=None, index=None, name=None))]
+    #[pyo3(signature = (input, limit=None, index=None, name=None, retention=None, update_policy=None, storage=None))]
     pub fn table(
         &self,
         py: Python<'_>,
@@ -102,9 +102,14 @@ impl Client {
         limit: Option<u32>,
         index: Option<Py<PyString>>,
         name: Option<Py<PyString>>,
+        retention: Option<Py<PyDict>>,
+        update_policy: Option<Py<PyDict>>,
+        storage: Option<Py<PyDict>>,
     ) -> PyResult<Table> {
         Ok(Table(
-            self.0.table(input, limit, index, name).py_block_on(py)?,
+            self.0
+                .table(input, limit, index, name, retention, update_policy, storage)
+                .py_block_on(py)?,
         ))
     }
 
@@ -115,11 +120,34 @@ impl Client {
         Ok(Table(table))
     }
 
+    #[doc = crate::inherit_docs!("client/load_snapshot.md")]
+    #[pyo3(signature = (snapshot, name=None))]
+    pub fn load_snapshot(&self, snapshot: String, name: Option<String>) -> PyResult<Table> {
+        let client = self.0.clone();
+        let table = client.load_snapshot(snapshot, name).block_on()?;
+        Ok(Table(table))
+    }
+
     #[doc = crate::inherit_docs!("client/get_hosted_table_names.md")]
     pub fn get_hosted_table_names(&self) -> PyResult<Vec<String>> {
         self.0.get_hosted_table_names().block_on()
     }
 
+    #[doc = crate::inherit_docs!("client/system_info.md")]
+    pub fn system_info(&self) -> PyResult<Py<PyAny>> {
+        self.0.system_info().block_on()
+    }
+
+    #[doc = crate::inherit_docs!("client/server_profile.md")]
+    #[pyo3(signature = (include_records=None, reset=None))]
+    pub fn server_profile(
+        &self,
+        include_records: Option<bool>,
+        reset: Option<bool>,
+    ) -> PyResult<Py<PyAny>> {
+        self.0.server_profile(include_records, reset).block_on()
+    }
+
     #[doc = crate::inherit_docs!("client/set_loop_callback.md")]
     pub fn set_loop_callback(&self, loop_cb: Py<PyAny>) -> PyResult<()> {
         self.0.set_loop_cb(loop_cb).block_on()
@@ -168,6 +196,11 @@ impl Table {
         self.0.delete().block_on()
     }
 
+    #[doc = crate::inherit_docs!("table/save_snapshot.md")]
+    pub fn save_snapshot(&self, name: String) -> PyResult<()> {
+        self.0.save_snapshot(name).block_on()
+    }
+
     #[doc = crate::inherit_docs!("table/make_port.md")]
     pub fn make_port(&self) -> PyResult<i32> {
         let table = self.0.clone();
@@ -355,8 +388,14 @@ impl View {
     }
 
     #[doc = crate::inherit_docs!("view/on_update.md")]
-    pub fn on_update(&self, callback: Py<PyAny>, mode: Option<String>) -> PyResult<u32> {
-        self.0.on_update(callback, mode).block_on()
+    #[pyo3(signature = (callback, mode=None, min_interval_ms=None))]
+    pub fn on_update(
+        &self,
+        callback: Py<PyAny>,
+        mode: Option<String>,
+        min_interval_ms: Option<u32>,
+    ) -> PyResult<u32> {
+        self.0.on_update(callback, mode, min_interval_ms).block_on()
     }
 
     #[doc = crate::inherit_docs!("view/remove_update.md")]
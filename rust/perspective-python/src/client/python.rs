@@ -20,7 +20,8 @@ use futures::FutureExt;
 use perspective_client::proto::ViewOnUpdateResp;
 use perspective_client::{
     assert_table_api, assert_view_api, clone, Client, ClientError, OnUpdateMode, OnUpdateOptions,
-    Table, TableData, TableInitOptions, UpdateData, UpdateOptions, View, ViewWindow,
+    ServerProfileOptions, Table, TableData, TableInitOptions, UpdateData, UpdateOptions, View,
+    ViewWindow,
 };
 use pyo3::create_exception;
 use pyo3::exceptions::PyValueError;
@@ -301,12 +302,24 @@ impl PyClient {
         limit: Option<u32>,
         index: Option<Py<PyString>>,
         name: Option<Py<PyString>>,
+        retention: Option<Py<PyDict>>,
+        update_policy: Option<Py<PyDict>>,
+        storage: Option<Py<PyDict>>,
     ) -> PyResult<PyTable> {
         let client = self.client.clone();
         let py_client = self.clone();
         let table = Python::with_gil(|py| {
             let mut options = TableInitOptions {
                 name: name.map(|x| x.extract::<String>(py)).transpose()?,
+                retention: retention
+                    .map(|x| depythonize_bound(x.into_bound(py).into_any()))
+                    .transpose()?,
+                update_policy: update_policy
+                    .map(|x| depythonize_bound(x.into_bound(py).into_any()))
+                    .transpose()?,
+                storage: storage
+                    .map(|x| depythonize_bound(x.into_bound(py).into_any()))
+                    .transpose()?,
                 ..TableInitOptions::default()
             };
 
@@ -341,6 +354,16 @@ impl PyClient {
         })
     }
 
+    pub async fn load_snapshot(&self, snapshot: String, name: Option<String>) -> PyResult<PyTable> {
+        let client = self.client.clone();
+        let py_client = self.clone();
+        let table = client.load_snapshot(snapshot, name).await.into_pyerr()?;
+        Ok(PyTable {
+            table: Arc::new(table),
+            client: py_client,
+        })
+    }
+
     pub async fn open_table(&self, name: String) -> PyResult<PyTable> {
         let client = self.client.clone();
         let py_client = self.clone();
@@ -355,6 +378,25 @@ impl PyClient {
         self.client.get_hosted_table_names().await.into_pyerr()
     }
 
+    pub async fn system_info(&self) -> PyResult<Py<PyAny>> {
+        let info = self.client.system_info().await.into_pyerr()?;
+        Ok(Python::with_gil(|py| pythonize::pythonize(py, &info))?)
+    }
+
+    pub async fn server_profile(
+        &self,
+        include_records: Option<bool>,
+        reset: Option<bool>,
+    ) -> PyResult<Py<PyAny>> {
+        let options = ServerProfileOptions {
+            include_records,
+            reset,
+        };
+
+        let profile = self.client.server_profile(options).await.into_pyerr()?;
+        Ok(Python::with_gil(|py| pythonize::pythonize(py, &profile))?)
+    }
+
     pub async fn set_loop_cb(&self, loop_cb: Py<PyAny>) -> PyResult<()> {
         *self.loop_cb.write().await = Some(loop_cb);
         Ok(())
@@ -405,6 +447,10 @@ impl PyTable {
         self.table.delete().await.into_pyerr()
     }
 
+    pub async fn save_snapshot(&self, name: String) -> PyResult<()> {
+        self.table.save_snapshot(name).await.into_pyerr()
+    }
+
     pub async fn make_port(&self) -> PyResult<i32> {
         self.table.make_port().await.into_pyerr()
     }
@@ -592,7 +638,12 @@ impl PyView {
         self.view.remove_delete(callback_id).await.into_pyerr()
     }
 
-    pub async fn on_update(&self, callback: Py<PyAny>, mode: Option<String>) -> PyResult<u32> {
+    pub async fn on_update(
+        &self,
+        callback: Py<PyAny>,
+        mode: Option<String>,
+        min_interval_ms: Option<u32>,
+    ) -> PyResult<u32> {
         let loop_cb = self.client.loop_cb.read().await.clone();
         let callback = move |x: ViewOnUpdateResp| {
             let loop_cb = loop_cb.clone();
@@ -628,7 +679,11 @@ impl PyView {
             .into_pyerr()?;
 
         self.view
-            .on_update(Box::new(callback), OnUpdateOptions { mode })
+            .on_update(Box::new(callback), OnUpdateOptions {
+                mode,
+                viewport: None,
+                min_interval_ms,
+            })
             .await
             .into_pyerr()
     }
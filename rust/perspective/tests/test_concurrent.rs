@@ -29,8 +29,7 @@ async fn test_two_sync_clients_receive_messages_on_update() -> Result<(), Box<dy
             UpdateData::Csv("x,y\n1,2\n3,4".to_owned()).into(),
             TableInitOptions {
                 name: Some("Table1".to_owned()),
-                index: None,
-                limit: None,
+                ..TableInitOptions::default()
             },
         )
         .await?;